@@ -0,0 +1,71 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/19.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/ds/ArrayVariant.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using zapi::ds::ArrayVariant;
+
+TEST(ArrayVariantBenchmark, testSort)
+{
+   const int count = 100000;
+   std::mt19937 generator(2017);
+   std::uniform_int_distribution<zapi_long> distribution(0, count * 10);
+   ArrayVariant source;
+   for (int i = 0; i < count; ++i) {
+      source.append(distribution(generator));
+   }
+   zval data;
+   ZVAL_COPY(&data, source.getZvalPtr());
+   zend_hash_str_update(&EG(symbol_table), "zapiBenchData", sizeof("zapiBenchData") - 1, &data);
+   auto start = std::chrono::steady_clock::now();
+   zend_eval_string(const_cast<char *>("usort($zapiBenchData, function ($lhs, $rhs) { return $lhs <=> $rhs; });"),
+                    nullptr, const_cast<char *>("ArrayVariant sort benchmark"));
+   auto usortTime = std::chrono::steady_clock::now() - start;
+   ArrayVariant radixSorted(source);
+   start = std::chrono::steady_clock::now();
+   radixSorted.sort();
+   auto radixTime = std::chrono::steady_clock::now() - start;
+   ArrayVariant nativeSorted(source);
+   start = std::chrono::steady_clock::now();
+   nativeSorted.sort([](const zval &lhs, const zval &rhs) -> bool {
+      return Z_LVAL(lhs) < Z_LVAL(rhs);
+   });
+   auto nativeTime = std::chrono::steady_clock::now() - start;
+   ArrayVariant phpSorted(zend_hash_str_find(&EG(symbol_table), "zapiBenchData", sizeof("zapiBenchData") - 1));
+   ASSERT_TRUE(radixSorted.strictEqual(phpSorted));
+   ASSERT_TRUE(nativeSorted.strictEqual(phpSorted));
+   zend_hash_str_del(&EG(symbol_table), "zapiBenchData", sizeof("zapiBenchData") - 1);
+   using std::chrono::microseconds;
+   using std::chrono::duration_cast;
+   std::cout << "sort " << count << " integers, usort with closure: " 
+             << duration_cast<microseconds>(usortTime).count() << "us, native comparator: "
+             << duration_cast<microseconds>(nativeTime).count() << "us, radix: " 
+             << duration_cast<microseconds>(radixTime).count() << "us" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+   int retCode = 0;
+   PHP_EMBED_START_BLOCK(argc,argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   retCode = RUN_ALL_TESTS();
+   PHP_EMBED_END_BLOCK();
+   return retCode;
+}
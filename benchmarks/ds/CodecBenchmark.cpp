@@ -0,0 +1,143 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/19.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/ds/JsonCodec.h"
+#include "zapi/ds/BinaryCodec.h"
+#include "zapi/ds/ArrayVariant.h"
+#include "zapi/ds/StringVariant.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using zapi::ds::JsonDecoder;
+using zapi::ds::JsonEncoder;
+using zapi::ds::BinaryWriter;
+using zapi::ds::BinaryReader;
+using zapi::ds::ArrayVariant;
+using zapi::ds::Variant;
+using zapi::ds::StringVariant;
+
+namespace
+{
+
+ArrayVariant make_records(int count)
+{
+   ArrayVariant records;
+   for (int i = 0; i < count; ++i) {
+      ArrayVariant record;
+      record.insert("id", i);
+      record.insert("name", "item " + std::to_string(i));
+      record.insert("price", i * 1.5);
+      record.insert("active", i % 2 == 0);
+      record.insert("tags", ArrayVariant{"red", "green", "blue"});
+      records.append(record);
+   }
+   return records;
+}
+
+} // anonymous namespace
+
+TEST(CodecBenchmark, testJson)
+{
+   ArrayVariant records = make_records(20000);
+   using std::chrono::steady_clock;
+   using std::chrono::microseconds;
+   using std::chrono::duration_cast;
+   JsonEncoder encoder;
+   std::string json;
+   auto start = steady_clock::now();
+   ASSERT_TRUE(encoder.encode(records, json));
+   auto encodeTime = steady_clock::now() - start;
+   JsonDecoder decoder;
+   Variant decoded;
+   start = steady_clock::now();
+   ASSERT_TRUE(decoder.decode(json, decoded));
+   auto decodeTime = steady_clock::now() - start;
+   ASSERT_TRUE(ArrayVariant(decoded).strictEqual(records));
+   std::cout << "json " << json.length() << " bytes, native encode: "
+             << duration_cast<microseconds>(encodeTime).count() << "us, native decode: "
+             << duration_cast<microseconds>(decodeTime).count() << "us" << std::endl;
+   if (!zend_hash_str_exists(&module_registry, "json", sizeof("json") - 1)) {
+      return;
+   }
+   zval data;
+   ZVAL_COPY(&data, records.getZvalPtr());
+   zend_hash_str_update(&EG(symbol_table), "zapiBenchData", sizeof("zapiBenchData") - 1, &data);
+   ZVAL_STRINGL(&data, json.data(), json.length());
+   zend_hash_str_update(&EG(symbol_table), "zapiBenchJson", sizeof("zapiBenchJson") - 1, &data);
+   zval phpJson;
+   start = steady_clock::now();
+   zend_eval_string(const_cast<char *>("json_encode($zapiBenchData)"), &phpJson,
+                    const_cast<char *>("json_encode benchmark"));
+   auto phpEncodeTime = steady_clock::now() - start;
+   zval phpDecoded;
+   start = steady_clock::now();
+   zend_eval_string(const_cast<char *>("json_decode($zapiBenchJson, true)"), &phpDecoded,
+                    const_cast<char *>("json_decode benchmark"));
+   auto phpDecodeTime = steady_clock::now() - start;
+   ASSERT_EQ(StringVariant(&phpJson).toString(), json);
+   ASSERT_TRUE(ArrayVariant(&phpDecoded).strictEqual(records));
+   zval_ptr_dtor(&phpJson);
+   zval_ptr_dtor(&phpDecoded);
+   zend_hash_str_del(&EG(symbol_table), "zapiBenchData", sizeof("zapiBenchData") - 1);
+   zend_hash_str_del(&EG(symbol_table), "zapiBenchJson", sizeof("zapiBenchJson") - 1);
+   std::cout << "ext/json encode: " << duration_cast<microseconds>(phpEncodeTime).count()
+             << "us, ext/json decode: " << duration_cast<microseconds>(phpDecodeTime).count()
+             << "us" << std::endl;
+}
+
+TEST(CodecBenchmark, testBinary)
+{
+   ArrayVariant records = make_records(20000);
+   using std::chrono::steady_clock;
+   using std::chrono::microseconds;
+   using std::chrono::duration_cast;
+   BinaryWriter writer;
+   auto start = steady_clock::now();
+   ASSERT_TRUE(writer.write(records));
+   auto encodeTime = steady_clock::now() - start;
+   Variant decoded;
+   start = steady_clock::now();
+   BinaryReader reader(writer.getData(), writer.getSize());
+   ASSERT_TRUE(reader.read(decoded));
+   auto decodeTime = steady_clock::now() - start;
+   ASSERT_TRUE(ArrayVariant(decoded).strictEqual(records));
+   std::cout << "binary " << writer.getSize() << " bytes, encode: "
+             << duration_cast<microseconds>(encodeTime).count() << "us, decode: "
+             << duration_cast<microseconds>(decodeTime).count() << "us" << std::endl;
+   zval data;
+   ZVAL_COPY(&data, records.getZvalPtr());
+   zend_hash_str_update(&EG(symbol_table), "zapiBenchData", sizeof("zapiBenchData") - 1, &data);
+   zval serialized;
+   start = steady_clock::now();
+   zend_eval_string(const_cast<char *>("$zapiBenchText = serialize($zapiBenchData)"), &serialized,
+                    const_cast<char *>("serialize benchmark"));
+   auto phpEncodeTime = steady_clock::now() - start;
+   zval unserialized;
+   start = steady_clock::now();
+   zend_eval_string(const_cast<char *>("unserialize($zapiBenchText)"), &unserialized,
+                    const_cast<char *>("unserialize benchmark"));
+   auto phpDecodeTime = steady_clock::now() - start;
+   ASSERT_TRUE(ArrayVariant(&unserialized).strictEqual(records));
+   std::cout << "serialize() " << Z_STRLEN(serialized) << " bytes, encode: "
+             << duration_cast<microseconds>(phpEncodeTime).count() << "us, decode: "
+             << duration_cast<microseconds>(phpDecodeTime).count() << "us" << std::endl;
+   zval_ptr_dtor(&serialized);
+   zval_ptr_dtor(&unserialized);
+   zend_hash_str_del(&EG(symbol_table), "zapiBenchData", sizeof("zapiBenchData") - 1);
+   zend_hash_str_del(&EG(symbol_table), "zapiBenchText", sizeof("zapiBenchText") - 1);
+}
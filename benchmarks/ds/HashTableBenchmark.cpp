@@ -0,0 +1,78 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/19.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/ds/HashTable.h"
+#include "zapi/ds/ArrayVariant.h"
+#include "zapi/ds/Variant.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <string>
+
+using ZapiHashTable = zapi::ds::HashTable<>;
+using zapi::ds::ArrayKey;
+using zapi::ds::ArrayVariant;
+using zapi::ds::Variant;
+
+TEST(HashTableBenchmark, testLookup)
+{
+   const int count = 100000;
+   std::vector<std::string> names;
+   std::vector<ArrayKey> keys;
+   names.reserve(count);
+   keys.reserve(count);
+   for (int i = 0; i < count; ++i) {
+      names.push_back("key" + std::to_string(i));
+      keys.push_back(ArrayKey(names.back(), false));
+   }
+   ZapiHashTable table(count);
+   ArrayVariant array;
+   for (int i = 0; i < count; ++i) {
+      zval value;
+      ZVAL_LONG(&value, i);
+      table.insert(keys[i], &value);
+      array.insert(keys[i], Variant(i));
+   }
+   using std::chrono::steady_clock;
+   using std::chrono::microseconds;
+   using std::chrono::duration_cast;
+   zend_array *raw = table.getZendArrayPtr();
+   zapi_long rawSum = 0;
+   auto start = steady_clock::now();
+   for (int i = 0; i < count; ++i) {
+      rawSum += Z_LVAL_P(zend_hash_str_find(raw, names[i].c_str(), names[i].length()));
+   }
+   auto rawTime = steady_clock::now() - start;
+   zapi_long tableSum = 0;
+   start = steady_clock::now();
+   for (int i = 0; i < count; ++i) {
+      tableSum += Z_LVAL_P(table.find(keys[i]));
+   }
+   auto tableTime = steady_clock::now() - start;
+   zapi_long arraySum = 0;
+   start = steady_clock::now();
+   for (int i = 0; i < count; ++i) {
+      arraySum += Z_LVAL_P(array.getValue(keys[i]).getZvalPtr());
+   }
+   auto arrayTime = steady_clock::now() - start;
+   ASSERT_EQ(rawSum, tableSum);
+   ASSERT_EQ(rawSum, arraySum);
+   std::cout << "lookup " << count << " string keys, zend_hash_str_find: " 
+             << duration_cast<microseconds>(rawTime).count() << "us, HashTable pre-hashed: "
+             << duration_cast<microseconds>(tableTime).count() << "us, ArrayVariant: " 
+             << duration_cast<microseconds>(arrayTime).count() << "us" << std::endl;
+}
@@ -0,0 +1,98 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/19.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/vm/ObjectPool.h"
+#include "zapi/lang/StdClass.h"
+#include <chrono>
+#include <iostream>
+#include <new>
+
+using zapi::vm::ObjectPool;
+using zapi::lang::StdClass;
+
+namespace
+{
+class ChurnObject : public StdClass
+{
+public:
+   int64_t x = 0;
+   int64_t y = 0;
+};
+} // anonymous namespace
+
+TEST(ObjectPoolBenchmark, testChurn)
+{
+   // a window of live objects churned the way short lived iterators and
+   // closures are, every round frees the oldest and creates a new one
+   const int rounds = 200000;
+   const int window = 16;
+   ChurnObject *live[window] = {};
+   using std::chrono::steady_clock;
+   using std::chrono::microseconds;
+   using std::chrono::duration_cast;
+   auto start = steady_clock::now();
+   for (int i = 0; i < rounds; ++i) {
+      ChurnObject *&slot = live[i % window];
+      delete slot;
+      slot = new ChurnObject();
+      slot->x = i;
+   }
+   for (ChurnObject *&object : live) {
+      delete object;
+      object = nullptr;
+   }
+   auto heapTime = steady_clock::now() - start;
+   ObjectPool pool(sizeof(ChurnObject));
+   pool.setCapacity(window);
+   if (!pool.isEnabled()) {
+      // the pools are disabled under ZTS
+      std::cout << rounds << " objects, new/delete: " << duration_cast<microseconds>(heapTime).count()
+                << "us, pool disabled" << std::endl;
+      return;
+   }
+   start = steady_clock::now();
+   for (int i = 0; i < rounds; ++i) {
+      ChurnObject *&slot = live[i % window];
+      if (slot) {
+         slot->~ChurnObject();
+         pool.release(slot);
+      }
+      slot = new (pool.allocate()) ChurnObject();
+      slot->x = i;
+   }
+   for (ChurnObject *&object : live) {
+      object->~ChurnObject();
+      pool.release(object);
+   }
+   auto poolTime = steady_clock::now() - start;
+   const ObjectPool::Stats &stats = pool.getStats();
+   ASSERT_EQ(stats.misses, window);
+   ASSERT_EQ(stats.hits, rounds - window);
+   pool.drain();
+   std::cout << rounds << " objects, new/delete: " << duration_cast<microseconds>(heapTime).count()
+             << "us, pooled: " << duration_cast<microseconds>(poolTime).count() << "us" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+   int retCode = 0;
+   PHP_EMBED_START_BLOCK(argc,argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   retCode = RUN_ALL_TESTS();
+   PHP_EMBED_END_BLOCK();
+   return retCode;
+}
@@ -238,6 +238,22 @@ ZEND_END_MODULE_GLOBALS(zapi)
 #  define ZAPI_GV(v) (zapi_globals.v)
 #endif
 
+// Storage for the caches and counters the library keeps next to the
+// request it serves. Under ZTS every thread serves its own requests, so
+// each thread gets its own copy.
+#ifdef ZTS
+#  define ZAPI_THREAD_LOCAL thread_local
+#else
+#  define ZAPI_THREAD_LOCAL
+#endif
+
+// Before php-7.3.0 nothing is interned under ZTS, zend_new_interned_string()
+// returns its argument. The strings shared by the threads are flagged as
+// interned by zapi::internal::new_permanent_string() instead.
+#if defined(ZTS) && ZEND_MODULE_API_NO < 20180731
+#  define ZAPI_ZTS_NO_INTERNING
+#endif
+
 // We're almost there, we now need to declare an instance of the
 // structure defined above (if building for a single thread) or some
 // sort of impossible to understand magic pointer-to-a-pointer (for
@@ -25,20 +25,34 @@
 #include "zapi/ds/DoubleVariant.h"
 #include "zapi/ds/ArrayVariant.h"
 #include "zapi/ds/ArrayItemProxy.h"
+#include "zapi/ds/ArrayBuilder.h"
+#include "zapi/ds/PersistentArray.h"
+#include "zapi/ds/HashTable.h"
+#include "zapi/ds/Schema.h"
+#include "zapi/ds/Reflection.h"
+#include "zapi/ds/VariantTraits.h"
+#include "zapi/ds/JsonCodec.h"
+#include "zapi/ds/BinaryCodec.h"
 #include "zapi/ds/CallableVariant.h"
 #include "zapi/lang/Constant.h"
 #include "zapi/lang/Parameters.h"
 #include "zapi/lang/Class.h"
 #include "zapi/lang/StdClass.h"
+#include "zapi/lang/PropertySlot.h"
+#include "zapi/lang/ClassRef.h"
+#include "zapi/lang/MethodRef.h"
 #include "zapi/lang/Interface.h"
 #include "zapi/lang/Namespace.h"
 #include "zapi/lang/Ini.h"
 #include "zapi/lang/Extension.h"
 #include "zapi/kernel/StreamBuffer.h"
 #include "zapi/protocol/AbstractIterator.h"
+#include "zapi/protocol/FastIterator.h"
 #include "zapi/protocol/ArrayAccess.h"
 #include "zapi/protocol/Countable.h"
 #include "zapi/protocol/Serializable.h"
+#include "zapi/protocol/BufferSerializable.h"
+#include "zapi/protocol/BinarySerializable.h"
 #include "zapi/protocol/Traversable.h"
 
 #endif //ZAPI_ZENDAPI_H
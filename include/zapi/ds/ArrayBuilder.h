@@ -0,0 +1,142 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_ARRAY_BUILDER_H
+#define ZAPI_DS_ARRAY_BUILDER_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/ArrayKey.h"
+
+namespace zapi
+{
+namespace ds
+{
+
+class ArrayVariant;
+
+/**
+ * Write-once array builder, the hash table is allocated with the
+ * capacity up front, so filling it never triggers a resize or rehash
+ * when the capacity is right.
+ *
+ * The values are copied into the array (refcount increased), the New
+ * suffixed methods take over the reference of the value instead. Keys must
+ * be unique for add methods, use update when the key may already exist.
+ */
+class ZAPI_DECL_EXPORT ArrayBuilder final
+{
+public:
+   using SizeType = uint32_t;
+public:
+   explicit ArrayBuilder(SizeType capacity = 0, bool packed = true);
+   ArrayBuilder(const ArrayBuilder &other) = delete;
+   ArrayBuilder &operator =(const ArrayBuilder &other) = delete;
+   ~ArrayBuilder();
+
+   void append(zval *value)
+   {
+      value = prepareValue(value);
+      Z_TRY_ADDREF_P(value);
+      zend_hash_next_index_insert_new(ensureArray(), value);
+   }
+
+   void appendNew(zval *value)
+   {
+      zend_hash_next_index_insert_new(ensureArray(), value);
+   }
+
+   /**
+    * Add value with the key of a bucket, key is nullptr for integer keys
+    */
+   void add(zapi_ulong index, zend_string *key, zval *value)
+   {
+      value = prepareValue(value);
+      Z_TRY_ADDREF_P(value);
+      addNew(index, key, value);
+   }
+
+   void addNew(zapi_ulong index, zend_string *key, zval *value)
+   {
+      if (key) {
+         zend_hash_add_new(ensureArray(), key, value);
+      } else {
+         zend_hash_index_add_new(ensureArray(), index, value);
+      }
+   }
+
+   void add(const ArrayKey &key, zval *value)
+   {
+      add(key.getIndex(), key.getZendString(), value);
+   }
+
+   void update(zapi_ulong index, zend_string *key, zval *value)
+   {
+      value = prepareValue(value);
+      Z_TRY_ADDREF_P(value);
+      if (key) {
+         zend_hash_update(ensureArray(), key, value);
+      } else {
+         zend_hash_index_update(ensureArray(), index, value);
+      }
+   }
+
+   void update(const ArrayKey &key, zval *value)
+   {
+      update(key.getIndex(), key.getZendString(), value);
+   }
+
+   SizeType getSize() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_array ? zend_hash_num_elements(m_array) : 0;
+   }
+
+   // nullptr after build() until the next write
+   zend_array *getZendArrayPtr() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_array;
+   }
+
+   /**
+    * Hand the array over to a variant, the builder is empty after that and
+    * allocates a new array on the next write only
+    */
+   ArrayVariant build();
+protected:
+   zend_array *ensureArray()
+   {
+      if (UNEXPECTED(!m_array)) {
+         allocate();
+      }
+      return m_array;
+   }
+
+   void allocate();
+   // the same as the engine array functions, a reference that no one else
+   // hold is copied as the value it points to
+   static zval *prepareValue(zval *value) ZAPI_DECL_NOEXCEPT
+   {
+      if (Z_ISREF_P(value) && Z_REFCOUNT_P(value) == 1) {
+         value = Z_REFVAL_P(value);
+      }
+      return value;
+   }
+protected:
+   zend_array *m_array;
+};
+
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_ARRAY_BUILDER_H
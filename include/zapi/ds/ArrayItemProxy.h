@@ -29,6 +29,7 @@ class ArrayItemProxyPrivate;
 } // internal
 
 class ArrayItemProxy;
+class ArrayKey;
 class Variant;
 class NumericVariant;
 class DoubleVariant;
@@ -59,6 +60,7 @@ public:
    ArrayItemProxy(zval *array, const KeyType &requestKey, ArrayItemProxy *parent = nullptr);
    ArrayItemProxy(zval *array, const std::string &key, ArrayItemProxy *parent = nullptr);
    ArrayItemProxy(zval *array, zapi_ulong index, ArrayItemProxy *parent = nullptr);
+   ArrayItemProxy(zval *array, const ArrayKey &key, ArrayItemProxy *parent = nullptr);
    ArrayItemProxy(const ArrayItemProxy &other); // shadow copy
    ArrayItemProxy(ArrayItemProxy &&other) ZAPI_DECL_NOEXCEPT;
    ~ArrayItemProxy();
@@ -102,8 +104,9 @@ public:
    // nest assign
    ArrayItemProxy operator [](zapi_long index);
    ArrayItemProxy operator [](const std::string &key);
+   ArrayItemProxy operator [](const ArrayKey &key);
 protected:
-   bool ensureArrayExistRecusive(zval *&childArrayPtr, const KeyType &childRequestKey,
+   bool ensureArrayExistRecusive(zval *&childArrayPtr, const ArrayKey &childRequestKey,
                                  ArrayItemProxy *mostDerivedProxy);
    void checkExistRecursive(bool &stop, zval *&checkExistRecursive, 
                             ArrayItemProxy *mostDerivedProxy, bool quiet = false);
@@ -0,0 +1,102 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_ARRAY_KEY_H
+#define ZAPI_DS_ARRAY_KEY_H
+
+#include "zapi/Global.h"
+#include <string>
+#include <iosfwd>
+
+namespace zapi
+{
+namespace ds
+{
+
+/**
+ * Pre-hashed array key, holds either a numeric index or an interned
+ * zend_string whose hash value is calculated once at construction.
+ *
+ * Keys that are built during MINIT live as long as the process, interned
+ * ones are flagged permanent so that threads can share them without
+ * touching the refcount. Keys that are built inside a request must not
+ * outlive that request. Pass interned
+ * as false for one-shot keys that come from user data, so they don't stay
+ * in the interned string table until the request end.
+ */
+class ZAPI_DECL_EXPORT ArrayKey final
+{
+public:
+   explicit ArrayKey(zapi_ulong index) ZAPI_DECL_NOEXCEPT;
+   template <typename T,
+             typename Selector = typename std::enable_if<std::is_integral<T>::value>::type>
+   explicit ArrayKey(T index) ZAPI_DECL_NOEXCEPT
+      : ArrayKey(static_cast<zapi_ulong>(index))
+   {}
+   explicit ArrayKey(const std::string &key, bool interned = true);
+   explicit ArrayKey(const char *key);
+   ArrayKey(const char *key, size_t length, bool interned = true);
+   explicit ArrayKey(zend_string *key);
+   ArrayKey(const ArrayKey &other) ZAPI_DECL_NOEXCEPT;
+   ArrayKey(ArrayKey &&other) ZAPI_DECL_NOEXCEPT;
+   ~ArrayKey();
+   ArrayKey &operator =(const ArrayKey &other) ZAPI_DECL_NOEXCEPT;
+   ArrayKey &operator =(ArrayKey &&other) ZAPI_DECL_NOEXCEPT;
+   bool operator ==(const ArrayKey &other) const ZAPI_DECL_NOEXCEPT;
+   bool operator !=(const ArrayKey &other) const ZAPI_DECL_NOEXCEPT;
+
+   bool isIndex() const ZAPI_DECL_NOEXCEPT
+   {
+      return nullptr == m_key;
+   }
+
+   bool isString() const ZAPI_DECL_NOEXCEPT
+   {
+      return nullptr != m_key;
+   }
+
+   zapi_ulong getIndex() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_hash;
+   }
+
+   /**
+    * For string key return the cached hash value, for numeric key return
+    * the index self, the same as Bucket::h
+    */
+   zapi_ulong getHash() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_hash;
+   }
+
+   zend_string *getZendString() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_key;
+   }
+
+   std::string toString() const;
+protected:
+   void initStringKey(const char *key, size_t length, bool interned);
+protected:
+   zend_string *m_key;
+   zapi_ulong m_hash;
+};
+
+ZAPI_DECL_EXPORT std::ostream &operator<<(std::ostream &stream, const ArrayKey &key);
+
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_ARRAY_KEY_H
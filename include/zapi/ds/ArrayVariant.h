@@ -18,6 +18,7 @@
 
 #include <utility>
 #include <string>
+#include <algorithm>
 #include <list>
 #include <map>
 #include <type_traits>
@@ -25,6 +26,9 @@
 
 #include "zapi/ds/Variant.h"
 #include "zapi/ds/ArrayItemProxy.h"
+#include "zapi/ds/ArrayKey.h"
+#include "zapi/ds/ArrayBuilder.h"
+#include "zapi/ds/VariantTraits.h"
 #include "zapi/utils/CommonFuncs.h"
 
 namespace zapi
@@ -50,6 +54,23 @@ public:
    // forward declare
    class Iterator;
    class ConstIterator;
+   class MutationScope;
+   // operand of the multi-way set methods, binds to temporaries as well
+   class ArrayRef
+   {
+   public:
+      ArrayRef(const ArrayVariant &array) ZAPI_DECL_NOEXCEPT
+         : m_array(&array)
+      {}
+
+      operator const ArrayVariant &() const ZAPI_DECL_NOEXCEPT
+      {
+         return *m_array;
+      }
+   private:
+      const ArrayVariant *m_array;
+   };
+   using ArrayRefList = std::initializer_list<ArrayRef>;
 public:
    ArrayVariant();
    ArrayVariant(const ArrayVariant &other);
@@ -70,6 +91,7 @@ public:
    ArrayItemProxy operator [](T index);
    ArrayItemProxy operator [](const std::string &key);
    ArrayItemProxy operator [](const char *key);
+   ArrayItemProxy operator [](const ArrayKey &key);
    bool operator ==(const ArrayVariant &other) const;
    bool operator !=(const ArrayVariant &other) const;
    ArrayVariant &operator =(const ArrayVariant &other);
@@ -82,15 +104,24 @@ public:
    Iterator insert(zapi_ulong index, Variant &&value);
    Iterator insert(const std::string &key, const Variant &value);
    Iterator insert(const std::string &key, Variant &&value);
+   Iterator insert(const ArrayKey &key, const Variant &value);
+   Iterator insert(const ArrayKey &key, Variant &&value);
    Iterator append(const Variant &value);
    Iterator append(Variant &&value);
+   // write any type with VariantTraits straight into the array
+   template <typename T>
+   Iterator emplace(const ArrayKey &key, T &&value);
+   template <typename T>
+   Iterator emplaceBack(T &&value);
    void clear() ZAPI_DECL_NOEXCEPT;
    bool remove(zapi_ulong index) ZAPI_DECL_NOEXCEPT;
    bool remove(const std::string &key) ZAPI_DECL_NOEXCEPT;
+   bool remove(const ArrayKey &key) ZAPI_DECL_NOEXCEPT;
    Iterator erase(ConstIterator &iter);
    Iterator erase(Iterator &iter);
    Variant take(const std::string &key);
    Variant take(zapi_ulong index);
+   Variant take(const ArrayKey &key);
    // info access
    bool isEmpty() const ZAPI_DECL_NOEXCEPT;
    bool isNull() const ZAPI_DECL_NOEXCEPT;
@@ -99,17 +130,71 @@ public:
    SizeType count() const ZAPI_DECL_NOEXCEPT;
    Variant getValue(zapi_ulong index) const;
    Variant getValue(const std::string &key) const;
+   Variant getValue(const ArrayKey &key) const;
+   // the default value of T is returned for a missing key
+   template <typename T>
+   T getValueAs(const ArrayKey &key) const;
    bool contains(zapi_ulong index) const;
    bool contains(const std::string &key) const;
+   bool contains(const ArrayKey &key) const;
    zapi_long getNextInsertIndex() const;
    std::list<KeyType> getKeys() const;
    std::list<KeyType> getKeys(const Variant &value, bool strict = false) const;
    std::list<Variant> getValues() const;
    Iterator find(zapi_ulong index);
    Iterator find(const std::string &key);
+   Iterator find(const ArrayKey &key);
    ConstIterator find(zapi_ulong index) const;
    ConstIterator find(const std::string &key) const;
+   ConstIterator find(const ArrayKey &key) const;
    void map(Visitor visitor) const ZAPI_DECL_NOEXCEPT;
+   // sort methods
+   // value comparators receive two dereferenced zvals, key comparators receive
+   // two buckets, Bucket::key is nullptr for integer keys and Bucket::h holds the index
+   void sort(bool renumber = true);
+   template <typename Compare>
+   void sort(Compare compare, bool renumber = true);
+   template <typename Compare>
+   void stableSort(Compare compare, bool renumber = true);
+   void sortByKey();
+   template <typename Compare>
+   void sortByKey(Compare compare);
+   void sortByColumn(const ArrayKey &column, bool renumber = true);
+   void partialSort(SizeType count, bool renumber = true);
+   template <typename Compare>
+   void partialSort(SizeType count, Compare compare, bool renumber = true);
+   // set methods, the results keep the keys of this array except merge,
+   // value based methods compare the string representation of values as
+   // array_diff() does, or compare them with === when strict is true
+   ArrayVariant intersectKey(const ArrayVariant &other) const;
+   ArrayVariant intersectKey(ArrayRefList others) const;
+   ArrayVariant diffKey(const ArrayVariant &other) const;
+   ArrayVariant diffKey(ArrayRefList others) const;
+   ArrayVariant intersect(const ArrayVariant &other, bool strict = false) const;
+   ArrayVariant intersect(ArrayRefList others, bool strict = false) const;
+   ArrayVariant diff(const ArrayVariant &other, bool strict = false) const;
+   ArrayVariant diff(ArrayRefList others, bool strict = false) const;
+   ArrayVariant unique(bool strict = false) const;
+   ArrayVariant merge(const ArrayVariant &other) const;
+   ArrayVariant merge(ArrayRefList others) const;
+   // functional methods, the callbacks receive dereferenced zvals and the
+   // results are written through a builder allocated with the source size.
+   // mapper is void(const zval &value, zval *result), result is null
+   // initialized and the array takes it over, reducer is
+   // T(T accumulator, const zval &value), selector returns the ArrayKey
+   // of the group. The column methods work as array_column(), rows that are
+   // not arrays or miss the column are skipped
+   template <typename Predicate>
+   ArrayVariant filter(Predicate predicate, bool renumber = false) const;
+   template <typename Mapper>
+   ArrayVariant mapValues(Mapper mapper, bool renumber = false) const;
+   template <typename T, typename Reducer>
+   T reduce(T initial, Reducer reducer) const;
+   template <typename KeySelector>
+   ArrayVariant groupBy(KeySelector selector, bool preserveKeys = false) const;
+   ArrayVariant indexBy(const ArrayKey &column) const;
+   ArrayVariant column(const ArrayKey &column) const;
+   ArrayVariant column(const ArrayKey &column, const ArrayKey &indexColumn) const;
    // iterators
    Iterator begin() ZAPI_DECL_NOEXCEPT;
    ConstIterator begin() const ZAPI_DECL_NOEXCEPT;
@@ -198,16 +283,131 @@ public:
       friend class ArrayVariant;
    };
    
+   /**
+    * Batch mutation scope, the array is separated once when the scope is
+    * created, the writes through the scope go to the hash table directly
+    * without the copy on write check of every call.
+    * 
+    * Don't copy the array or modify it by other ways while the scope is
+    * alive, the hash table is not separated again. The scope owns nothing,
+    * every write is done when the call returns and the destructor has no
+    * work left, so the scope must not outlive the array.
+    */
+   class ZAPI_DECL_EXPORT MutationScope final
+   {
+   public:
+      using SeparationHandler = void (*)(const _zend_array *source, const _zend_array *copy);
+   public:
+      explicit MutationScope(ArrayVariant &array);
+      MutationScope(const MutationScope &other) = delete;
+      MutationScope &operator =(const MutationScope &other) = delete;
+      
+      /**
+       * Whether the scope made a full copy of the array
+       */
+      bool isSeparated() const ZAPI_DECL_NOEXCEPT
+      {
+         return m_separated;
+      }
+      
+      _zend_array *getHashTable() const ZAPI_DECL_NOEXCEPT
+      {
+         return m_array;
+      }
+      
+      SizeType getSize() const ZAPI_DECL_NOEXCEPT
+      {
+         return zend_hash_num_elements(m_array);
+      }
+      
+      zval *find(const ArrayKey &key) const ZAPI_DECL_NOEXCEPT
+      {
+         return key.isString() 
+               ? zend_hash_find(m_array, key.getZendString()) 
+               : zend_hash_index_find(m_array, key.getIndex());
+      }
+      
+      // the zval versions take over the reference of value, it is released
+      // when the hash table refuses it and nullptr is returned
+      zval *insert(const ArrayKey &key, zval *value)
+      {
+         zval *result = key.isString() 
+               ? zend_hash_update(m_array, key.getZendString(), value)
+               : zend_hash_index_update(m_array, key.getIndex(), value);
+         if (!result) {
+            zval_ptr_dtor(value);
+         }
+         return result;
+      }
+      
+      zval *insert(const ArrayKey &key, const Variant &value)
+      {
+         zval temp;
+         ZVAL_COPY(&temp, const_cast<zval *>(value.getZvalPtr()));
+         return insert(key, &temp);
+      }
+      
+      zval *append(zval *value)
+      {
+         zval *result = zend_hash_next_index_insert(m_array, value);
+         if (!result) {
+            zval_ptr_dtor(value);
+         }
+         return result;
+      }
+      
+      zval *append(const Variant &value)
+      {
+         zval temp;
+         ZVAL_COPY(&temp, const_cast<zval *>(value.getZvalPtr()));
+         return append(&temp);
+      }
+      
+      bool remove(const ArrayKey &key)
+      {
+         return SUCCESS == (key.isString() 
+                            ? zend_hash_del(m_array, key.getZendString()) 
+                            : zend_hash_index_del(m_array, key.getIndex()));
+      }
+      
+      void reserve(SizeType size);
+      // instrumentation of the copies that made by the scopes, the count
+      // and the handler belong to the calling thread under ZTS
+      static uint64_t getSeparationCount() ZAPI_DECL_NOEXCEPT;
+      static void resetSeparationCount() ZAPI_DECL_NOEXCEPT;
+      static void setSeparationHandler(SeparationHandler handler) ZAPI_DECL_NOEXCEPT;
+   protected:
+      _zend_array *m_array;
+      bool m_separated;
+   };
+   
 protected:
    _zend_array *getZendArrayPtr() const ZAPI_DECL_NOEXCEPT;
    _zend_array &getZendArray() const ZAPI_DECL_NOEXCEPT;
    uint32_t calculateIdxFromZval(zval *val) const ZAPI_DECL_NOEXCEPT;
    uint32_t findArrayIdx(const std::string &key) const ZAPI_DECL_NOEXCEPT;
    uint32_t findArrayIdx(zapi_ulong index) const ZAPI_DECL_NOEXCEPT;
+   uint32_t findArrayIdx(const ArrayKey &key) const ZAPI_DECL_NOEXCEPT;
+   // the array takes over value
+   Iterator insertZval(const ArrayKey &key, zval *value);
+   Iterator appendZval(zval *value);
+   Bucket *prepareSort(SizeType &count);
+   void finishSort(bool renumber);
+   ArrayVariant filterByKey(ArrayRefList others, bool keep) const;
+   ArrayVariant filterByValue(ArrayRefList others, bool keep, bool strict) const;
+   static const zval &derefZval(const zval &value) ZAPI_DECL_NOEXCEPT
+   {
+      return Z_ISREF(value) ? *Z_REFVAL(value) : value;
+   }
+   bool isPacked() const ZAPI_DECL_NOEXCEPT
+   {
+      return getZendArrayPtr()->u.flags & HASH_FLAG_PACKED;
+   }
 protected:
    friend class ArrayItemProxy;
    friend class Iterator;
    friend class ConstIterator;
+   friend class MutationScope;
 };
 
 template <typename T, typename Selector>
@@ -219,6 +419,176 @@ ArrayItemProxy ArrayVariant::operator [](T index)
    return operator [](static_cast<zapi_ulong>(index));
 }
 
+template <typename T>
+ArrayVariant::Iterator ArrayVariant::emplace(const ArrayKey &key, T &&value)
+{
+   zval temp;
+   to_zval(std::forward<T>(value), &temp);
+   return insertZval(key, &temp);
+}
+
+template <typename T>
+ArrayVariant::Iterator ArrayVariant::emplaceBack(T &&value)
+{
+   zval temp;
+   to_zval(std::forward<T>(value), &temp);
+   return appendZval(&temp);
+}
+
+template <typename T>
+T ArrayVariant::getValueAs(const ArrayKey &key) const
+{
+   uint32_t idx = findArrayIdx(key);
+   if (idx == HT_INVALID_IDX) {
+      return T();
+   }
+   zval *value = &getZendArrayPtr()->arData[idx].val;
+   if (Z_TYPE_P(value) == IS_INDIRECT) {
+      value = Z_INDIRECT_P(value);
+   }
+   return VariantTraits<T>::fromZval(value);
+}
+
+template <typename Compare>
+void ArrayVariant::sort(Compare compare, bool renumber)
+{
+   SizeType count;
+   Bucket *first = prepareSort(count);
+   if (first) {
+      std::sort(first, first + count, [&compare](const Bucket &lhs, const Bucket &rhs) -> bool {
+         return compare(derefZval(lhs.val), derefZval(rhs.val));
+      });
+   }
+   finishSort(renumber);
+}
+
+template <typename Compare>
+void ArrayVariant::stableSort(Compare compare, bool renumber)
+{
+   SizeType count;
+   Bucket *first = prepareSort(count);
+   if (first) {
+      std::stable_sort(first, first + count, [&compare](const Bucket &lhs, const Bucket &rhs) -> bool {
+         return compare(derefZval(lhs.val), derefZval(rhs.val));
+      });
+   }
+   finishSort(renumber);
+}
+
+template <typename Compare>
+void ArrayVariant::sortByKey(Compare compare)
+{
+   SizeType count;
+   Bucket *first = prepareSort(count);
+   if (first) {
+      std::sort(first, first + count, [&compare](const Bucket &lhs, const Bucket &rhs) -> bool {
+         return compare(lhs, rhs);
+      });
+   }
+   finishSort(false);
+}
+
+template <typename Compare>
+void ArrayVariant::partialSort(SizeType count, Compare compare, bool renumber)
+{
+   SizeType total;
+   Bucket *first = prepareSort(total);
+   if (first) {
+      std::partial_sort(first, first + std::min(count, total), first + total, 
+                        [&compare](const Bucket &lhs, const Bucket &rhs) -> bool {
+         return compare(derefZval(lhs.val), derefZval(rhs.val));
+      });
+   }
+   finishSort(renumber);
+}
+
+template <typename Predicate>
+ArrayVariant ArrayVariant::filter(Predicate predicate, bool renumber) const
+{
+   zend_array *self = getZendArrayPtr();
+   ArrayBuilder builder(zend_hash_num_elements(self), renumber || isPacked());
+   zapi_ulong index;
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(self, index, key, value) {
+      if (!predicate(derefZval(*value))) {
+         continue;
+      }
+      if (renumber) {
+         builder.append(value);
+      } else {
+         builder.add(index, key, value);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
+template <typename Mapper>
+ArrayVariant ArrayVariant::mapValues(Mapper mapper, bool renumber) const
+{
+   zend_array *self = getZendArrayPtr();
+   ArrayBuilder builder(zend_hash_num_elements(self), renumber || isPacked());
+   zapi_ulong index;
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(self, index, key, value) {
+      zval result;
+      ZVAL_NULL(&result);
+      mapper(derefZval(*value), &result);
+      if (renumber) {
+         builder.appendNew(&result);
+      } else {
+         builder.addNew(index, key, &result);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
+template <typename T, typename Reducer>
+T ArrayVariant::reduce(T initial, Reducer reducer) const
+{
+   zval *value;
+   ZEND_HASH_FOREACH_VAL_IND(getZendArrayPtr(), value) {
+      initial = reducer(std::move(initial), derefZval(*value));
+   } ZEND_HASH_FOREACH_END();
+   return initial;
+}
+
+template <typename KeySelector>
+ArrayVariant ArrayVariant::groupBy(KeySelector selector, bool preserveKeys) const
+{
+   ArrayBuilder builder(0, false);
+   zend_array *groups = builder.getZendArrayPtr();
+   zapi_ulong index;
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(getZendArrayPtr(), index, key, value) {
+      ArrayKey groupKey = selector(derefZval(*value));
+      zval *group = groupKey.isString()
+            ? zend_hash_find(groups, groupKey.getZendString())
+            : zend_hash_index_find(groups, groupKey.getIndex());
+      if (!group) {
+         zval newGroup;
+         array_init(&newGroup);
+         group = groupKey.isString()
+               ? zend_hash_add_new(groups, groupKey.getZendString(), &newGroup)
+               : zend_hash_index_add_new(groups, groupKey.getIndex(), &newGroup);
+      }
+      if (Z_ISREF_P(value) && Z_REFCOUNT_P(value) == 1) {
+         value = Z_REFVAL_P(value);
+      }
+      Z_TRY_ADDREF_P(value);
+      if (!preserveKeys) {
+         zend_hash_next_index_insert_new(Z_ARRVAL_P(group), value);
+      } else if (key) {
+         zend_hash_add_new(Z_ARRVAL_P(group), key, value);
+      } else {
+         zend_hash_index_add_new(Z_ARRVAL_P(group), index, value);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
 } // ds
 } // zapi
 
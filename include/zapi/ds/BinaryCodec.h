@@ -0,0 +1,210 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_BINARY_CODEC_H
+#define ZAPI_DS_BINARY_CODEC_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/Variant.h"
+#include "php/Zend/zend_smart_str.h"
+#include <string>
+#include <vector>
+
+namespace zapi
+{
+namespace ds
+{
+
+/**
+ * Writer of the zapi binary format, a compact and versioned encoding of
+ * the zval tree. Every write() produces one self contained document:
+ *
+ *  - the integers are zigzag varints, the doubles 8 little endian bytes
+ *  - the strings up to 128 bytes are written once per document, the
+ *    repeats refer to the first one by number
+ *  - the runs of integers or doubles in lists are written without a tag
+ *    per element
+ *  - objects are written once per document, the repeats refer to the first
+ *    one so the cycles through objects survive the round trip
+ *  - native objects implementing zapi::protocol::BinarySerializable write
+ *    their own payload, other objects are written with their properties
+ *
+ * References are written as the values they point to. Resources fail with
+ * UnsupportedType, so do the objects whose state is not their properties:
+ * the classes with serialize hooks (Serializable, closures) or __sleep(),
+ * and the internal classes creating their own objects without a zapi
+ * binder such as DateTime or ArrayObject, user subclasses included. A
+ * zapi::kernel::Exception thrown by writeBinary() fails with Rejected. The
+ * arrays and objects nested deeper than maxDepth fail with Depth, the same
+ * limit BinaryReader applies so a written document can always be read.
+ *
+ * The default writer fills a memory buffer read with getData() or
+ * detach(). Given a descriptor the writer flushes every 64KB and at the end
+ * of each document, a failed document may be partially written then.
+ */
+class ZAPI_DECL_EXPORT BinaryWriter final
+{
+public:
+   enum class Error : uint8_t
+   {
+      None,
+      Recursion,
+      UnsupportedType,
+      Rejected,
+      Depth,
+      Io
+   };
+public:
+   BinaryWriter();
+   // fd -1 keeps the documents in the memory buffer
+   explicit BinaryWriter(int fd, uint32_t maxDepth = 512);
+   BinaryWriter(const BinaryWriter &other) = delete;
+   BinaryWriter &operator =(const BinaryWriter &other) = delete;
+   ~BinaryWriter();
+
+   bool write(const Variant &value);
+   // for BinarySerializable::writeBinary(), one value of the payload
+   void writeValue(const Variant &value);
+   bool flush();
+
+   const char *getData() const ZAPI_DECL_NOEXCEPT;
+   size_t getSize() const ZAPI_DECL_NOEXCEPT;
+   // the buffered bytes as a string, the buffer is empty afterwards
+   Variant detach();
+   void clear();
+
+   Error getError() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_error;
+   }
+protected:
+   void writeZval(zval *value);
+   void writeArray(zend_array *array);
+   void writeList(zend_array *array);
+   void writeObject(zval *value);
+   void writeString(zend_string *str);
+   void writeVarint(uint64_t value);
+   void writeLong(zend_long value);
+   void writeDouble(double value);
+   void writeByte(unsigned char byte);
+   void resetTables();
+   void fail(Error error) ZAPI_DECL_NOEXCEPT
+   {
+      if (m_error == Error::None) {
+         m_error = error;
+      }
+   }
+protected:
+   smart_str m_buffer;
+   int m_fd;
+   size_t m_flushed;
+   uint32_t m_maxDepth;
+   uint32_t m_depth;
+   Error m_error;
+   zend_array *m_strings;
+   zend_array *m_objects;
+   // the objects of m_objects are kept alive so their handles are not reused
+   std::vector<zend_object *> m_objectRefs;
+};
+
+/**
+ * Reader of the documents written by BinaryWriter. The input is read in
+ * place, each container is allocated once with its final size and each
+ * string once. read() returns the documents one after another until the
+ * end of the input.
+ *
+ * The classes of the objects are looked up with autoloading, the objects
+ * are created without calling their constructor. As with unserialize()
+ * __wakeup() is called once the whole document is read, the inner objects
+ * first, the native objects restore themselves in readBinary() instead. A
+ * native object whose readBinary() returns false or throws
+ * zapi::kernel::Exception fails the document with Rejected, so does a
+ * __wakeup() throwing, its exception is left pending.
+ */
+class ZAPI_DECL_EXPORT BinaryReader final
+{
+public:
+   enum class Error : uint8_t
+   {
+      None,
+      Header,
+      Truncated,
+      Corrupted,
+      Depth,
+      ClassNotFound,
+      NotSerializable,
+      Rejected
+   };
+public:
+   BinaryReader(const char *data, size_t length, uint32_t maxDepth = 512);
+   explicit BinaryReader(const std::string &data, uint32_t maxDepth = 512);
+   BinaryReader(const BinaryReader &other) = delete;
+   BinaryReader &operator =(const BinaryReader &other) = delete;
+   ~BinaryReader();
+
+   bool read(Variant &result);
+   // for BinarySerializable::readBinary(), one value of the payload
+   bool readValue(Variant &value);
+
+   bool atEnd() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_cursor == m_end;
+   }
+
+   Error getError() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_error;
+   }
+
+   // byte offset from the start of the input
+   size_t getOffset() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_cursor - m_begin;
+   }
+protected:
+   bool readZval(zval *result);
+   bool readList(zval *result);
+   bool readMap(zval *result);
+   bool readObject(zval *result, bool native);
+   bool wakeupObjects();
+   bool readString(unsigned char tag, zend_string *&str);
+   bool readVarint(uint64_t &value);
+   bool readLong(zend_long &value);
+   bool readDouble(double &value);
+   void resetTables();
+   bool fail(Error error) ZAPI_DECL_NOEXCEPT
+   {
+      if (m_error == Error::None) {
+         m_error = error;
+      }
+      return false;
+   }
+protected:
+   const char *m_begin;
+   const char *m_cursor;
+   const char *m_end;
+   uint32_t m_maxDepth;
+   uint32_t m_depth;
+   Error m_error;
+   std::vector<zend_string *> m_strings;
+   std::vector<zend_object *> m_objects;
+   // the objects of m_objects having __wakeup(), in the order to call it
+   std::vector<zend_object *> m_wakeups;
+};
+
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_BINARY_CODEC_H
@@ -19,6 +19,8 @@
 #include "zapi/ds/Variant.h"
 #include "zapi/stdext/TypeTraits.h"
 #include "zapi/vm/Closure.h"
+#include <type_traits>
+#include <utility>
 
 namespace zapi
 {
@@ -36,8 +38,27 @@ namespace ds
 {
 
 using zapi::vm::Closure;
+using zapi::vm::ClosureCallableType;
 using zapi::lang::Parameters;
 
+namespace internal
+{
+
+template <typename CallableType, typename = void>
+struct is_closure_callable : std::false_type
+{};
+
+// functors taking Parameters &, Variant itself has a template call operator
+template <typename CallableType>
+struct is_closure_callable<CallableType, typename std::enable_if<
+      !std::is_base_of<Variant, typename std::decay<CallableType>::type>::value &&
+      std::is_convertible<decltype(std::declval<typename std::decay<CallableType>::type &>()(
+                                      std::declval<Parameters &>())), Variant>::value>::type>
+   : std::true_type
+{};
+
+} // internal
+
 class ZAPI_DECL_EXPORT CallableVariant final : public Variant
 {
 public:
@@ -45,6 +66,13 @@ public:
    using NoArgCallable = Variant();
    CallableVariant(HaveArgCallable callable);
    CallableVariant(NoArgCallable callable);
+   // lambdas and other functors, the captures are kept by the closure object
+   template <typename CallableType,
+             typename std::enable_if<internal::is_closure_callable<CallableType>::value, int>::type = 0>
+   CallableVariant(CallableType &&callable)
+   {
+      Closure::create(getUnDerefZvalPtr(), ClosureCallableType(std::forward<CallableType>(callable)));
+   }
    
    CallableVariant(const Variant &other);
    CallableVariant(const CallableVariant &other);
@@ -0,0 +1,420 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_HASH_TABLE_H
+#define ZAPI_DS_HASH_TABLE_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/ArrayKey.h"
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+namespace zapi
+{
+namespace ds
+{
+
+namespace internal
+{
+
+// pointer values are stored as IS_PTR zvals, the same as zend_hash_find_ptr()
+template <typename T>
+struct HashTableValueTraits
+{
+   static_assert(std::is_pointer<T>::value, "HashTable stores zval or pointer values");
+   using ValueType = T;
+
+   static ValueType fromZval(zval *value) ZAPI_DECL_NOEXCEPT
+   {
+      return value ? static_cast<ValueType>(Z_PTR_P(value)) : nullptr;
+   }
+
+   static zval *toZval(zval *buffer, ValueType value) ZAPI_DECL_NOEXCEPT
+   {
+      ZVAL_PTR(buffer, const_cast<void *>(static_cast<const void *>(value)));
+      return buffer;
+   }
+
+   static dtor_func_t getDefaultDestructor(bool) ZAPI_DECL_NOEXCEPT
+   {
+      return nullptr;
+   }
+};
+
+template <>
+struct HashTableValueTraits<zval>
+{
+   using ValueType = zval *;
+
+   static ValueType fromZval(zval *value) ZAPI_DECL_NOEXCEPT
+   {
+      return value;
+   }
+
+   static zval *toZval(zval *, ValueType value) ZAPI_DECL_NOEXCEPT
+   {
+      return value;
+   }
+
+   static dtor_func_t getDefaultDestructor(bool persistent) ZAPI_DECL_NOEXCEPT
+   {
+      return persistent ? ZVAL_INTERNAL_PTR_DTOR : ZVAL_PTR_DTOR;
+   }
+};
+
+} // internal
+
+/**
+ * Thin wrapper of zend_array, every method is an inline call of the
+ * zend_hash API, so it costs nothing over the Zend macros.
+ *
+ * HashTable<zval> holds zvals, the inserted zval is moved into the table
+ * as zend_hash_update() does. HashTable<Foo *> holds pointers, the same as
+ * the zend_hash_*_ptr() functions.
+ *
+ * A table that is created by the constructors owns the zend_array and
+ * destroys it, a table that wraps an existing zend_array, for example
+ * Z_ARRVAL_P(zv), doesn't own it.
+ */
+template <typename T = zval>
+class HashTable
+{
+public:
+   using SizeType = uint32_t;
+   using Traits = internal::HashTableValueTraits<T>;
+   using ValueType = typename Traits::ValueType;
+public:
+   HashTable()
+      : HashTable(8, false)
+   {}
+
+   explicit HashTable(SizeType capacity, bool persistent = false)
+      : HashTable(capacity, persistent, Traits::getDefaultDestructor(persistent))
+   {}
+
+   HashTable(SizeType capacity, bool persistent, dtor_func_t destructor)
+      : m_array(static_cast<zend_array *>(pemalloc(sizeof(zend_array), persistent))),
+        m_owned(true)
+   {
+      zend_hash_init(m_array, capacity, nullptr, destructor, persistent);
+   }
+
+   explicit HashTable(zend_array *array) ZAPI_DECL_NOEXCEPT
+      : m_array(array),
+        m_owned(false)
+   {}
+
+   HashTable(const HashTable &other) = delete;
+   HashTable &operator =(const HashTable &other) = delete;
+
+   HashTable(HashTable &&other) ZAPI_DECL_NOEXCEPT
+      : m_array(other.m_array),
+        m_owned(other.m_owned)
+   {
+      other.m_array = nullptr;
+      other.m_owned = false;
+   }
+
+   HashTable &operator =(HashTable &&other) ZAPI_DECL_NOEXCEPT
+   {
+      std::swap(m_array, other.m_array);
+      std::swap(m_owned, other.m_owned);
+      return *this;
+   }
+
+   ~HashTable()
+   {
+      if (m_owned && m_array) {
+         bool persistent = isPersistent();
+         zend_hash_destroy(m_array);
+         pefree(m_array, persistent);
+      }
+   }
+
+   /**
+    * Give up the ownership, for example to put the array into a zval
+    */
+   zend_array *detach() ZAPI_DECL_NOEXCEPT
+   {
+      m_owned = false;
+      return m_array;
+   }
+
+   zend_array *getZendArrayPtr() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_array;
+   }
+
+   SizeType getSize() const ZAPI_DECL_NOEXCEPT
+   {
+      return zend_hash_num_elements(m_array);
+   }
+
+   bool isEmpty() const ZAPI_DECL_NOEXCEPT
+   {
+      return 0 == zend_hash_num_elements(m_array);
+   }
+
+   bool isPacked() const ZAPI_DECL_NOEXCEPT
+   {
+      return (m_array->u.flags & HASH_FLAG_PACKED) != 0;
+   }
+
+   bool isPersistent() const ZAPI_DECL_NOEXCEPT
+   {
+      return (m_array->u.flags & HASH_FLAG_PERSISTENT) != 0;
+   }
+
+   // mode control, a fresh table picks the mode by the first insert,
+   // initPacked/initHash force it, a packed table turns to hash mode
+   // by itself when it gets a string key or a sparse index
+   void initPacked()
+   {
+      zend_hash_real_init(m_array, 1);
+   }
+
+   void initHash()
+   {
+      zend_hash_real_init(m_array, 0);
+   }
+
+   void convertToHash()
+   {
+      if (isPacked()) {
+         zend_hash_packed_to_hash(m_array);
+      }
+   }
+
+   void reserve(SizeType size)
+   {
+      zend_hash_extend(m_array, size, isPacked());
+   }
+
+   // lookup methods return nullptr when the key doesn't exist
+   ValueType find(zend_ulong index) const ZAPI_DECL_NOEXCEPT
+   {
+      return Traits::fromZval(zend_hash_index_find(m_array, index));
+   }
+
+   // integer literals match zend_ulong and zend_string * equally,
+   // so other integral types go through these templates
+   template <typename I, typename Selector = typename std::enable_if<std::is_integral<I>::value>::type>
+   ValueType find(I index) const ZAPI_DECL_NOEXCEPT
+   {
+      return find(static_cast<zend_ulong>(index));
+   }
+
+   ValueType find(zend_string *key) const ZAPI_DECL_NOEXCEPT
+   {
+      return Traits::fromZval(zend_hash_find(m_array, key));
+   }
+
+   ValueType find(const char *key, size_t length) const ZAPI_DECL_NOEXCEPT
+   {
+      return Traits::fromZval(zend_hash_str_find(m_array, key, length));
+   }
+
+   ValueType find(const ArrayKey &key) const ZAPI_DECL_NOEXCEPT
+   {
+      if (key.isIndex()) {
+         return find(key.getIndex());
+      }
+      zend_string *str = key.getZendString();
+      return Traits::fromZval(findKnownHash(ZSTR_VAL(str), ZSTR_LEN(str), key.getHash(), str));
+   }
+
+   /**
+    * Lookup with a hash value that calculated before, with zend_inline_hash_func()
+    * or zend_string_hash_val(), no hash is calculated here
+    */
+   ValueType find(const char *key, size_t length, zend_ulong hash) const ZAPI_DECL_NOEXCEPT
+   {
+      return Traits::fromZval(findKnownHash(key, length, hash, nullptr));
+   }
+
+   bool contains(zend_ulong index) const ZAPI_DECL_NOEXCEPT
+   {
+      return zend_hash_index_exists(m_array, index);
+   }
+
+   template <typename I, typename Selector = typename std::enable_if<std::is_integral<I>::value>::type>
+   bool contains(I index) const ZAPI_DECL_NOEXCEPT
+   {
+      return contains(static_cast<zend_ulong>(index));
+   }
+
+   bool contains(zend_string *key) const ZAPI_DECL_NOEXCEPT
+   {
+      return zend_hash_exists(m_array, key);
+   }
+
+   bool contains(const char *key, size_t length) const ZAPI_DECL_NOEXCEPT
+   {
+      return zend_hash_str_exists(m_array, key, length);
+   }
+
+   bool contains(const ArrayKey &key) const ZAPI_DECL_NOEXCEPT
+   {
+      if (key.isIndex()) {
+         return contains(key.getIndex());
+      }
+      zend_string *str = key.getZendString();
+      return nullptr != findKnownHash(ZSTR_VAL(str), ZSTR_LEN(str), key.getHash(), str);
+   }
+
+   // insert methods replace the old value, add methods return nullptr
+   // when the key exists already
+   ValueType insert(zend_ulong index, ValueType value)
+   {
+      zval buffer;
+      return Traits::fromZval(zend_hash_index_update(m_array, index, Traits::toZval(&buffer, value)));
+   }
+
+   template <typename I, typename Selector = typename std::enable_if<std::is_integral<I>::value>::type>
+   ValueType insert(I index, ValueType value)
+   {
+      return insert(static_cast<zend_ulong>(index), value);
+   }
+
+   ValueType insert(zend_string *key, ValueType value)
+   {
+      zval buffer;
+      return Traits::fromZval(zend_hash_update(m_array, key, Traits::toZval(&buffer, value)));
+   }
+
+   ValueType insert(const char *key, size_t length, ValueType value)
+   {
+      zval buffer;
+      return Traits::fromZval(zend_hash_str_update(m_array, key, length, Traits::toZval(&buffer, value)));
+   }
+
+   ValueType insert(const ArrayKey &key, ValueType value)
+   {
+      return key.isIndex() ? insert(key.getIndex(), value) : insert(key.getZendString(), value);
+   }
+
+   ValueType add(zend_ulong index, ValueType value)
+   {
+      zval buffer;
+      return Traits::fromZval(zend_hash_index_add(m_array, index, Traits::toZval(&buffer, value)));
+   }
+
+   template <typename I, typename Selector = typename std::enable_if<std::is_integral<I>::value>::type>
+   ValueType add(I index, ValueType value)
+   {
+      return add(static_cast<zend_ulong>(index), value);
+   }
+
+   ValueType add(zend_string *key, ValueType value)
+   {
+      zval buffer;
+      return Traits::fromZval(zend_hash_add(m_array, key, Traits::toZval(&buffer, value)));
+   }
+
+   ValueType add(const ArrayKey &key, ValueType value)
+   {
+      return key.isIndex() ? add(key.getIndex(), value) : add(key.getZendString(), value);
+   }
+
+   ValueType append(ValueType value)
+   {
+      zval buffer;
+      return Traits::fromZval(zend_hash_next_index_insert(m_array, Traits::toZval(&buffer, value)));
+   }
+
+   bool erase(zend_ulong index)
+   {
+      return SUCCESS == zend_hash_index_del(m_array, index);
+   }
+
+   template <typename I, typename Selector = typename std::enable_if<std::is_integral<I>::value>::type>
+   bool erase(I index)
+   {
+      return erase(static_cast<zend_ulong>(index));
+   }
+
+   bool erase(zend_string *key)
+   {
+      return SUCCESS == zend_hash_del(m_array, key);
+   }
+
+   bool erase(const char *key, size_t length)
+   {
+      return SUCCESS == zend_hash_str_del(m_array, key, length);
+   }
+
+   bool erase(const ArrayKey &key)
+   {
+      return key.isIndex() ? erase(key.getIndex()) : erase(key.getZendString());
+   }
+
+   void clear()
+   {
+      zend_hash_clean(m_array);
+   }
+
+   /**
+    * The callable receives (zend_ulong index, zend_string *key, ValueType value),
+    * key is nullptr for integer keys
+    */
+   template <typename Func>
+   void forEach(Func func) const
+   {
+      zend_ulong index;
+      zend_string *key;
+      zval *value;
+      ZEND_HASH_FOREACH_KEY_VAL(m_array, index, key, value) {
+         func(index, key, Traits::fromZval(value));
+      } ZEND_HASH_FOREACH_END();
+   }
+
+   template <typename Func>
+   void reverseForEach(Func func) const
+   {
+      zend_ulong index;
+      zend_string *key;
+      zval *value;
+      ZEND_HASH_REVERSE_FOREACH_KEY_VAL(m_array, index, key, value) {
+         func(index, key, Traits::fromZval(value));
+      } ZEND_HASH_FOREACH_END();
+   }
+
+protected:
+   zval *findKnownHash(const char *key, size_t length, zend_ulong hash, zend_string *str) const ZAPI_DECL_NOEXCEPT
+   {
+      // packed and uninitialized tables have an empty hash part
+      Bucket *arData = m_array->arData;
+      uint32_t idx = HT_HASH_EX(arData, static_cast<uint32_t>(hash | m_array->nTableMask));
+      while (idx != HT_INVALID_IDX) {
+         Bucket *p = HT_HASH_TO_BUCKET_EX(arData, idx);
+         if (p->key && (p->key == str || (p->h == hash && ZSTR_LEN(p->key) == length &&
+                                          0 == std::memcmp(ZSTR_VAL(p->key), key, length)))) {
+            return &p->val;
+         }
+         idx = Z_NEXT(p->val);
+      }
+      return nullptr;
+   }
+
+protected:
+   zend_array *m_array;
+   bool m_owned;
+};
+
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_HASH_TABLE_H
@@ -0,0 +1,181 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_JSON_CODEC_H
+#define ZAPI_DS_JSON_CODEC_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/Variant.h"
+#include "php/Zend/zend_smart_str.h"
+#include <string>
+#include <memory>
+
+namespace zapi
+{
+namespace ds
+{
+
+namespace internal
+{
+struct JsonKeyCache;
+} // internal
+
+/**
+ * Native JSON decoder, the result is the same as json_decode($json, true):
+ * objects become arrays, numeric keys become integer keys and the integers
+ * that overflow become doubles.
+ *
+ * The string runs and the whitespace are scanned 16 bytes at a time when
+ * SSE2 is available, the arrays are filled without duplicate checks and
+ * the repeated object keys share one zend_string.
+ *
+ * decode() parses one complete document. For streamed input feed() the
+ * chunks as they arrive and call next() until it returns false, every call
+ * returns one complete top-level value, so newline delimited or
+ * concatenated documents are split as well. Each byte is scanned once to
+ * find the end of a value and the value is parsed once. Call finish() after
+ * the last chunk, a value still open at that point is an error.
+ *
+ * The shared keys are released by reset() and the destructor, don't keep
+ * a decoder beyond the request that used it.
+ */
+class ZAPI_DECL_EXPORT JsonDecoder final
+{
+public:
+   enum class Error : uint8_t
+   {
+      None,
+      Depth,
+      Syntax,
+      ControlCharacter,
+      Utf8,
+      Utf16,
+      Incomplete
+   };
+public:
+   explicit JsonDecoder(uint32_t maxDepth = 512);
+   JsonDecoder(const JsonDecoder &other) = delete;
+   JsonDecoder &operator =(const JsonDecoder &other) = delete;
+   ~JsonDecoder();
+
+   bool decode(const char *json, size_t length, Variant &result);
+   bool decode(const std::string &json, Variant &result);
+
+   void feed(const char *data, size_t length);
+   void feed(const std::string &data);
+   bool next(Variant &result);
+   void finish();
+   void reset();
+
+   Error getError() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_error;
+   }
+
+   // byte offset of the error from the start of the input or the stream
+   size_t getErrorOffset() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_errorOffset;
+   }
+protected:
+   bool parse(const char *begin, const char *end, size_t offset, Variant &result);
+   bool scanValueEnd(size_t &boundary);
+   void resetScanState() ZAPI_DECL_NOEXCEPT;
+protected:
+   uint32_t m_maxDepth;
+   Error m_error;
+   size_t m_errorOffset;
+   std::unique_ptr<internal::JsonKeyCache> m_keys;
+   // stream state, m_buffer holds the bytes not returned by next() yet
+   std::string m_buffer;
+   size_t m_streamOffset;
+   size_t m_consumed;
+   size_t m_scanned;
+   uint32_t m_scanDepth;
+   bool m_valueStarted;
+   bool m_inScalar;
+   bool m_inString;
+   bool m_escaped;
+   bool m_finished;
+};
+
+/**
+ * Native JSON encoder writing straight into a smart_str, the output is the
+ * same as json_encode() with the matching options. Arrays with the keys 0
+ * to n - 1 in order are encoded as lists, objects implementing
+ * JsonSerializable are encoded as the value of jsonSerialize() and other
+ * objects with their public properties. The doubles follow
+ * serialize_precision.
+ */
+class ZAPI_DECL_EXPORT JsonEncoder final
+{
+public:
+   enum Option : uint32_t
+   {
+      PrettyPrint = 1,
+      UnescapedSlashes = 1 << 1,
+      UnescapedUnicode = 1 << 2,
+      PreserveZeroFraction = 1 << 3
+   };
+
+   enum class Error : uint8_t
+   {
+      None,
+      Depth,
+      Recursion,
+      InfOrNan,
+      Utf8,
+      UnsupportedType,
+      // jsonSerialize() threw or could not be called
+      SerializeFailed
+   };
+public:
+   explicit JsonEncoder(uint32_t options = 0, uint32_t maxDepth = 512);
+
+   // appends to buffer, buffer is left as it was on failure
+   bool encode(const Variant &value, smart_str &buffer);
+   bool encode(const Variant &value, std::string &json);
+   // false on failure as json_encode()
+   Variant encode(const Variant &value);
+
+   Error getError() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_error;
+   }
+protected:
+   bool encodeValue(smart_str *buffer, zval *value, uint32_t depth);
+   bool encodeArray(smart_str *buffer, zend_array *array, bool asObject, bool publicOnly, uint32_t depth);
+   bool encodeObject(smart_str *buffer, zval *object, uint32_t depth);
+   bool encodeSerializable(smart_str *buffer, zval *object, uint32_t depth);
+   bool encodeString(smart_str *buffer, const char *str, size_t length);
+   void encodeDouble(smart_str *buffer, double value);
+   void appendNewline(smart_str *buffer, uint32_t depth);
+   bool fail(Error error) ZAPI_DECL_NOEXCEPT
+   {
+      m_error = error;
+      return false;
+   }
+protected:
+   uint32_t m_options;
+   uint32_t m_maxDepth;
+   Error m_error;
+   // JsonSerializable, nullptr when ext/json is not loaded
+   zend_class_entry *m_serializableEntry;
+};
+
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_JSON_CODEC_H
@@ -24,6 +24,7 @@ namespace zapi
 namespace lang
 {
 class StdClass;
+class ClassRef;
 } // lang
 } // zapi
 
@@ -33,6 +34,7 @@ namespace ds
 {
 
 using zapi::lang::StdClass;
+using zapi::lang::ClassRef;
 
 class ZAPI_DECL_EXPORT ObjectVariant final : public Variant
 {
@@ -40,6 +42,7 @@ public:
    ObjectVariant();
    ObjectVariant(const std::string &className, std::shared_ptr<StdClass> nativeObject);
    ObjectVariant(zend_class_entry *entry, std::shared_ptr<StdClass> nativeObject);
+   ObjectVariant(const ClassRef &classRef, std::shared_ptr<StdClass> nativeObject);
    ObjectVariant(const Variant &other);
    ObjectVariant(const ObjectVariant &other);
    ObjectVariant(Variant &&other);
@@ -75,11 +78,13 @@ public:
    bool instanceOf(const char *className) const;
    bool instanceOf(const std::string &className) const;
    bool instanceOf(const ObjectVariant &other) const;
+   bool instanceOf(const ClassRef &classRef) const;
 
    bool derivedFrom(const char *className, size_t size) const;
    bool derivedFrom(const char *className) const;
    bool derivedFrom(const std::string &className) const;
    bool derivedFrom(const ObjectVariant &other) const;
+   bool derivedFrom(const ClassRef &classRef) const;
 private:
    ObjectVariant(StdClass *nativeObject);
    Variant exec(const char *name, int argc, Variant *argv);
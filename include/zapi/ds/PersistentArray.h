@@ -0,0 +1,100 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_PERSISTENT_ARRAY_H
+#define ZAPI_DS_PERSISTENT_ARRAY_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/ArrayKey.h"
+
+namespace zapi
+{
+namespace ds
+{
+
+class ArrayVariant;
+
+/**
+ * Immutable array that lives in persistent memory and is shared by all
+ * requests, the same as the arrays that opcache stores. Build it in the
+ * module startup handler, the keys and strings are interned, the nested
+ * arrays are immutable as well. Under ZTS before php-7.3.0 the engine
+ * interns nothing, the keys and strings are copies flagged as interned
+ * so the requests of the threads never touch their refcount.
+ *
+ * The variants that toArray() returns don't hold a reference, writing to
+ * them separates a request local copy. Objects and resources can't be
+ * stored, they are replaced with null.
+ */
+class ZAPI_DECL_EXPORT PersistentArray final
+{
+public:
+   using SizeType = uint32_t;
+public:
+   PersistentArray();
+   explicit PersistentArray(const ArrayVariant &source);
+   PersistentArray(const PersistentArray &other) = delete;
+   PersistentArray(PersistentArray &&other) ZAPI_DECL_NOEXCEPT;
+   PersistentArray &operator =(const PersistentArray &other) = delete;
+   PersistentArray &operator =(PersistentArray &&other) ZAPI_DECL_NOEXCEPT;
+   ~PersistentArray();
+
+   bool isEmpty() const ZAPI_DECL_NOEXCEPT
+   {
+      return nullptr == m_array || 0 == zend_hash_num_elements(m_array);
+   }
+
+   SizeType getSize() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_array ? zend_hash_num_elements(m_array) : 0;
+   }
+
+   /**
+    * Raw read access, returns nullptr when the key doesn't exist
+    */
+   const zval *find(const ArrayKey &key) const ZAPI_DECL_NOEXCEPT
+   {
+      if (!m_array) {
+         return nullptr;
+      }
+      return key.isString()
+            ? zend_hash_find(m_array, key.getZendString())
+            : zend_hash_index_find(m_array, key.getIndex());
+   }
+
+   bool contains(const ArrayKey &key) const ZAPI_DECL_NOEXCEPT
+   {
+      return nullptr != find(key);
+   }
+
+   zend_array *getZendArrayPtr() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_array;
+   }
+
+   /**
+    * Init target with the immutable array, no copy and no refcount
+    */
+   void copyTo(zval *target) const ZAPI_DECL_NOEXCEPT;
+   ArrayVariant toArray() const;
+   operator ArrayVariant() const;
+protected:
+   zend_array *m_array;
+};
+
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_PERSISTENT_ARRAY_H
@@ -0,0 +1,287 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_REFLECTION_H
+#define ZAPI_DS_REFLECTION_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/ArrayKey.h"
+#include "zapi/ds/ArrayVariant.h"
+#include "zapi/ds/VariantTraits.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+namespace zapi
+{
+namespace ds
+{
+
+/**
+ * Compile time description of a struct, specialized by ZAPI_REFLECT
+ */
+template <typename T>
+struct StructInfo
+{
+   static constexpr bool reflected = false;
+};
+
+namespace internal
+{
+
+ZAPI_DECL_EXPORT std::vector<ArrayKey> make_struct_keys(const char *const *names, size_t count);
+
+// the field keys of one reflected struct, trivially destructible so that
+// nothing touches the strings after the engine is gone
+struct StructKeys
+{
+   // interned at MINIT and flagged permanent, so all threads share them
+   // without refcounting, never released
+   const std::vector<ArrayKey> *permanent;
+   // built by the first use in a request, released at the request end
+   std::vector<ArrayKey> *request;
+};
+
+ZAPI_DECL_EXPORT const std::vector<ArrayKey> &get_struct_keys(StructKeys &keys, StructKeys &threadKeys,
+                                                              const char *const *names, size_t count);
+// called at RSHUTDOWN, before the request interned strings are freed
+ZAPI_DECL_EXPORT void release_struct_keys();
+
+} // internal
+
+/**
+ * Reflected structs are converted to arrays keyed by the field names
+ */
+template <typename T>
+struct VariantTraits<T, typename std::enable_if<StructInfo<T>::reflected>::type>
+{
+   static void toZval(const T &value, zval *target)
+   {
+      StructInfo<T>::toZval(value, target);
+   }
+
+   static bool fromZval(const zval *value, T &target)
+   {
+      return StructInfo<T>::fromZval(value, target);
+   }
+
+   static T fromZval(const zval *value)
+   {
+      T target{};
+      StructInfo<T>::fromZval(value, target);
+      return target;
+   }
+};
+
+namespace internal
+{
+
+// base of the ZAPI_REFLECT specializations, Info provides getFieldNames(),
+// getFieldCount() and visit()
+template <typename T, typename Info>
+struct StructInfoBase
+{
+   static constexpr bool reflected = true;
+
+   /**
+    * The field keys are interned for the process when they are built at
+    * module startup, call it in MINIT for the structs used by every request.
+    * Otherwise every request interns its own keys on the first use.
+    */
+   static const std::vector<ArrayKey> &getFieldKeys()
+   {
+      static StructKeys keys;
+      static ZAPI_THREAD_LOCAL StructKeys threadKeys;
+      return get_struct_keys(keys, threadKeys, Info::getFieldNames(), Info::getFieldCount());
+   }
+
+   /**
+    * Missing keys leave the fields untouched, return false when the value
+    * is not an array or a field can't be converted
+    */
+   static bool fromZval(const zval *value, T &object)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) != IS_ARRAY) {
+         return false;
+      }
+      ReadVisitor visitor{Z_ARRVAL_P(value), getFieldKeys().data(), true};
+      Info::visit(object, visitor);
+      return visitor.status;
+   }
+
+   static void toZval(const T &object, zval *target)
+   {
+      const std::vector<ArrayKey> &keys = getFieldKeys();
+      array_init_size(target, static_cast<uint32_t>(keys.size()));
+      WriteVisitor visitor{Z_ARRVAL_P(target), keys.data()};
+      Info::visit(object, visitor);
+   }
+
+   static bool fromArray(const ArrayVariant &array, T &object)
+   {
+      return fromZval(array.getZvalPtr(), object);
+   }
+
+   static T fromArray(const ArrayVariant &array)
+   {
+      T object{};
+      fromZval(array.getZvalPtr(), object);
+      return object;
+   }
+
+   static ArrayVariant toArray(const T &object)
+   {
+      zval value;
+      toZval(object, &value);
+      ArrayVariant array(&value);
+      zval_ptr_dtor(&value);
+      return array;
+   }
+
+protected:
+   struct ReadVisitor
+   {
+      zend_array *array;
+      const ArrayKey *key;
+      bool status;
+
+      template <typename FieldType>
+      void operator ()(FieldType &field)
+      {
+         zval *value = zend_hash_find(array, (key++)->getZendString());
+         if (value && !VariantTraits<FieldType>::fromZval(value, field)) {
+            status = false;
+         }
+      }
+   };
+
+   struct WriteVisitor
+   {
+      zend_array *array;
+      const ArrayKey *key;
+
+      template <typename FieldType>
+      void operator ()(const FieldType &field)
+      {
+         zval value;
+         VariantTraits<FieldType>::toZval(field, &value);
+         zend_hash_add_new(array, (key++)->getZendString(), &value);
+      }
+   };
+};
+
+} // internal
+
+} // ds
+} // zapi
+
+// the field list helpers of ZAPI_REFLECT
+#define ZAPI_REFLECT_EXPAND(x) x
+#define ZAPI_REFLECT_FE_1(macro, field) macro(field)
+#define ZAPI_REFLECT_FE_2(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_1(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_3(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_2(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_4(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_3(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_5(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_4(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_6(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_5(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_7(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_6(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_8(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_7(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_9(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_8(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_10(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_9(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_11(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_10(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_12(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_11(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_13(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_12(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_14(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_13(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_15(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_14(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_16(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_15(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_17(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_16(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_18(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_17(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_19(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_18(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_20(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_19(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_21(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_20(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_22(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_21(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_23(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_22(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_24(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_23(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_25(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_24(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_26(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_25(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_27(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_26(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_28(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_27(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_29(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_28(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_30(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_29(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_31(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_30(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_FE_32(macro, field, ...) macro(field) ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_FE_31(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_GET_FE(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define ZAPI_REFLECT_FOREACH(macro, ...) \
+   ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_GET_FE(__VA_ARGS__, \
+   ZAPI_REFLECT_FE_32, ZAPI_REFLECT_FE_31, ZAPI_REFLECT_FE_30, ZAPI_REFLECT_FE_29, ZAPI_REFLECT_FE_28, ZAPI_REFLECT_FE_27, ZAPI_REFLECT_FE_26, ZAPI_REFLECT_FE_25, \
+   ZAPI_REFLECT_FE_24, ZAPI_REFLECT_FE_23, ZAPI_REFLECT_FE_22, ZAPI_REFLECT_FE_21, ZAPI_REFLECT_FE_20, ZAPI_REFLECT_FE_19, ZAPI_REFLECT_FE_18, ZAPI_REFLECT_FE_17, \
+   ZAPI_REFLECT_FE_16, ZAPI_REFLECT_FE_15, ZAPI_REFLECT_FE_14, ZAPI_REFLECT_FE_13, ZAPI_REFLECT_FE_12, ZAPI_REFLECT_FE_11, ZAPI_REFLECT_FE_10, ZAPI_REFLECT_FE_9, \
+   ZAPI_REFLECT_FE_8, ZAPI_REFLECT_FE_7, ZAPI_REFLECT_FE_6, ZAPI_REFLECT_FE_5, ZAPI_REFLECT_FE_4, ZAPI_REFLECT_FE_3, ZAPI_REFLECT_FE_2, ZAPI_REFLECT_FE_1)(macro, __VA_ARGS__))
+#define ZAPI_REFLECT_GET_COUNT(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, COUNT, ...) COUNT
+#define ZAPI_REFLECT_FIELD_COUNT(...) \
+   ZAPI_REFLECT_EXPAND(ZAPI_REFLECT_GET_COUNT(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+
+#define ZAPI_REFLECT_FIELD_NAME(field) #field,
+#define ZAPI_REFLECT_VISIT_FIELD(field) visitor(object.field);
+
+/**
+ * Generate zapi::ds::StructInfo<Type> for the listed public fields, up to
+ * 32, must be used in the global namespace:
+ *
+ *    struct Order
+ *    {
+ *       zapi_long id;
+ *       int qty;
+ *       double price;
+ *       std::vector<std::string> tags;
+ *    };
+ *    ZAPI_REFLECT(Order, id, qty, price, tags)
+ *
+ *    Order order = zapi::ds::StructInfo<Order>::fromArray(array);
+ *    ArrayVariant result = zapi::ds::StructInfo<Order>::toArray(order);
+ *
+ * Fields can be any type with VariantTraits, the reflected structs
+ * included.
+ */
+#define ZAPI_REFLECT(Type, ...) \
+namespace zapi \
+{ \
+namespace ds \
+{ \
+template <> \
+struct StructInfo<Type> : internal::StructInfoBase<Type, StructInfo<Type>> \
+{ \
+   static const char *const *getFieldNames() \
+   { \
+      static const char *const names[] = { \
+         ZAPI_REFLECT_FOREACH(ZAPI_REFLECT_FIELD_NAME, __VA_ARGS__) \
+      }; \
+      return names; \
+   } \
+   static size_t getFieldCount() \
+   { \
+      return ZAPI_REFLECT_FIELD_COUNT(__VA_ARGS__); \
+   } \
+   template <typename ObjectType, typename Visitor> \
+   static void visit(ObjectType &object, Visitor &visitor) \
+   { \
+      ZAPI_REFLECT_FOREACH(ZAPI_REFLECT_VISIT_FIELD, __VA_ARGS__) \
+   } \
+}; \
+} \
+}
+
+#endif // ZAPI_DS_REFLECTION_H
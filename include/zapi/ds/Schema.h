@@ -0,0 +1,172 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_SCHEMA_H
+#define ZAPI_DS_SCHEMA_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/ArrayKey.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace zapi
+{
+namespace ds
+{
+
+class ArrayVariant;
+
+/**
+ * Validation schema of nested array payloads, compiled once into a flat
+ * instruction table, the field keys are pre-hashed persistent strings, so
+ * a schema compiled in a request may be kept for the later ones. Build it
+ * with the node builders or from a php array description:
+ *
+ *    ['type' => 'array', 'strict' => true, 'fields' => [
+ *       'id'   => ['type' => 'int', 'required' => true, 'min' => 1],
+ *       'name' => ['type' => 'string', 'maxLength' => 64, 'nullable' => true],
+ *       'tags' => ['type' => 'list', 'items' => ['type' => 'string']]
+ *    ]]
+ *
+ * The types are any, null, bool, int, float, number, string, array and
+ * list. min and max limit the numbers, minLength and maxLength limit the
+ * string length and the element count of the arrays. A strict array
+ * rejects the keys that are not declared as fields.
+ *
+ * validate() walks the payload in one pass and collects every violation
+ * with the path of the offending value, nothing is allocated when the
+ * payload is valid. isValid() stops at the first violation.
+ */
+class ZAPI_DECL_EXPORT Schema final
+{
+public:
+   enum class ValueType : uint8_t
+   {
+      Any,
+      Null,
+      Bool,
+      Long,
+      Double,
+      Number,
+      String,
+      Array,
+      List
+   };
+
+   enum class ViolationType : uint8_t
+   {
+      TypeMismatch,
+      MissingField,
+      UnknownField,
+      OutOfRange,
+      LengthOutOfRange
+   };
+
+   struct Violation
+   {
+      ViolationType type;
+      // the keys from the root joined with dot, empty for the root value
+      std::string path;
+   };
+
+   class ZAPI_DECL_EXPORT Node
+   {
+   public:
+      explicit Node(ValueType type = ValueType::Any);
+      Node &setNullable(bool nullable = true);
+      Node &setStrict(bool strict = true);
+      Node &setMin(double min);
+      Node &setMax(double max);
+      Node &setMinLength(uint32_t length);
+      Node &setMaxLength(uint32_t length);
+      Node &addField(const std::string &name, const Node &node, bool required = false);
+      Node &setItems(const Node &node);
+   protected:
+      struct Field
+      {
+         std::string name;
+         std::shared_ptr<Node> node;
+         bool required;
+      };
+   protected:
+      friend class Schema;
+      ValueType m_type;
+      bool m_nullable;
+      bool m_strict;
+      bool m_hasMin;
+      bool m_hasMax;
+      double m_min;
+      double m_max;
+      uint32_t m_minLength;
+      uint32_t m_maxLength;
+      std::vector<Field> m_fields;
+      std::shared_ptr<Node> m_items;
+   };
+public:
+   Schema();
+   explicit Schema(const Node &root);
+   explicit Schema(const ArrayVariant &description);
+
+   bool isValid(const ArrayVariant &payload) const;
+   bool validate(const ArrayVariant &payload, std::vector<Violation> &violations) const;
+
+   bool isEmpty() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_instructions.empty();
+   }
+protected:
+   struct Instruction
+   {
+      ArrayKey key;
+      ValueType type;
+      bool nullable;
+      bool strict;
+      bool required;
+      bool hasMin;
+      bool hasMax;
+      double min;
+      double max;
+      uint32_t minLength;
+      uint32_t maxLength;
+      uint32_t fieldStart;
+      uint32_t fieldCount;
+      // 0 when the elements are not checked, the root is never an item
+      uint32_t items;
+   };
+   // stack allocated, the path is only rendered for a violation
+   struct PathSegment
+   {
+      const PathSegment *parent;
+      zend_string *key;
+      zend_ulong index;
+   };
+protected:
+   void compile(const Node &node, uint32_t slot);
+   void appendInstruction(const Node &node, ArrayKey &&key, bool required);
+   bool check(zval *value, uint32_t slot, const PathSegment *path,
+              std::vector<Violation> *violations) const;
+   bool checkArray(zend_array *array, const Instruction &instruction, const PathSegment *path,
+                   std::vector<Violation> *violations) const;
+   static void report(std::vector<Violation> *violations, ViolationType type,
+                      const PathSegment *path);
+protected:
+   std::vector<Instruction> m_instructions;
+};
+
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_SCHEMA_H
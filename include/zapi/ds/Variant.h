@@ -19,6 +19,7 @@
 
 #include "zapi/Global.h"
 #include "zapi/lang/Type.h"
+#include "zapi/utils/CommonFuncs.h"
 
 #include <vector>
 #include <map>
@@ -170,6 +171,16 @@ public:
    bool operator !=(const Variant &other) const;
    bool strictEqual(const Variant &other) const;
    bool strictNotEqual(const Variant &other) const;
+   /**
+    * Stable 64-bit content hash, computed by walking the zval tree without
+    * any allocation. When ordered is false the elements of the arrays are
+    * combined regardless of their order, the keys still count.
+    *
+    * References are followed, an array or object that is met again while
+    * it is being walked is hashed as a recursion marker. Objects are hashed
+    * by class name and properties, resources by handle.
+    */
+   std::uint64_t fingerprint(bool ordered = true) const;
    /**
     * Cast to a boolean
     * @return boolean
@@ -0,0 +1,699 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_VARIANT_TRAITS_H
+#define ZAPI_DS_VARIANT_TRAITS_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/Variant.h"
+#include "zapi/stdext/Tuple.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+#  include <optional>
+#  include <variant>
+#  define ZAPI_VARIANT_TRAITS_HAS_STD17
+#endif
+
+namespace zapi
+{
+namespace ds
+{
+
+namespace internal
+{
+struct NoVariantTraits
+{};
+} // internal
+
+/**
+ * Conversion between native types and raw zvals, specialize it to pass a
+ * type across the boundary without an intermediate Variant:
+ *
+ *    static void toZval(const T &value, zval *target);
+ *    static bool fromZval(const zval *value, T &target);
+ *    static T fromZval(const zval *value);
+ *
+ * toZval() initializes target, the checked fromZval() returns false when
+ * the value can't be converted, the unchecked one returns the default
+ * value of T in that case. The specializations that gain from moving also
+ * provide toZval(T &&value, zval *target).
+ */
+template <typename T, typename Enable = void>
+struct VariantTraits : internal::NoVariantTraits
+{};
+
+template <typename T>
+struct has_variant_traits
+      : std::integral_constant<bool, !std::is_base_of<internal::NoVariantTraits,
+                                                      VariantTraits<typename std::decay<T>::type>>::value>
+{};
+
+template <typename T>
+void to_zval(T &&value, zval *target)
+{
+   VariantTraits<typename std::decay<T>::type>::toZval(std::forward<T>(value), target);
+}
+
+template <typename T>
+T from_zval(const zval *value)
+{
+   return VariantTraits<T>::fromZval(value);
+}
+
+template <typename T>
+bool from_zval(const zval *value, T &target)
+{
+   return VariantTraits<T>::fromZval(value, target);
+}
+
+template <typename T>
+Variant to_variant(T &&value)
+{
+   zval temp;
+   to_zval(std::forward<T>(value), &temp);
+   Variant result(&temp);
+   zval_ptr_dtor(&temp);
+   return result;
+}
+
+template <typename T>
+T variant_cast(const Variant &value)
+{
+   return VariantTraits<T>::fromZval(value.getZvalPtr());
+}
+
+namespace internal
+{
+
+inline bool is_container_zval(const zval *value)
+{
+   return Z_TYPE_P(value) == IS_ARRAY || Z_TYPE_P(value) == IS_OBJECT;
+}
+
+// keys of the associative containers, string keys follow the array
+// offset rules so "1" is stored as integer key
+template <typename KeyType, typename Enable = void>
+struct ArrayKeyTraits;
+
+template <typename KeyType>
+struct ArrayKeyTraits<KeyType, typename std::enable_if<std::is_integral<KeyType>::value>::type>
+{
+   static void update(zend_array *array, const KeyType &key, zval *value)
+   {
+      zend_hash_index_update(array, static_cast<zend_ulong>(key), value);
+   }
+
+   // false for the string keys that are not integers, "abc" is not 0
+   static bool fromBucket(zend_ulong index, zend_string *key, KeyType &target)
+   {
+      if (key && !ZEND_HANDLE_NUMERIC_STR(ZSTR_VAL(key), ZSTR_LEN(key), index)) {
+         return false;
+      }
+      target = static_cast<KeyType>(index);
+      return true;
+   }
+};
+
+template <>
+struct ArrayKeyTraits<std::string>
+{
+   static void update(zend_array *array, const std::string &key, zval *value)
+   {
+      zend_symtable_str_update(array, key.data(), key.length(), value);
+   }
+
+   static bool fromBucket(zend_ulong index, zend_string *key, std::string &target)
+   {
+      if (key) {
+         target.assign(ZSTR_VAL(key), ZSTR_LEN(key));
+      } else {
+         target = std::to_string(static_cast<zend_long>(index));
+      }
+      return true;
+   }
+};
+
+template <typename TupleType, size_t... Indexes>
+void tuple_to_zval(const TupleType &value, zval *target, zapi::stdext::index_sequence<Indexes...>)
+{
+   array_init_size(target, sizeof...(Indexes));
+   zend_hash_real_init(Z_ARRVAL_P(target), 1);
+   zend_array *array = Z_ARRVAL_P(target);
+   zval item;
+   int expander[] = {0, (to_zval(std::get<Indexes>(value), &item),
+                         zend_hash_next_index_insert_new(array, &item), 0)...};
+   (void)expander;
+}
+
+template <typename ItemType>
+bool tuple_item_from_zval(zend_array *array, zend_ulong index, ItemType &target)
+{
+   zval *item = zend_hash_index_find(array, index);
+   return item && VariantTraits<ItemType>::fromZval(item, target);
+}
+
+template <typename TupleType, size_t... Indexes>
+bool tuple_from_zval(zend_array *array, TupleType &target, zapi::stdext::index_sequence<Indexes...>)
+{
+   bool results[] = {true, tuple_item_from_zval(array, Indexes, std::get<Indexes>(target))...};
+   for (bool result : results) {
+      if (!result) {
+         return false;
+      }
+   }
+   return true;
+}
+
+} // internal
+
+template <>
+struct VariantTraits<std::nullptr_t>
+{
+   static void toZval(std::nullptr_t, zval *target)
+   {
+      ZVAL_NULL(target);
+   }
+};
+
+template <>
+struct VariantTraits<bool>
+{
+   static void toZval(bool value, zval *target)
+   {
+      ZVAL_BOOL(target, value);
+   }
+
+   static bool fromZval(const zval *value, bool &target)
+   {
+      target = zend_is_true(const_cast<zval *>(value));
+      return true;
+   }
+
+   static bool fromZval(const zval *value)
+   {
+      return zend_is_true(const_cast<zval *>(value));
+   }
+};
+
+// the same as Variant(char), a one byte string
+template <>
+struct VariantTraits<char>
+{
+   static void toZval(char value, zval *target)
+   {
+      ZVAL_STRINGL(target, &value, 1);
+   }
+
+   static bool fromZval(const zval *value, char &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) != IS_STRING || Z_STRLEN_P(value) != 1) {
+         return false;
+      }
+      target = Z_STRVAL_P(value)[0];
+      return true;
+   }
+
+   static char fromZval(const zval *value)
+   {
+      char target = 0;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+template <typename T>
+struct VariantTraits<T, typename std::enable_if<std::is_integral<T>::value &&
+                                                !std::is_same<T, bool>::value &&
+                                                !std::is_same<T, char>::value>::type>
+{
+   static void toZval(T value, zval *target)
+   {
+      ZVAL_LONG(target, static_cast<zend_long>(value));
+   }
+
+   static bool fromZval(const zval *value, T &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) == IS_LONG) {
+         target = static_cast<T>(Z_LVAL_P(value));
+         return true;
+      }
+      if (internal::is_container_zval(value)) {
+         return false;
+      }
+      target = static_cast<T>(zval_get_long(const_cast<zval *>(value)));
+      return true;
+   }
+
+   static T fromZval(const zval *value)
+   {
+      T target = 0;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+template <typename T>
+struct VariantTraits<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+   static void toZval(T value, zval *target)
+   {
+      ZVAL_DOUBLE(target, static_cast<double>(value));
+   }
+
+   static bool fromZval(const zval *value, T &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) == IS_DOUBLE) {
+         target = static_cast<T>(Z_DVAL_P(value));
+         return true;
+      }
+      if (internal::is_container_zval(value)) {
+         return false;
+      }
+      target = static_cast<T>(zval_get_double(const_cast<zval *>(value)));
+      return true;
+   }
+
+   static T fromZval(const zval *value)
+   {
+      T target = 0;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+template <>
+struct VariantTraits<std::string>
+{
+   static void toZval(const std::string &value, zval *target)
+   {
+      ZVAL_STRINGL(target, value.data(), value.length());
+   }
+
+   static bool fromZval(const zval *value, std::string &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) == IS_STRING) {
+         target.assign(Z_STRVAL_P(value), Z_STRLEN_P(value));
+         return true;
+      }
+      if (internal::is_container_zval(value)) {
+         return false;
+      }
+      zend_string *str = zval_get_string(const_cast<zval *>(value));
+      target.assign(ZSTR_VAL(str), ZSTR_LEN(str));
+      zend_string_release(str);
+      return true;
+   }
+
+   static std::string fromZval(const zval *value)
+   {
+      std::string target;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+template <>
+struct VariantTraits<const char *>
+{
+   static void toZval(const char *value, zval *target)
+   {
+      if (value) {
+         ZVAL_STRING(target, value);
+      } else {
+         ZVAL_NULL(target);
+      }
+   }
+};
+
+template <>
+struct VariantTraits<char *> : VariantTraits<const char *>
+{};
+
+/**
+ * Variant and the typed variants, the zval is shared with the engine
+ */
+template <typename T>
+struct VariantTraits<T, typename std::enable_if<std::is_base_of<Variant, T>::value>::type>
+{
+   static void toZval(const T &value, zval *target)
+   {
+      ZVAL_COPY(target, const_cast<zval *>(value.getZvalPtr()));
+   }
+
+   static bool fromZval(const zval *value, T &target)
+   {
+      target = fromZval(value);
+      return true;
+   }
+
+   static T fromZval(const zval *value)
+   {
+      ZVAL_DEREF(value);
+      return T(const_cast<zval *>(value));
+   }
+};
+
+// packed array, the vector is reserved with the element count
+template <typename T, typename Allocator>
+struct VariantTraits<std::vector<T, Allocator>>
+{
+   using ContainerType = std::vector<T, Allocator>;
+
+   static void toZval(const ContainerType &value, zval *target)
+   {
+      array_init_size(target, static_cast<uint32_t>(value.size()));
+      zend_hash_real_init(Z_ARRVAL_P(target), 1);
+      for (const T &element : value) {
+         zval item;
+         VariantTraits<T>::toZval(element, &item);
+         zend_hash_next_index_insert_new(Z_ARRVAL_P(target), &item);
+      }
+   }
+
+   static void toZval(ContainerType &&value, zval *target)
+   {
+      array_init_size(target, static_cast<uint32_t>(value.size()));
+      zend_hash_real_init(Z_ARRVAL_P(target), 1);
+      for (auto &&element : value) {
+         zval item;
+         VariantTraits<T>::toZval(std::move(element), &item);
+         zend_hash_next_index_insert_new(Z_ARRVAL_P(target), &item);
+      }
+   }
+
+   static bool fromZval(const zval *value, ContainerType &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) != IS_ARRAY) {
+         return false;
+      }
+      target.clear();
+      target.reserve(zend_hash_num_elements(Z_ARRVAL_P(value)));
+      zval *item;
+      ZEND_HASH_FOREACH_VAL_IND(Z_ARRVAL_P(value), item) {
+         T element{};
+         if (!VariantTraits<T>::fromZval(item, element)) {
+            return false;
+         }
+         target.push_back(std::move(element));
+      } ZEND_HASH_FOREACH_END();
+      return true;
+   }
+
+   static ContainerType fromZval(const zval *value)
+   {
+      ContainerType target;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+// ordered key value pairs, the keys may repeat in the vector, the last
+// one wins in the array
+template <typename KeyType, typename ValueType, typename Allocator>
+struct VariantTraits<std::vector<std::pair<KeyType, ValueType>, Allocator>>
+{
+   using ContainerType = std::vector<std::pair<KeyType, ValueType>, Allocator>;
+
+   static void toZval(const ContainerType &value, zval *target)
+   {
+      array_init_size(target, static_cast<uint32_t>(value.size()));
+      for (const std::pair<KeyType, ValueType> &element : value) {
+         zval item;
+         VariantTraits<ValueType>::toZval(element.second, &item);
+         internal::ArrayKeyTraits<KeyType>::update(Z_ARRVAL_P(target), element.first, &item);
+      }
+   }
+
+   static bool fromZval(const zval *value, ContainerType &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) != IS_ARRAY) {
+         return false;
+      }
+      target.clear();
+      target.reserve(zend_hash_num_elements(Z_ARRVAL_P(value)));
+      zend_ulong index;
+      zend_string *key;
+      zval *item;
+      ZEND_HASH_FOREACH_KEY_VAL_IND(Z_ARRVAL_P(value), index, key, item) {
+         KeyType elementKey{};
+         ValueType element{};
+         if (!internal::ArrayKeyTraits<KeyType>::fromBucket(index, key, elementKey) ||
+             !VariantTraits<ValueType>::fromZval(item, element)) {
+            return false;
+         }
+         target.emplace_back(std::move(elementKey), std::move(element));
+      } ZEND_HASH_FOREACH_END();
+      return true;
+   }
+
+   static ContainerType fromZval(const zval *value)
+   {
+      ContainerType target;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+namespace internal
+{
+
+// std::map and std::unordered_map
+template <typename ContainerType>
+struct MapVariantTraits
+{
+   using KeyType = typename ContainerType::key_type;
+   using ValueType = typename ContainerType::mapped_type;
+
+   static void toZval(const ContainerType &value, zval *target)
+   {
+      array_init_size(target, static_cast<uint32_t>(value.size()));
+      for (const typename ContainerType::value_type &element : value) {
+         zval item;
+         VariantTraits<ValueType>::toZval(element.second, &item);
+         ArrayKeyTraits<KeyType>::update(Z_ARRVAL_P(target), element.first, &item);
+      }
+   }
+
+   static bool fromZval(const zval *value, ContainerType &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) != IS_ARRAY) {
+         return false;
+      }
+      target.clear();
+      reserve(target, zend_hash_num_elements(Z_ARRVAL_P(value)), 0);
+      zend_ulong index;
+      zend_string *key;
+      zval *item;
+      ZEND_HASH_FOREACH_KEY_VAL_IND(Z_ARRVAL_P(value), index, key, item) {
+         KeyType elementKey{};
+         ValueType element{};
+         if (!ArrayKeyTraits<KeyType>::fromBucket(index, key, elementKey) ||
+             !VariantTraits<ValueType>::fromZval(item, element)) {
+            return false;
+         }
+         target.emplace(std::move(elementKey), std::move(element));
+      } ZEND_HASH_FOREACH_END();
+      return true;
+   }
+
+   static ContainerType fromZval(const zval *value)
+   {
+      ContainerType target;
+      fromZval(value, target);
+      return target;
+   }
+
+   // only the unordered containers can reserve
+   template <typename MapType>
+   static auto reserve(MapType &target, size_t size, int) -> decltype(target.reserve(size), void())
+   {
+      target.reserve(size);
+   }
+
+   template <typename MapType>
+   static void reserve(MapType &, size_t, long)
+   {}
+};
+
+} // internal
+
+template <typename KeyType, typename ValueType, typename Compare, typename Allocator>
+struct VariantTraits<std::map<KeyType, ValueType, Compare, Allocator>>
+      : internal::MapVariantTraits<std::map<KeyType, ValueType, Compare, Allocator>>
+{};
+
+template <typename KeyType, typename ValueType, typename Hash, typename KeyEqual, typename Allocator>
+struct VariantTraits<std::unordered_map<KeyType, ValueType, Hash, KeyEqual, Allocator>>
+      : internal::MapVariantTraits<std::unordered_map<KeyType, ValueType, Hash, KeyEqual, Allocator>>
+{};
+
+// packed array with one element per tuple item
+template <typename ...Types>
+struct VariantTraits<std::tuple<Types...>>
+{
+   using TupleType = std::tuple<Types...>;
+
+   static void toZval(const TupleType &value, zval *target)
+   {
+      internal::tuple_to_zval(value, target, zapi::stdext::make_index_sequence<sizeof...(Types)>{});
+   }
+
+   static bool fromZval(const zval *value, TupleType &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) != IS_ARRAY) {
+         return false;
+      }
+      return internal::tuple_from_zval(Z_ARRVAL_P(value), target,
+                                       zapi::stdext::make_index_sequence<sizeof...(Types)>{});
+   }
+
+   static TupleType fromZval(const zval *value)
+   {
+      TupleType target;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+#ifdef ZAPI_VARIANT_TRAITS_HAS_STD17
+
+namespace internal
+{
+
+// used to pick the alternative of std::variant that matches the zval type
+template <typename T>
+bool zval_type_matches(const zval *value)
+{
+   zend_uchar type = Z_TYPE_P(value);
+   if constexpr (std::is_same<T, bool>::value) {
+      return type == IS_TRUE || type == IS_FALSE;
+   } else if constexpr (std::is_integral<T>::value) {
+      return type == IS_LONG;
+   } else if constexpr (std::is_floating_point<T>::value) {
+      return type == IS_DOUBLE;
+   } else if constexpr (std::is_same<T, std::string>::value) {
+      return type == IS_STRING;
+   } else if constexpr (std::is_same<T, std::nullptr_t>::value) {
+      return type == IS_NULL;
+   } else if constexpr (std::is_base_of<Variant, T>::value) {
+      return true;
+   } else {
+      return type == IS_ARRAY;
+   }
+}
+
+template <typename VariantType, size_t Index>
+bool variant_from_zval(const zval *value, VariantType &target)
+{
+   if constexpr (Index < std::variant_size<VariantType>::value) {
+      using AlternativeType = std::variant_alternative_t<Index, VariantType>;
+      if (zval_type_matches<AlternativeType>(value)) {
+         AlternativeType alternative{};
+         if (VariantTraits<AlternativeType>::fromZval(value, alternative)) {
+            target = std::move(alternative);
+            return true;
+         }
+      }
+      return variant_from_zval<VariantType, Index + 1>(value, target);
+   } else {
+      return false;
+   }
+}
+
+} // internal
+
+template <typename T>
+struct VariantTraits<std::optional<T>>
+{
+   static void toZval(const std::optional<T> &value, zval *target)
+   {
+      if (value) {
+         VariantTraits<T>::toZval(*value, target);
+      } else {
+         ZVAL_NULL(target);
+      }
+   }
+
+   static bool fromZval(const zval *value, std::optional<T> &target)
+   {
+      ZVAL_DEREF(value);
+      if (Z_TYPE_P(value) == IS_NULL) {
+         target.reset();
+         return true;
+      }
+      T element{};
+      if (!VariantTraits<T>::fromZval(value, element)) {
+         return false;
+      }
+      target = std::move(element);
+      return true;
+   }
+
+   static std::optional<T> fromZval(const zval *value)
+   {
+      std::optional<T> target;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+// the first alternative whose type matches the zval is used
+template <typename ...Types>
+struct VariantTraits<std::variant<Types...>>
+{
+   using VariantType = std::variant<Types...>;
+
+   static void toZval(const VariantType &value, zval *target)
+   {
+      std::visit([target](const auto &alternative) {
+         to_zval(alternative, target);
+      }, value);
+   }
+
+   static bool fromZval(const zval *value, VariantType &target)
+   {
+      ZVAL_DEREF(value);
+      return internal::variant_from_zval<VariantType, 0>(value, target);
+   }
+
+   static VariantType fromZval(const zval *value)
+   {
+      VariantType target;
+      fromZval(value, target);
+      return target;
+   }
+};
+
+#endif
+
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_VARIANT_TRAITS_H
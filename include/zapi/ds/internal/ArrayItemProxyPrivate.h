@@ -19,6 +19,7 @@
 #define ZAPI_DS_INTERNAL_ARRAY_ITEM_PROXY_PRIVATE_H
 
 #include "zapi/Global.h"
+#include "zapi/ds/ArrayKey.h"
 
 namespace zapi
 {
@@ -37,7 +38,9 @@ class ArrayItemProxyPrivate
 public:
    ArrayItemProxyPrivate(zval *array, const KeyType &requestKey, 
                          ArrayItemProxy *apiPtr, ArrayItemProxy *parent)
-      : m_requestKey(requestKey),
+      : m_requestKey(requestKey.second 
+                     ? ArrayKey(*requestKey.second, false) 
+                     : ArrayKey(requestKey.first)),
         m_array(array),
         m_parent(parent),
         m_apiPtr(apiPtr)
@@ -45,7 +48,15 @@ public:
    
    ArrayItemProxyPrivate(zval *array, const std::string &key, 
                          ArrayItemProxy *apiPtr, ArrayItemProxy *parent)
-      : m_requestKey(-1, std::make_shared<std::string>(key)), // -1 is very big ulong
+      : m_requestKey(key, false),
+        m_array(array),
+        m_parent(parent),
+        m_apiPtr(apiPtr)
+   {}
+   
+   ArrayItemProxyPrivate(zval *array, const ArrayKey &key, 
+                         ArrayItemProxy *apiPtr, ArrayItemProxy *parent)
+      : m_requestKey(key),
         m_array(array),
         m_parent(parent),
         m_apiPtr(apiPtr)
@@ -53,7 +64,7 @@ public:
    
    ArrayItemProxyPrivate(zval *array, zapi_ulong index, 
                          ArrayItemProxy *apiPtr, ArrayItemProxy *parent)
-      : m_requestKey(index, nullptr),
+      : m_requestKey(index),
         m_array(array),
         m_parent(parent),
         m_apiPtr(apiPtr)
@@ -70,13 +81,16 @@ public:
       }
    }
    ZAPI_DECLARE_PUBLIC(ArrayItemProxy)
-   ArrayItemProxy::KeyType m_requestKey;
+   ArrayKey m_requestKey;
    zval *m_array;
    bool m_needCheckRequestItem = true;
    ArrayItemProxy *m_parent = nullptr;
    ArrayItemProxy *m_apiPtr;
 };
 
+// shared by ArrayItemProxy and ArrayVariant::getValue()
+void print_key_not_exist_notice(const ArrayKey &key);
+
 } // internal
 } // ds
 } // zapi
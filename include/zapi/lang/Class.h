@@ -21,12 +21,17 @@
 
 #include "zapi/vm/AbstractClass.h"
 #include "zapi/vm/InvokeBridge.h"
+#include "zapi/vm/FieldBinding.h"
+#include "zapi/lang/PropertySlot.h"
+#include "zapi/vm/ObjectPool.h"
+#include "zapi/vm/GcVisitor.h"
 #include "zapi/ds/StringVariant.h"
 #include "zapi/ds/BoolVariant.h"
 #include "zapi/ds/DoubleVariant.h"
 #include "zapi/ds/NumericVariant.h"
 #include "zapi/ds/ArrayVariant.h"
 #include "zapi/protocol/Serializable.h"
+#include "zapi/protocol/BufferSerializable.h"
 #include "zapi/protocol/Traversable.h"
 #include "zapi/stdext/TypeTraits.h"
 
@@ -38,7 +43,11 @@ namespace lang
 using zapi::ds::ArrayVariant;
 using zapi::vm::AbstractClass;
 using zapi::vm::InvokeBridge;
+using zapi::vm::FieldBinding;
+using zapi::vm::ObjectPool;
+using zapi::vm::GcVisitor;
 using zapi::protocol::Serializable;
+using zapi::protocol::BufferSerializable;
 using zapi::protocol::Traversable;
 using zapi::stdext::member_pointer_traits;
 
@@ -97,10 +106,13 @@ struct ClassMethodRegisterImpl<TargetClassType, CallalbleType, callable, false,
 {
    // for instance method register
    using ForwardCallableType = CallalbleType;
+   using BridgeType = InvokeBridge<ForwardCallableType, callable>;
 public:
    inline static void registerMethod(Class<TargetClassType> &meta, const char *name, Modifier flags, const Arguments &args)
    {
-      meta.registerMethod(name, &InvokeBridge<ForwardCallableType, callable>::invoke, flags, args);
+      meta.registerMethod(name, &BridgeType::invoke, flags, args);
+      // lets ObjectVariant::call() reach the method without the engine
+      zapi::vm::register_direct_invoke(&BridgeType::invoke, zapi::vm::DirectInvokeOf<BridgeType>::get());
    }
 };
 
@@ -164,6 +176,15 @@ public:
    Class<T> &registerProperty(const char *name, Variant (T::*getter)(), void (T::*setter)(const Variant &value) const);
    Class<T> &registerProperty(const char *name, Variant (T::*getter)() const, void (T::*setter)(const Variant &value));
    Class<T> &registerProperty(const char *name, Variant (T::*getter)() const, void (T::*setter)(const Variant &value) const);
+   // public property read and written straight from the member, scalars and std::string only
+   template <typename FieldType>
+   typename std::enable_if<!std::is_function<FieldType>::value, Class<T> &>::type
+   registerProperty(const char *name, FieldType T::*field);
+   // public read-only property computed on the first read, StdClass::invalidateProperty() resets it
+   Class<T> &registerLazyProperty(const char *name, Variant (T::*compute)());
+   Class<T> &registerLazyProperty(const char *name, Variant (T::*compute)() const);
+   // handle for StdClass::slot(), resolved when the class is initialized
+   PropertySlot getPropertySlot(const char *name);
 
    Class<T> &registerConstant(const char *name, std::nullptr_t value);
    Class<T> &registerConstant(const char *name, int16_t value);
@@ -184,12 +205,19 @@ public:
    template <typename ClassType>
    Class<T> &registerBaseClass(Class<ClassType> &&baseClass);
 
+   // recycle the storage of destroyed objects, call it before any object is
+   // created, no-op under ZTS
+   Class<T> &enableObjectPool(size_t capacity = 64);
+   static ObjectPool &getObjectPool();
+
 private:
    virtual StdClass *construct() const override;
    virtual StdClass *clone(StdClass *orig) const override;
+   virtual void destroy(StdClass *nativeObject) const override;
    virtual bool clonable() const override;
    virtual bool serializable() const override;
    virtual bool traversable() const override;
+   virtual bool gcVisitable() const override;
    virtual void callClone(StdClass *nativeObject) const override;
    virtual int callCompare(StdClass *left, StdClass *right) const override;
    virtual void callDestruct(StdClass *nativeObject) const override;
@@ -197,6 +225,9 @@ private:
    virtual Variant callMagicStaticCall(const char *name, Parameters &params) const override;
    virtual Variant callMagicInvoke(StdClass *nativeObject, Parameters &params) const override;
    virtual ArrayVariant callDebugInfo(StdClass *nativeObject) const override;
+   virtual void callSerialize(StdClass *nativeObject, smart_string &buffer) const override;
+   virtual bool callUnserialize(StdClass *nativeObject, const char *input, size_t length) const override;
+   virtual void callGcVisit(StdClass *nativeObject, GcVisitor &visitor) const override;
    
    virtual Variant callGet(StdClass *nativeObject, const std::string &name) const override;
    virtual void callSet(StdClass *nativeObject, const std::string &name, const Variant &value) const override;
@@ -220,6 +251,38 @@ private:
    typename std::enable_if<std::is_copy_constructible<X>::value, StdClass *>::type
    static doCloneObject(X *orig);
 
+   template <typename X, typename ...Args>
+   static StdClass *newObject(Args &&...args);
+
+   // BufferSerializable is preferred when a class implements both protocols
+   template <typename X = T>
+   typename std::enable_if<std::is_base_of<BufferSerializable, X>::value>::type
+   static doSerialize(X *object, smart_string &buffer);
+
+   template <typename X = T>
+   typename std::enable_if<!std::is_base_of<BufferSerializable, X>::value &&
+                           std::is_base_of<Serializable, X>::value>::type
+   static doSerialize(X *object, smart_string &buffer);
+
+   template <typename X = T>
+   typename std::enable_if<!std::is_base_of<BufferSerializable, X>::value &&
+                           !std::is_base_of<Serializable, X>::value>::type
+   static doSerialize(X *object, smart_string &buffer);
+
+   template <typename X = T>
+   typename std::enable_if<std::is_base_of<BufferSerializable, X>::value, bool>::type
+   static doUnserialize(X *object, const char *input, size_t length);
+
+   template <typename X = T>
+   typename std::enable_if<!std::is_base_of<BufferSerializable, X>::value &&
+                           std::is_base_of<Serializable, X>::value, bool>::type
+   static doUnserialize(X *object, const char *input, size_t length);
+
+   template <typename X = T>
+   typename std::enable_if<!std::is_base_of<BufferSerializable, X>::value &&
+                           !std::is_base_of<Serializable, X>::value, bool>::type
+   static doUnserialize(X *object, const char *input, size_t length);
+
    template <typename X = T>
    typename std::enable_if<!std::is_copy_constructible<X>::value, StdClass *>::type
    static doCloneObject(X *orig);
@@ -439,6 +502,35 @@ Class<T> &Class<T>::registerProperty(const char *name, Variant (T::*getter)() co
    return *this;
 }
 
+template <typename T>
+template <typename FieldType>
+typename std::enable_if<!std::is_function<FieldType>::value, Class<T> &>::type
+Class<T>::registerProperty(const char *name, FieldType T::*field)
+{
+   AbstractClass::registerFieldBinding(name, std::make_shared<FieldBinding<T, FieldType>>(field));
+   return *this;
+}
+
+template <typename T>
+Class<T> &Class<T>::registerLazyProperty(const char *name, Variant (T::*compute)())
+{
+   AbstractClass::registerLazyProperty(name, static_cast<zapi::GetterMethodCallable0>(compute));
+   return *this;
+}
+
+template <typename T>
+Class<T> &Class<T>::registerLazyProperty(const char *name, Variant (T::*compute)() const)
+{
+   AbstractClass::registerLazyProperty(name, static_cast<zapi::GetterMethodCallable1>(compute));
+   return *this;
+}
+
+template <typename T>
+PropertySlot Class<T>::getPropertySlot(const char *name)
+{
+   return AbstractClass::getPropertySlot(name);
+}
+
 template <typename T>
 Class<T> &Class<T>::registerConstant(const char *name, std::nullptr_t value)
 {
@@ -515,6 +607,34 @@ StdClass *Class<T>::construct() const
    return doConstructObject<T>();
 }
 
+template <typename T>
+void Class<T>::destroy(StdClass *nativeObject) const
+{
+   ObjectPool &pool = getObjectPool();
+   if (!pool.routesObjects()) {
+      delete nativeObject;
+      return;
+   }
+   T *object = static_cast<T *>(nativeObject);
+   object->~T();
+   pool.release(object);
+}
+
+template <typename T>
+Class<T> &Class<T>::enableObjectPool(size_t capacity)
+{
+   static_assert(alignof(T) <= ZEND_MM_ALIGNMENT, "the pooled storage comes from emalloc");
+   getObjectPool().setCapacity(capacity);
+   return *this;
+}
+
+template <typename T>
+ObjectPool &Class<T>::getObjectPool()
+{
+   static ObjectPool pool(sizeof(T));
+   return pool;
+}
+
 template <typename T>
 void Class<T>::callDestruct(StdClass *nativeObject) const
 {
@@ -549,6 +669,24 @@ ArrayVariant Class<T>::callDebugInfo(StdClass *nativeObject) const
    return object->__debugInfo();
 }
 
+template <typename T>
+void Class<T>::callSerialize(StdClass *nativeObject, smart_string &buffer) const
+{
+   doSerialize<T>(static_cast<T *>(nativeObject), buffer);
+}
+
+template <typename T>
+bool Class<T>::callUnserialize(StdClass *nativeObject, const char *input, size_t length) const
+{
+   return doUnserialize<T>(static_cast<T *>(nativeObject), input, length);
+}
+
+template <typename T>
+void Class<T>::callGcVisit(StdClass *nativeObject, GcVisitor &visitor) const
+{
+   static_cast<T *>(nativeObject)->gcVisit(visitor);
+}
+
 template <typename T>
 Variant Class<T>::callGet(StdClass *nativeObject, const std::string &name) const
 {
@@ -610,7 +748,7 @@ template <typename X>
 typename std::enable_if<std::is_default_constructible<X>::value, StdClass *>::type
 Class<T>::doConstructObject()
 {
-   return new X();
+   return newObject<X>();
 }
 
 template <typename T>
@@ -626,7 +764,24 @@ template <typename X>
 typename std::enable_if<std::is_copy_constructible<X>::value, StdClass *>::type
 Class<T>::doCloneObject(X *orig)
 {
-   return new X(*orig);
+   return newObject<X>(*orig);
+}
+
+template <typename T>
+template <typename X, typename ...Args>
+StdClass *Class<T>::newObject(Args &&...args)
+{
+   ObjectPool &pool = getObjectPool();
+   if (!pool.routesObjects()) {
+      return new X(std::forward<Args>(args)...);
+   }
+   void *storage = pool.allocate();
+   try {
+      return new (storage) X(std::forward<Args>(args)...);
+   } catch (...) {
+      pool.release(storage);
+      throw;
+   }
 }
 
 template <typename T>
@@ -637,6 +792,58 @@ Class<T>::doCloneObject(X *orig)
    return nullptr;
 }
 
+template <typename T>
+template <typename X>
+typename std::enable_if<std::is_base_of<BufferSerializable, X>::value>::type
+Class<T>::doSerialize(X *object, smart_string &buffer)
+{
+   object->serializeTo(buffer);
+}
+
+template <typename T>
+template <typename X>
+typename std::enable_if<!std::is_base_of<BufferSerializable, X>::value &&
+                        std::is_base_of<Serializable, X>::value>::type
+Class<T>::doSerialize(X *object, smart_string &buffer)
+{
+   std::string value = object->serialize();
+   smart_string_appendl(&buffer, value.c_str(), value.length());
+}
+
+template <typename T>
+template <typename X>
+typename std::enable_if<!std::is_base_of<BufferSerializable, X>::value &&
+                        !std::is_base_of<Serializable, X>::value>::type
+Class<T>::doSerialize(X *object, smart_string &buffer)
+{}
+
+template <typename T>
+template <typename X>
+typename std::enable_if<std::is_base_of<BufferSerializable, X>::value, bool>::type
+Class<T>::doUnserialize(X *object, const char *input, size_t length)
+{
+   return object->unserializeFrom(input, length);
+}
+
+template <typename T>
+template <typename X>
+typename std::enable_if<!std::is_base_of<BufferSerializable, X>::value &&
+                        std::is_base_of<Serializable, X>::value, bool>::type
+Class<T>::doUnserialize(X *object, const char *input, size_t length)
+{
+   object->unserialize(input, length);
+   return true;
+}
+
+template <typename T>
+template <typename X>
+typename std::enable_if<!std::is_base_of<BufferSerializable, X>::value &&
+                        !std::is_base_of<Serializable, X>::value, bool>::type
+Class<T>::doUnserialize(X *object, const char *input, size_t length)
+{
+   return false;
+}
+
 template <typename T>
 template <typename X>
 typename std::enable_if<Class<T>::template HasCallStatic<X>::value, Variant>::type
@@ -670,7 +877,7 @@ bool Class<T>::clonable() const
 template <typename T>
 bool Class<T>::serializable() const
 {
-   return std::is_base_of<Serializable, T>::value;
+   return std::is_base_of<Serializable, T>::value || std::is_base_of<BufferSerializable, T>::value;
 }
 
 template <typename T>
@@ -679,6 +886,13 @@ bool Class<T>::traversable() const
    return std::is_base_of<Traversable, T>::value;
 }
 
+template <typename T>
+bool Class<T>::gcVisitable() const
+{
+   // only the classes that override StdClass::gcVisit report anything
+   return !std::is_same<decltype(&T::gcVisit), void (StdClass::*)(GcVisitor &) const>::value;
+}
+
 template <typename T>
 void Class<T>::callClone(StdClass *nativeObject) const
 {
@@ -0,0 +1,87 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_LANG_CLASS_REF_H
+#define ZAPI_LANG_CLASS_REF_H
+
+#include "zapi/Global.h"
+#include <string>
+
+// forward declare with namespace
+namespace zapi
+{
+namespace lang
+{
+namespace internal
+{
+class ExtensionPrivate;
+} // internal
+} // lang
+} // zapi
+// end forward declare
+
+namespace zapi
+{
+namespace lang
+{
+
+/**
+ * Cached handle of a class entry. The name is lowercased once, the entry
+ * is looked up on first use and then kept, internal classes for the life
+ * of the process and userland classes until the request ends. Keep it in
+ * a static and pass it to ObjectVariant::instanceOf(), derivedFrom() or
+ * the ObjectVariant constructor instead of the class name. The lookup
+ * never triggers the autoloader. Under ZTS only the internal entries are
+ * kept, the userland ones differ from thread to thread.
+ */
+class ZAPI_DECL_EXPORT ClassRef final
+{
+public:
+   explicit ClassRef(const char *name);
+   explicit ClassRef(const std::string &name);
+   explicit ClassRef(zend_class_entry *entry);
+
+   zend_class_entry *getEntry() const;
+
+   bool isValid() const
+   {
+      return getEntry() != nullptr;
+   }
+
+   const std::string &getName() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_name;
+   }
+
+   // class table lookup without allocating the lowercased key
+   static zend_class_entry *lookup(const char *name, size_t length);
+   // unique to the request running on the calling thread, the caches of
+   // userland entries compare it
+   static uint64_t getRequestEpoch() ZAPI_DECL_NOEXCEPT;
+private:
+   static void nextRequest() ZAPI_DECL_NOEXCEPT;
+private:
+   std::string m_name;
+   std::string m_key;
+   mutable zend_class_entry *m_entry;
+   mutable uint64_t m_epoch;
+   mutable bool m_persistent;
+   friend class internal::ExtensionPrivate;
+};
+
+} // lang
+} // zapi
+
+#endif // ZAPI_LANG_CLASS_REF_H
@@ -0,0 +1,61 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_LANG_METHOD_REF_H
+#define ZAPI_LANG_METHOD_REF_H
+
+#include "zapi/Global.h"
+#include <string>
+
+namespace zapi
+{
+namespace lang
+{
+
+/**
+ * Method name handle for StdClass::callParent(), the name is lowercased
+ * and hashed once when the handle is built. The method found for the last
+ * class is remembered, so keep the handle in a static and a repeated call
+ * does no string work and no hash lookup. Under ZTS nothing is
+ * remembered, every call looks the prehashed name up.
+ */
+class ZAPI_DECL_EXPORT MethodRef final
+{
+public:
+   explicit MethodRef(const char *name);
+   MethodRef(const MethodRef &other) = delete;
+   MethodRef &operator=(const MethodRef &other) = delete;
+   ~MethodRef();
+
+   const std::string &getName() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_name;
+   }
+
+   // scope nullptr looks in the global function table
+   zend_function *find(zend_class_entry *scope) const;
+private:
+   std::string m_name;
+   zend_string *m_key;
+   mutable zend_class_entry *m_scope;
+   mutable zend_function *m_function;
+   mutable uint64_t m_epoch;
+   mutable bool m_persistent;
+};
+
+} // lang
+} // zapi
+
+#endif // ZAPI_LANG_METHOD_REF_H
@@ -68,6 +68,7 @@ public:
    {}
    
    Parameters(zval *thisPtr, uint32_t argc);
+   Parameters(StdClass *object, zval *arguments, uint32_t argc);
    
 public:
    
@@ -0,0 +1,146 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_LANG_PROPERTY_SLOT_H
+#define ZAPI_LANG_PROPERTY_SLOT_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/Variant.h"
+#include "zapi/ds/VariantTraits.h"
+
+// forward declare with namespace
+namespace zapi
+{
+namespace vm
+{
+class AbstractClass;
+} // vm
+} // zapi
+// end forward declare
+
+namespace zapi
+{
+namespace lang
+{
+
+using zapi::ds::Variant;
+
+namespace internal
+{
+struct PropertySlotData
+{
+   uint32_t m_offset = 0;
+   zend_class_entry *m_scope = nullptr;
+};
+} // internal
+
+/**
+ * Handle of a declared instance property, taken from Class<T>::getPropertySlot()
+ * at registration and resolved to the property offset when the class is
+ * initialized. The offset is shared by the subclasses, so the handle works
+ * for every object of the class. Keep it in a static and pass it to
+ * StdClass::slot() to reach the property storage without a name lookup.
+ */
+class ZAPI_DECL_EXPORT PropertySlot final
+{
+public:
+   PropertySlot() = default;
+
+   bool isResolved() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_data && m_data->m_scope;
+   }
+
+   uint32_t getOffset() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_data->m_offset;
+   }
+
+   zend_class_entry *getScope() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_data ? m_data->m_scope : nullptr;
+   }
+private:
+   explicit PropertySlot(std::shared_ptr<internal::PropertySlotData> data)
+      : m_data(std::move(data))
+   {}
+private:
+   std::shared_ptr<internal::PropertySlotData> m_data;
+   friend class zapi::vm::AbstractClass;
+};
+
+/**
+ * Typed view of one property slot of an object, valid as long as the
+ * object is. A reference stored in the slot is followed on read and write.
+ * A null PropertyRef, returned by StdClass::slot() for a slot not matching
+ * the object, reads as null and ignores writes.
+ */
+class ZAPI_DECL_EXPORT PropertyRef final
+{
+public:
+   PropertyRef()
+      : m_value(nullptr)
+   {}
+
+   explicit PropertyRef(zval *value)
+      : m_value(value)
+   {}
+
+   bool isNull() const ZAPI_DECL_NOEXCEPT
+   {
+      return !m_value;
+   }
+
+   template <typename T>
+   T get() const
+   {
+      return zapi::ds::from_zval<T>(m_value ? m_value : &EG(uninitialized_zval));
+   }
+
+   template <typename T>
+   bool get(T &target) const
+   {
+      return m_value && zapi::ds::from_zval(m_value, target);
+   }
+
+   template <typename T>
+   PropertyRef &set(T &&value)
+   {
+      if (!m_value) {
+         return *this;
+      }
+      zval temp;
+      zapi::ds::to_zval(std::forward<T>(value), &temp);
+      assign(&temp);
+      return *this;
+   }
+
+   Variant getValue() const;
+
+   zval *getZvalPtr() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_value;
+   }
+private:
+   // takes over value
+   void assign(zval *value);
+private:
+   zval *m_value;
+};
+
+} // lang
+} // zapi
+
+#endif // ZAPI_LANG_PROPERTY_SLOT_H
@@ -22,6 +22,7 @@
 #include "zapi/Global.h"
 #include "zapi/ds/Variant.h"
 #include "zapi/ds/ObjectVariant.h"
+#include "zapi/lang/PropertySlot.h"
 
 namespace zapi
 {
@@ -35,10 +36,12 @@ class ArrayVariant;
 namespace vm
 {
 class ObjectBinder;
+class GcVisitor;
 } // vm
 
 namespace lang
 {
+class MethodRef;
 namespace internal
 {
 class StdClassPrivate;
@@ -58,6 +61,7 @@ using zapi::ds::Variant;
 using zapi::ds::ArrayVariant;
 using zapi::ds::ObjectVariant;
 using zapi::vm::ObjectBinder;
+using zapi::vm::GcVisitor;
 class Parameters;
 
 class ZAPI_DECL_EXPORT StdClass
@@ -109,6 +113,29 @@ public:
     */
    Variant property(const std::string &name) const;
    
+   /**
+    * Access a declared property through its resolved slot, no name lookup
+    * is involved. A slot not resolved yet or belonging to an unrelated
+    * class raises a warning and gives a null PropertyRef
+    * @param  slot   handle from Class<T>::getPropertySlot()
+    * @return PropertyRef
+    */
+   PropertyRef slot(const PropertySlot &slot) const;
+   
+   /**
+    * Drop the computed value of a lazy property, it is computed again on
+    * the next read. Other names raise a warning and are ignored
+    * @param  name
+    */
+   void invalidateProperty(const std::string &name);
+   
+   /**
+    * Drop the value of a declared property through its resolved slot, a
+    * slot not matching the object raises a warning and is ignored
+    * @param  slot
+    */
+   void invalidateProperty(const PropertySlot &slot);
+   
    /**
     * Overridable method that is called right before an object is destructed
     */
@@ -239,6 +266,17 @@ public:
    int __compare(const StdClass &object) const;
    
    ArrayVariant __debugInfo() const;
+   
+   /**
+    * Report the Variant members to the cycle collector
+    *
+    * Override it in the classes that keep PHP values, the cycles through
+    * those values are collected then. The default implementation reports
+    * nothing and the class gets a get_gc handler that skips the call
+    *
+    * @param visitor
+    */
+   void gcVisit(GcVisitor &visitor) const;
 protected:
    ObjectVariant *getObjectZvalPtr() const;
    ObjectVariant *getObjectZvalPtr();
@@ -246,12 +284,18 @@ protected:
    Variant callParent(const char *name, Args&&... args);
    template <typename ...Args>
    Variant callParent(const char *name, Args&&... args) const;
+   // resolves the parent method once per class, keep the MethodRef in a static
+   template <typename ...Args>
+   Variant callParent(const MethodRef &method, Args&&... args);
+   template <typename ...Args>
+   Variant callParent(const MethodRef &method, Args&&... args) const;
    template <typename ...Args>
    Variant call(const char *name, Args&&... args);
    template <typename ...Args>
    Variant call(const char *name, Args&&... args) const;
 private:
    zval *doCallParent(const char *name, const int argc, Variant *argv, zval *retval) const;
+   zval *doCallParent(const MethodRef &method, const int argc, Variant *argv, zval *retval) const;
 protected:
    ZAPI_DECLARE_PRIVATE(StdClass)
    friend class Variant;// for Variant(const StdClass &stdClass);
@@ -278,6 +322,24 @@ Variant StdClass::callParent(const char *name, Args&&... args)
    return const_cast<const StdClass &>(*this).callParent(name, std::forward<Args>(args)...);
 }
 
+template <typename ...Args>
+Variant StdClass::callParent(const MethodRef &method, Args&&... args) const
+{
+   Variant vargs[] = { Variant(std::forward<Args>(args))... };
+   zval retval;
+   std::memset(&retval, 0, sizeof(retval));
+   doCallParent(method, sizeof...(Args), vargs, &retval);
+   Variant resultVarint(retval);
+   zval_dtor(&retval);
+   return resultVarint;
+}
+
+template <typename ...Args>
+Variant StdClass::callParent(const MethodRef &method, Args&&... args)
+{
+   return const_cast<const StdClass &>(*this).callParent(method, std::forward<Args>(args)...);
+}
+
 template <typename ...Args>
 Variant StdClass::call(const char *name, Args&&... args) const
 {
@@ -0,0 +1,52 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_PROTOCOL_BINARY_SERIALIZABLE_H
+#define ZAPI_PROTOCOL_BINARY_SERIALIZABLE_H
+
+#include "zapi/Global.h"
+
+namespace zapi
+{
+
+namespace ds
+{
+class BinaryWriter;
+class BinaryReader;
+} // ds
+
+namespace protocol
+{
+
+/**
+ * Hook of the native objects for the binary format of zapi::ds::BinaryWriter.
+ * writeBinary() writes any number of values with writer.writeValue(),
+ * readBinary() reads them back in the same order on a freshly created
+ * object. The values left unread are skipped, return false to reject the
+ * payload.
+ */
+class ZAPI_DECL_EXPORT BinarySerializable
+{
+public:
+   virtual void writeBinary(zapi::ds::BinaryWriter &writer) const = 0;
+   virtual bool readBinary(zapi::ds::BinaryReader &reader) = 0;
+   virtual ~BinarySerializable()
+   {}
+};
+
+} // protocol
+} // zapi
+
+#endif // ZAPI_PROTOCOL_BINARY_SERIALIZABLE_H
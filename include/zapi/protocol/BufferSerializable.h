@@ -0,0 +1,47 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_PROTOCOL_BUFFER_SERIALIZABLE_H
+#define ZAPI_PROTOCOL_BUFFER_SERIALIZABLE_H
+
+#include "zapi/Global.h"
+#include "php/ext/standard/php_smart_string.h"
+
+namespace zapi
+{
+namespace protocol
+{
+
+/**
+ * serialize() without intermediate strings. serializeTo() appends to the
+ * buffer handed to serialize(), which passes it on to the engine as is.
+ * unserializeFrom() reads the payload in place, return false to reject it.
+ *
+ * Since PHP 7.4 the class gets __serialize() and __unserialize() as well,
+ * the payload travels as the only element of the array.
+ */
+class ZAPI_DECL_EXPORT BufferSerializable
+{
+public:
+   virtual void serializeTo(smart_string &buffer) = 0;
+   virtual bool unserializeFrom(const char *input, size_t length) = 0;
+   virtual ~BufferSerializable()
+   {}
+};
+
+} // protocol
+} // zapi
+
+#endif // ZAPI_PROTOCOL_BUFFER_SERIALIZABLE_H
@@ -0,0 +1,50 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_PROTOCOL_FAST_ITERATOR_H
+#define ZAPI_PROTOCOL_FAST_ITERATOR_H
+
+#include "zapi/protocol/AbstractIterator.h"
+
+namespace zapi
+{
+namespace protocol
+{
+
+/**
+ * Iterator that hands its values to foreach without boxing them in Variant.
+ *
+ * currentValue() returns a zval owned by the iterator, the engine copies it,
+ * so it only has to stay valid until the iterator moves. Return nullptr to
+ * end the loop. currentKey() writes the key into the empty slot of the
+ * engine and must always set it. current() and key() are implemented on top
+ * of them for the C++ callers.
+ */
+class ZAPI_DECL_EXPORT FastIterator : public AbstractIterator
+{
+public:
+   FastIterator(StdClass *nativeObject);
+   virtual ~FastIterator();
+   
+   virtual zval *currentValue() = 0;
+   virtual void currentKey(zval *key) = 0;
+   virtual Variant current();
+   virtual Variant key();
+};
+
+} // protocol
+} // zapi
+
+#endif // ZAPI_PROTOCOL_FAST_ITERATOR_H
@@ -17,6 +17,7 @@
 #define ZAPI_UTILS_COMMON_FUNCS_H
 
 #include "zapi/Global.h"
+#include <functional>
 
 namespace zapi
 {
@@ -46,11 +47,35 @@ ZAPI_DECL_EXPORT std::string &str_tolower(std::string &str) ZAPI_DECL_NOEXCEPT;
 ZAPI_DECL_EXPORT std::string get_zval_type_str(const zval *valuePtr) ZAPI_DECL_NOEXCEPT;
 ZAPI_DECL_EXPORT bool zval_type_is_valid(const zval *valuePtr) ZAPI_DECL_NOEXCEPT;
 
+/**
+ * The key functors compare variants as array keys, the same conversions as
+ * the engine does on array offsets: integer like strings, bool, double and
+ * resource are integer keys, null is the empty string key. Strings are
+ * compared binary safe.
+ *
+ * VariantKeyLess puts the integer keys before the string keys, the hash of
+ * an integer key is the index self and the hash of a string key is the
+ * cached hash of the zend_string, the same as Bucket::h. Arrays and objects
+ * are not valid keys, they are compared with ===.
+ *
+ * The functors are passed explicitly, the std equality of Variant is not
+ * changed, e.g. std::unordered_map<Variant, T, VariantKeyHash, VariantKeyEqual>
+ */
 struct ZAPI_DECL_EXPORT VariantKeyLess
 {
    bool operator ()(const zapi::ds::Variant &lhs, const zapi::ds::Variant &rhs) const;
 };
 
+struct ZAPI_DECL_EXPORT VariantKeyHash
+{
+   size_t operator ()(const zapi::ds::Variant &value) const;
+};
+
+struct ZAPI_DECL_EXPORT VariantKeyEqual
+{
+   bool operator ()(const zapi::ds::Variant &lhs, const zapi::ds::Variant &rhs) const;
+};
+
 } // utils
 } // zapi
 
@@ -16,6 +16,7 @@
 #ifndef ZAPI_UTILS_INTERNAL_FUNCS_H
 #define ZAPI_UTILS_INTERNAL_FUNCS_H
 
+#include "zapi/Global.h"
 #include <list>
 #include <string>
 
@@ -26,6 +27,13 @@ namespace internal
 
 bool parse_namespaces(const std::string &ns, std::list<std::string> &parts);
 
+// persistent string shared by all the threads and never refcounted, only
+// call it outside of a request. Under ZAPI_ZTS_NO_INTERNING every call
+// returns a new string that free_permanent_string() releases, otherwise
+// the string belongs to the interned table and that is a no-op.
+zend_string *new_permanent_string(const char *str, size_t length);
+void free_permanent_string(zend_string *str);
+
 } // internal
 } // zapi
 
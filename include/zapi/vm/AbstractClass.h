@@ -18,6 +18,7 @@
 
 #include "zapi/Global.h"
 #include "zapi/lang/Argument.h"
+#include "php/ext/standard/php_smart_string_public.h"
 
 // forward declare with namespace
 namespace zapi
@@ -35,6 +36,7 @@ class StdClass;
 class Constant;
 class Interface;
 class Parameters;
+class PropertySlot;
 
 namespace internal
 {
@@ -46,6 +48,8 @@ class NamespacePrivate;
 namespace vm
 {
 class Closure;
+class AbstractFieldBinding;
+class GcVisitor;
 namespace internal
 {
 class AbstractClassPrivate;
@@ -68,6 +72,7 @@ using zapi::lang::Arguments;
 using zapi::lang::Constant;
 using zapi::lang::Interface;
 using zapi::lang::Parameters;
+using zapi::lang::PropertySlot;
 using zapi::ds::Variant;
 using zapi::ds::ArrayVariant;
 using zapi::lang::internal::ExtensionPrivate;
@@ -106,6 +111,10 @@ protected:
    void registerProperty(const char *name, const zapi::GetterMethodCallable0 &getter, const zapi::SetterMethodCallable1 &setter);
    void registerProperty(const char *name, const zapi::GetterMethodCallable1 &getter, const zapi::SetterMethodCallable0 &setter);
    void registerProperty(const char *name, const zapi::GetterMethodCallable1 &getter, const zapi::SetterMethodCallable1 &setter);
+   void registerFieldBinding(const char *name, std::shared_ptr<AbstractFieldBinding> binding);
+   void registerLazyProperty(const char *name, const zapi::GetterMethodCallable0 &compute);
+   void registerLazyProperty(const char *name, const zapi::GetterMethodCallable1 &compute);
+   PropertySlot getPropertySlot(const char *name);
    
    void registerConstant(const Constant &constant);
    
@@ -116,9 +125,11 @@ protected:
 protected:
    virtual StdClass *construct() const;
    virtual StdClass *clone(StdClass *orig) const;
+   virtual void destroy(StdClass *nativeObject) const;
    virtual bool clonable() const;
    virtual bool serializable() const;
    virtual bool traversable() const;
+   virtual bool gcVisitable() const;
    virtual int callCompare(StdClass *left, StdClass *right) const;
    virtual void callClone(StdClass *nativeObject) const;
    virtual void callDestruct(StdClass *nativeObject) const;
@@ -126,6 +137,9 @@ protected:
    virtual Variant callMagicStaticCall(const char *name, Parameters &params) const;
    virtual Variant callMagicInvoke(StdClass *nativeObject, Parameters &params) const;
    virtual ArrayVariant callDebugInfo(StdClass *nativeObject) const;
+   virtual void callSerialize(StdClass *nativeObject, smart_string &buffer) const;
+   virtual bool callUnserialize(StdClass *nativeObject, const char *input, size_t length) const;
+   virtual void callGcVisit(StdClass *nativeObject, GcVisitor &visitor) const;
    // property
    virtual Variant callGet(StdClass *nativeObject, const std::string &name) const;
    virtual void callSet(StdClass *nativeObject, const std::string &name, const Variant &value) const;
@@ -53,19 +53,37 @@ using zapi::lang::Parameters;
 using zapi::stdext::is_function_pointer;
 using ClosureCallableType = std::function<Variant(Parameters &)>;
 
+/**
+ * Native closure object, PHP calls it through one zend_internal_function
+ * installed at MINIT. A small functor is kept in the std::function buffer
+ * inside the native object, so creating a closure costs the native object
+ * and the zend object only.
+ */
 class Closure final : public zapi::lang::StdClass
 {
 public:
    Closure(const ClosureCallableType &callable);
+   Closure(ClosureCallableType &&callable);
    Variant __invoke(Parameters &params) const;
    virtual ~Closure();
    static zend_class_entry *getClassEntry();
+   // writes a new closure object into target without releasing its old value
+   static void create(zval *target, ClosureCallableType callable);
+   // class entry comparison, references are followed
+   static bool isClosure(const zval *value);
+   // calls the functor of a closure object without going through the engine,
+   // an exception leaves it as an OrigException like from call_user_function
+   static Variant call(zval *object, zval *arguments, uint32_t argc);
 private:
    static void registerToZendNg(int moduleNumber);
    static void unregisterFromZendNg();
+   static void invoke(INTERNAL_FUNCTION_PARAMETERS);
+   static int getClosure(zval *object, zend_class_entry **entry, zend_function **retFunc,
+                         zend_object **objectPtr);
 private:
    friend class ExtensionPrivate;
    static zend_class_entry *m_entry;
+   static zend_internal_function sm_invokeFunc;
    const ClosureCallableType m_callable;
 };
 
@@ -0,0 +1,83 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_VM_FIELD_BINDING_H
+#define ZAPI_VM_FIELD_BINDING_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/VariantTraits.h"
+#include <string>
+
+// forward declare with namespace
+namespace zapi
+{
+namespace lang
+{
+class StdClass;
+} // lang
+} // zapi
+// end forward declare
+
+namespace zapi
+{
+namespace vm
+{
+
+using zapi::lang::StdClass;
+
+/**
+ * Binding of a declared property to a data member of the native object.
+ * The property handlers find the binding by the property slot and move the
+ * value between the member and the zval directly.
+ */
+class ZAPI_DECL_EXPORT AbstractFieldBinding
+{
+public:
+   // rv is overwritten without being released
+   virtual void read(StdClass *nativeObject, zval *rv) const = 0;
+   // false when the value can't be converted to the type of the member
+   virtual bool write(StdClass *nativeObject, const zval *value) const = 0;
+   virtual ~AbstractFieldBinding()
+   {}
+};
+
+template <typename T, typename FieldType>
+class FieldBinding final : public AbstractFieldBinding
+{
+   static_assert((std::is_arithmetic<FieldType>::value || std::is_same<FieldType, std::string>::value) &&
+                 !std::is_const<FieldType>::value,
+                 "only non const scalar and std::string members can be bound to a property");
+public:
+   explicit FieldBinding(FieldType T::*field)
+      : m_field(field)
+   {}
+
+   virtual void read(StdClass *nativeObject, zval *rv) const override
+   {
+      zapi::ds::VariantTraits<FieldType>::toZval(static_cast<T *>(nativeObject)->*m_field, rv);
+   }
+
+   virtual bool write(StdClass *nativeObject, const zval *value) const override
+   {
+      return zapi::ds::VariantTraits<FieldType>::fromZval(value, static_cast<T *>(nativeObject)->*m_field);
+   }
+private:
+   FieldType T::*m_field;
+};
+
+} // vm
+} // zapi
+
+#endif // ZAPI_VM_FIELD_BINDING_H
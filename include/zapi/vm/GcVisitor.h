@@ -0,0 +1,89 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_VM_GC_VISITOR_H
+#define ZAPI_VM_GC_VISITOR_H
+
+#include "zapi/Global.h"
+#include "zapi/ds/Variant.h"
+
+namespace zapi
+{
+namespace vm
+{
+
+namespace internal
+{
+class AbstractClassPrivate;
+} // internal
+
+using zapi::ds::Variant;
+
+/**
+ * Collects the zvals a native object holds for the cycle collector, pass
+ * every Variant member to visit() from StdClass::gcVisit(). Only the
+ * refcounted values are kept. The values are gathered in a buffer owned
+ * by the object and reused by the following runs of the collector.
+ */
+class ZAPI_DECL_EXPORT GcVisitor final
+{
+public:
+   GcVisitor(const GcVisitor &other) = delete;
+   GcVisitor &operator =(const GcVisitor &other) = delete;
+
+   GcVisitor &visit(const Variant &value)
+   {
+      return visit(value.getUnDerefZvalPtr());
+   }
+
+   GcVisitor &visit(const zval *value)
+   {
+      if (Z_REFCOUNTED_P(value)) {
+         append(value);
+      }
+      return *this;
+   }
+
+   template <typename Iterator>
+   GcVisitor &visit(Iterator first, Iterator last)
+   {
+      for (; first != last; ++first) {
+         visit(*first);
+      }
+      return *this;
+   }
+
+   uint32_t getCount() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_count;
+   }
+private:
+   GcVisitor(zval *&buffer, uint32_t &capacity)
+      : m_buffer(buffer),
+        m_capacity(capacity),
+        m_count(0)
+   {}
+   void append(const zval *value);
+private:
+   zval *&m_buffer;
+   uint32_t &m_capacity;
+   uint32_t m_count;
+   friend class internal::AbstractClassPrivate;
+};
+
+} // vm
+} // zapi
+
+#endif // ZAPI_VM_GC_VISITOR_H
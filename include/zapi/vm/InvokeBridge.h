@@ -22,6 +22,7 @@
 #include "zapi/lang/Parameters.h"
 #include "zapi/lang/Argument.h"
 #include "zapi/ds/Variant.h"
+#include "zapi/ds/VariantTraits.h"
 #include "zapi/vm/InvokeBridge.h"
 #include "zapi/vm/ObjectBinder.h"
 #include "zapi/stdext/TypeTraits.h"
@@ -72,6 +73,15 @@ void yield(_zval_struct *return_value, std::nullptr_t value)
    RETVAL_NULL();
 }
 
+// the types with VariantTraits are written without an intermediate Variant
+template <typename T,
+          typename std::enable_if<zapi::ds::has_variant_traits<T>::value &&
+                                  !std::is_base_of<Variant, typename std::decay<T>::type>::value, int>::type = 0>
+void yield(_zval_struct *return_value, T &&value)
+{
+   zapi::ds::to_zval(std::forward<T>(value), return_value);
+}
+
 StdClass *instance(zend_execute_data *execute_data)
 {
    return ObjectBinder::retrieveSelfPtr(getThis())->getNativeObject();
@@ -114,16 +124,40 @@ public:
       if (!zapi::utils::zval_type_is_valid(arg)) {
          ZVAL_NULL(arg);
       }
+      return convert<ClassType>(arg, std::is_base_of<Variant, ClassType>());
+   }
+
+private:
+   template <typename ClassType>
+   static ClassType convert(zval *arg, std::true_type)
+   {
       if (Z_TYPE_P(arg) == IS_REFERENCE) {
          return ClassType(arg, true);
       }
       return ClassType(arg);
    }
 
-private:
+   template <typename ClassType>
+   static ClassType convert(zval *arg, std::false_type)
+   {
+      return zapi::ds::VariantTraits<typename std::remove_cv<ClassType>::type>::fromZval(arg);
+   }
+
    zval *m_arguments;
 };
 
+// the missing trailing arguments of a direct call are passed as null
+void fill_direct_arguments(zval *arguments, size_t paramNumber, int argc, Variant *argv)
+{
+   for (size_t i = 0; i < paramNumber; ++i) {
+      if (i < static_cast<size_t>(argc)) {
+         ZVAL_COPY_VALUE(&arguments[i], argv[i].getUnDerefZvalPtr());
+      } else {
+         ZVAL_NULL(&arguments[i]);
+      }
+   }
+}
+
 }
 
 namespace zapi
@@ -131,6 +165,16 @@ namespace zapi
 namespace vm
 {
 
+/**
+ * Calls a native member function for C++ callers without pushing a VM
+ * frame, returns false when the call must go through the engine
+ */
+using DirectInvokeCallable = bool (*)(StdClass *nativeObject, const zend_function *func,
+                                      int argc, Variant *argv, zval *retval);
+
+ZAPI_DECL_EXPORT void register_direct_invoke(ZendCallable handler, DirectInvokeCallable direct);
+ZAPI_DECL_EXPORT DirectInvokeCallable find_direct_invoke(ZendCallable handler);
+
 template <typename CallableType, CallableType callable, 
           bool isMemberFunc, bool HasReturn, bool HasVariableParam>
 class InvokeBridgePrivate
@@ -269,6 +313,28 @@ template <typename CallableType, CallableType callable>
 class InvokeBridgePrivate <CallableType, callable, true, false, false>
 {
 public:
+   static bool directInvoke(StdClass *nativeObject, const zend_function *func,
+                            int argc, Variant *argv, zval *retval)
+   {
+      constexpr size_t paramNumber = zapi::stdext::CallableInfoTrait<CallableType>::argNum;
+      if (paramNumber > func->common.num_args) {
+         return false;
+      }
+      try {
+         using ClassType = typename std::decay<typename zapi::stdext::member_pointer_traits<CallableType>::ClassType>::type;
+         zval arguments[paramNumber + 1];
+         fill_direct_arguments(arguments, paramNumber, argc, argv);
+         InvokeParamGenerator generator(arguments);
+         auto objectTuple = std::make_tuple(static_cast<ClassType *>(nativeObject));
+         auto tuple = std::tuple_cat(objectTuple, zapi::stdext::gen_tuple_with_type<paramNumber, CallableType>(generator));
+         zapi::stdext::apply(callable, tuple);
+         yield(retval, nullptr);
+      } catch (Exception &exception) {
+         zapi::kernel::process_exception(exception);
+      }
+      return true;
+   }
+
    static void invoke(zend_execute_data *execute_data, zval *return_value)
    {
       try {
@@ -340,6 +406,27 @@ template <typename CallableType, CallableType callable>
 class InvokeBridgePrivate <CallableType, callable, true, true, false>
 {
 public:
+   static bool directInvoke(StdClass *nativeObject, const zend_function *func,
+                            int argc, Variant *argv, zval *retval)
+   {
+      constexpr size_t paramNumber = zapi::stdext::CallableInfoTrait<CallableType>::argNum;
+      if (paramNumber > func->common.num_args) {
+         return false;
+      }
+      try {
+         using ClassType = typename std::decay<typename zapi::stdext::member_pointer_traits<CallableType>::ClassType>::type;
+         zval arguments[paramNumber + 1];
+         fill_direct_arguments(arguments, paramNumber, argc, argv);
+         InvokeParamGenerator generator(arguments);
+         auto objectTuple = std::make_tuple(static_cast<ClassType *>(nativeObject));
+         auto tuple = std::tuple_cat(objectTuple, zapi::stdext::gen_tuple_with_type<paramNumber, CallableType>(generator));
+         yield(retval, zapi::stdext::apply(callable, tuple));
+      } catch (Exception &exception) {
+         zapi::kernel::process_exception(exception);
+      }
+      return true;
+   }
+
    static void invoke(zend_execute_data *execute_data, zval *return_value)
    {
       try {
@@ -415,6 +502,25 @@ class InvokeBridge : public InvokeBridgePrivate<DecayCallableType, callable,
       zapi::stdext::CallableInfoTrait<DecayCallableType>::hasVaridicParams>
 {};
 
+// only the member functions with fixed parameters have a directInvoke
+template <typename BridgeType, typename = void>
+struct DirectInvokeOf
+{
+   static DirectInvokeCallable get()
+   {
+      return nullptr;
+   }
+};
+
+template <typename BridgeType>
+struct DirectInvokeOf<BridgeType, decltype(void(&BridgeType::directInvoke))>
+{
+   static DirectInvokeCallable get()
+   {
+      return &BridgeType::directInvoke;
+   }
+};
+
 } // vm
 } // zapi
 
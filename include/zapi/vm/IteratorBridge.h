@@ -26,6 +26,7 @@ namespace zapi
 namespace protocol
 {
 class AbstractIterator;
+class FastIterator;
 } // protocol
 
 } // zapi
@@ -37,6 +38,7 @@ namespace vm
 {
 
 using zapi::protocol::AbstractIterator;
+using zapi::protocol::FastIterator;
 using zapi::ds::Variant;
 
 class IteratorBridge
@@ -68,6 +70,29 @@ private:
    Variant m_current;
 };
 
+/**
+ * Bridge for FastIterator, the values go from the native iterator to the
+ * engine slots directly. The block is emalloc'ed and filled in place, the
+ * engine frees it after destructor() released the object.
+ */
+class FastIteratorBridge final
+{
+public:
+   static zend_object_iterator *create(zval *object, FastIterator *iterator);
+   static zend_object_iterator_funcs *getIteratorFuncs();
+private:
+   static FastIterator *getNativeIterator(zend_object_iterator *iterator);
+   static void destructor(zend_object_iterator *iterator);
+   static int valid(zend_object_iterator *iterator);
+   static zval *current(zend_object_iterator *iterator);
+   static void key(zend_object_iterator *iterator, zval *data);
+   static void next(zend_object_iterator *iterator);
+   static void rewind(zend_object_iterator *iterator);
+private:
+   zend_object_iterator m_iterator;
+   FastIterator *m_nativeIterator;
+};
+
 } // vm
 } // zapi
 
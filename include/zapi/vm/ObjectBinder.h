@@ -29,6 +29,11 @@ class StdClass;
 namespace vm
 {
 
+namespace internal
+{
+class AbstractClassPrivate;
+} // internal
+
 using zapi::lang::StdClass;
 class ObjectBinder
 {
@@ -53,6 +58,14 @@ private:
       zend_object m_zendObject;
    } *m_container;
    std::shared_ptr<StdClass> m_nativeObject;
+   // reused by the get_gc handler between the collector runs
+   zval *m_gcBuffer = nullptr;
+   uint32_t m_gcCapacity = 0;
+   // the values last copied into the bound property slots, a slot that no
+   // longer holds its value was written through the property table
+   zval *m_boundShadow = nullptr;
+   uint32_t m_boundShadowCount = 0;
+   friend class internal::AbstractClassPrivate;
 };
 
 } // vm
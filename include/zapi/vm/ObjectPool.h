@@ -0,0 +1,115 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_VM_OBJECT_POOL_H
+#define ZAPI_VM_OBJECT_POOL_H
+
+#include "zapi/Global.h"
+
+namespace zapi
+{
+namespace vm
+{
+
+/**
+ * Free list recycling the storage of the native objects of one class.
+ *
+ * The storage comes from emalloc, a destroyed object goes back to the list
+ * as long as it holds less than the capacity. The list lives for one
+ * request: it is drained at RSHUTDOWN and the objects freed after that
+ * return their storage to the engine directly. A capacity of 0 disables
+ * the pool.
+ *
+ * Whether the objects of the class are allocated through the pool at all is
+ * decided by the first of them and kept for the process, so every object is
+ * released the way it was allocated. A pool disabled later still releases
+ * its objects to the engine, it just keeps none of them. Under ZTS the pool
+ * stays disabled, the free list can't hold the blocks of several threads.
+ */
+class ZAPI_DECL_EXPORT ObjectPool final
+{
+public:
+   struct Stats
+   {
+      // allocations served from the free list
+      uint64_t hits = 0;
+      // allocations that went to emalloc
+      uint64_t misses = 0;
+      // objects alive now and the most alive at once
+      size_t live = 0;
+      size_t highWater = 0;
+      // blocks waiting on the free list
+      size_t pooled = 0;
+   };
+public:
+   explicit ObjectPool(size_t objectSize);
+   ObjectPool(const ObjectPool &other) = delete;
+   ObjectPool &operator =(const ObjectPool &other) = delete;
+   ~ObjectPool();
+
+   void setCapacity(size_t capacity) ZAPI_DECL_NOEXCEPT;
+
+   size_t getCapacity() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_capacity;
+   }
+
+   bool isEnabled() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_capacity > 0;
+   }
+
+   // true when the objects go through allocate() and release(), the
+   // first call fixes the answer
+   bool routesObjects() ZAPI_DECL_NOEXCEPT
+   {
+      if (!m_routingFixed) {
+         m_routingFixed = true;
+         m_routed = isEnabled();
+      }
+      return m_routed;
+   }
+
+   const Stats &getStats() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_stats;
+   }
+
+   void *allocate();
+   void release(void *storage);
+   // frees the blocks on the list, the statistics are kept
+   void drain();
+   void resetStats() ZAPI_DECL_NOEXCEPT;
+
+   static void activateAll();
+   static void drainAll();
+private:
+   struct FreeBlock
+   {
+      FreeBlock *next;
+   };
+   size_t m_objectSize;
+   size_t m_capacity;
+   bool m_active;
+   bool m_routingFixed;
+   bool m_routed;
+   FreeBlock *m_freeList;
+   Stats m_stats;
+};
+
+} // vm
+} // zapi
+
+#endif // ZAPI_VM_OBJECT_POOL_H
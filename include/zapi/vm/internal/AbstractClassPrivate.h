@@ -20,6 +20,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <vector>
 
 // forware declare with namespace
 namespace zapi
@@ -34,6 +35,10 @@ namespace lang
 class Method;
 class Interface;
 class StdClass;
+namespace internal
+{
+struct PropertySlotData;
+} // internal
 } // lang
 
 namespace vm
@@ -41,6 +46,8 @@ namespace vm
 class AbstractMember;
 class AbstractClass;
 class Property;
+class AbstractFieldBinding;
+class ObjectBinder;
 } // vm
 
 } // zapi
@@ -69,6 +76,8 @@ using zapi::lang::Modifier;
 using zapi::lang::ClassType;
 using zapi::ds::Variant;
 using zapi::vm::Property;
+using zapi::vm::AbstractFieldBinding;
+using zapi::lang::internal::PropertySlotData;
 
 class AbstractClassPrivate
 {
@@ -94,12 +103,29 @@ public:
    static int serialize(zval *object, unsigned char **buffer, size_t *bufLength, zend_serialize_data *data);
    static int unserialize(zval *object, zend_class_entry *entry, const unsigned char *buffer,
                           size_t bufLength, zend_unserialize_data *data);
+#if PHP_VERSION_ID >= 70400
+   static void serializeMethod(zend_execute_data *execute_data, zval *return_value);
+   static void unserializeMethod(zend_execute_data *execute_data, zval *return_value);
+#endif
    static HashTable *debugInfo(zval *object, int *isTemp);
    // property
    static zval *readProperty(zval *object, zval *name, int type, void **cacheSlot, zval *returnValue);
    static void writeProperty(zval *object, zval *name, zval *value, void **cacheSlot);
    static int hasProperty(zval *object, zval *name, int hasSetExists, void **cacheSlot);
    static void unsetProperty(zval *object, zval *name, void **cacheSlot);
+   static zval *getPropertyPtrPtr(zval *object, zval *name, int type, void **cacheSlot);
+   static HashTable *getProperties(zval *object);
+   static HashTable *getGc(zval *object, zval **table, int *count);
+   static HashTable *getPropertiesGc(zval *object, zval **table, int *count);
+   AbstractFieldBinding *findFieldBinding(zend_class_entry *entry, zval *name, void **cacheSlot);
+   // write the slots changed through the property table back to the members,
+   // publish copies the members into all the bound slots as well
+   static void syncBoundSlots(ObjectBinder *binder, bool publish);
+   void resolvePropertySlot(const std::string &name, PropertySlotData &slot);
+   bool isLazyProperty(zval *name) const;
+   static bool isLazyProperty(zend_class_entry *entry, const std::string &name);
+   // the slot of a lazy property computed if unset, nullptr for other names
+   zval *findLazyProperty(zval *object, zval *name, void **cacheSlot);
    // method call
    static zend_function *getMethod(zend_object **object, zend_string *method, const zval *key);
    static zend_function *getStaticMethod(zend_class_entry *entry, zend_string *methodName);
@@ -125,6 +151,12 @@ public:
    std::list<std::shared_ptr<Method>> m_methods;
    std::list<std::shared_ptr<AbstractMember>> m_members;
    std::map<std::string, std::shared_ptr<Property>> m_properties;
+   std::map<std::string, std::shared_ptr<AbstractFieldBinding>> m_fieldBindings;
+   // field bindings indexed by property slot, the slots of the parent classes included
+   std::vector<AbstractFieldBinding *> m_slotBindings;
+   std::map<std::string, std::shared_ptr<PropertySlotData>> m_propertySlots;
+   // computed on the first read and kept in the property slot
+   std::map<std::string, std::shared_ptr<Property>> m_lazyProperties;
    std::shared_ptr<AbstractClass> m_parent;
    bool m_intialized = false;
    std::unique_ptr<zend_string, std::function<void(zend_string *)>> m_self = nullptr;
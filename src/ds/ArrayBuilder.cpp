@@ -0,0 +1,71 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/ds/ArrayBuilder.h"
+#include "zapi/ds/ArrayVariant.h"
+
+namespace zapi
+{
+namespace ds
+{
+
+namespace
+{
+
+zend_array *new_builder_array(uint32_t capacity, bool packed)
+{
+   zend_array *array = static_cast<zend_array *>(emalloc(sizeof(zend_array)));
+   zend_hash_init(array, capacity, nullptr, ZVAL_PTR_DTOR, 0);
+   if (capacity > 0) {
+      zend_hash_real_init(array, packed);
+   }
+   return array;
+}
+
+} // anonymous namespace
+
+ArrayBuilder::ArrayBuilder(SizeType capacity, bool packed)
+   : m_array(new_builder_array(capacity, packed))
+{}
+
+ArrayBuilder::~ArrayBuilder()
+{
+   if (m_array) {
+      zend_array_destroy(m_array);
+   }
+}
+
+void ArrayBuilder::allocate()
+{
+   m_array = new_builder_array(0, false);
+}
+
+ArrayVariant ArrayBuilder::build()
+{
+   zval result;
+   if (m_array) {
+      ZVAL_ARR(&result, m_array);
+      m_array = nullptr;
+   } else {
+      array_init(&result);
+   }
+   ArrayVariant array(&result);
+   // the variant hold its own reference now
+   zval_ptr_dtor(&result);
+   return array;
+}
+
+} // ds
+} // zapi
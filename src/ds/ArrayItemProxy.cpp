@@ -31,21 +31,27 @@ namespace ds
 {
 
 using zapi::ds::internal::ArrayItemProxyPrivate;
+using zapi::ds::internal::print_key_not_exist_notice;
 using KeyType = zapi::ds::ArrayItemProxy::KeyType;
 
-namespace 
+namespace internal
 {
 
-void print_key_not_exist_notice(const KeyType &key)
+// same wording as the engine, index for string keys and offset for integer keys
+void print_key_not_exist_notice(const ArrayKey &key)
 {
-   if (key.second) {
-      std::string *keyStr = key.second.get();
-      zapi::notice << "Undefined offset: " << *keyStr << std::endl;
+   if (key.isString()) {
+      zapi::notice << "Undefined index: " << key << std::endl;
    } else {
-      zapi::notice << "Undefined index: " << key.first << std::endl;
+      zapi::notice << "Undefined offset: " << key << std::endl;
    }
 }
 
+} // internal
+
+namespace 
+{
+
 void print_type_not_compatible_info(const zval *valPtr)
 {
    switch (Z_TYPE_P(valPtr)) {
@@ -91,6 +97,10 @@ ArrayItemProxy::ArrayItemProxy(zval *array, zapi_ulong index, ArrayItemProxy *pa
    : m_implPtr(new ArrayItemProxyPrivate(array, index, this, parent))
 {}
 
+ArrayItemProxy::ArrayItemProxy(zval *array, const ArrayKey &key, ArrayItemProxy *parent)
+   : m_implPtr(new ArrayItemProxyPrivate(array, key, this, parent))
+{}
+
 ArrayItemProxy::~ArrayItemProxy()
 {}
 
@@ -130,11 +140,11 @@ ArrayItemProxy &ArrayItemProxy::operator =(const Variant &value)
    ZVAL_COPY(&temp, from);
    zend_array *target = Z_ARRVAL_P(m_implPtr->m_array);
    zval *inserted = nullptr;
-   if (m_implPtr->m_requestKey.second) {
-      std::string *key = m_implPtr->m_requestKey.second.get();
-      inserted = zend_hash_str_update(target, key->c_str(), key->length(), &temp);
+   const ArrayKey &requestKey = m_implPtr->m_requestKey;
+   if (requestKey.isString()) {
+      inserted = zend_hash_update(target, requestKey.getZendString(), &temp);
    } else {
-      inserted = zend_hash_index_update(target, m_implPtr->m_requestKey.first, &temp);
+      inserted = zend_hash_index_update(target, requestKey.getIndex(), &temp);
    }
    // @TODO here we need check the inserted ?
    return *this;
@@ -328,7 +338,14 @@ ArrayItemProxy ArrayItemProxy::operator [](const std::string &key)
    return ArrayItemProxy(nullptr, key, this);
 }
 
-bool ArrayItemProxy::ensureArrayExistRecusive(zval *&childArrayPtr,const KeyType &childRequestKey,
+ArrayItemProxy ArrayItemProxy::operator [](const ArrayKey &key)
+{
+   m_implPtr->m_needCheckRequestItem = false;
+   // let most derived proxy object do check
+   return ArrayItemProxy(nullptr, key, this);
+}
+
+bool ArrayItemProxy::ensureArrayExistRecusive(zval *&childArrayPtr, const ArrayKey &childRequestKey,
                                               ArrayItemProxy *mostDerivedProxy)
 {
    // if a ArrayItemProxyPrivate both m_parent and m_array is 
@@ -342,19 +359,18 @@ bool ArrayItemProxy::ensureArrayExistRecusive(zval *&childArrayPtr,const KeyType
    if (this != mostDerivedProxy) {
       // here we don't need check exist in destroy process
       m_implPtr->m_needCheckRequestItem = false;
-      const KeyType &requestKey = m_implPtr->m_requestKey;
+      const ArrayKey &requestKey = m_implPtr->m_requestKey;
       // at this point m_array must be exist
       // when m_parent is nullptr the m_array is top array self
       zval *val = retrieveZvalPtr(true);
       if (nullptr == val) {
          zval temp;
          array_init(&temp);
-         if (requestKey.second) {
-            std::string *keyStr = requestKey.second.get();
+         if (requestKey.isString()) {
             // @TODO here we need check status ?
-            childArrayPtr = zend_hash_str_add(Z_ARR_P(m_implPtr->m_array), keyStr->c_str(), keyStr->length(), &temp);
+            childArrayPtr = zend_hash_add(Z_ARR_P(m_implPtr->m_array), requestKey.getZendString(), &temp);
          } else {
-            childArrayPtr = zend_hash_index_add(Z_ARR_P(m_implPtr->m_array), requestKey.first, &temp);
+            childArrayPtr = zend_hash_index_add(Z_ARR_P(m_implPtr->m_array), requestKey.getIndex(), &temp);
          }
       } else {
          // if request key exists and check type compatible
@@ -426,17 +442,14 @@ bool ArrayItemProxy::isKeychianOk(bool quiet)
 zval *ArrayItemProxy::retrieveZvalPtr(bool quiet) const
 {
    zval *valPtr = nullptr;
-   if (m_implPtr->m_requestKey.second) {
-      std::string *key = m_implPtr->m_requestKey.second.get();
-      valPtr = zend_hash_str_find(Z_ARRVAL_P(m_implPtr->m_array), key->c_str(), key->length());
-      if (nullptr == valPtr && !quiet) {
-         zapi::notice << "Undefined offset: " << *key << std::endl;
-      }
+   const ArrayKey &requestKey = m_implPtr->m_requestKey;
+   if (requestKey.isString()) {
+      valPtr = zend_hash_find(Z_ARRVAL_P(m_implPtr->m_array), requestKey.getZendString());
    } else {
-      valPtr = zend_hash_index_find(Z_ARRVAL_P(m_implPtr->m_array), m_implPtr->m_requestKey.first);
-      if (nullptr == valPtr && !quiet) {
-         zapi::notice << "Undefined index: " << m_implPtr->m_requestKey.first << std::endl;
-      }
+      valPtr = zend_hash_index_find(Z_ARRVAL_P(m_implPtr->m_array), requestKey.getIndex());
+   }
+   if (nullptr == valPtr && !quiet) {
+      print_key_not_exist_notice(requestKey);
    }
    return valPtr;
 }
@@ -0,0 +1,146 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/ds/ArrayKey.h"
+#include "zapi/utils/InternalFuncs.h"
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+namespace zapi
+{
+namespace ds
+{
+
+ArrayKey::ArrayKey(zapi_ulong index) ZAPI_DECL_NOEXCEPT
+   : m_key(nullptr),
+     m_hash(index)
+{}
+
+ArrayKey::ArrayKey(const std::string &key, bool interned)
+{
+   initStringKey(key.c_str(), key.length(), interned);
+}
+
+ArrayKey::ArrayKey(const char *key)
+{
+   initStringKey(key, std::strlen(key), true);
+}
+
+ArrayKey::ArrayKey(const char *key, size_t length, bool interned)
+{
+   initStringKey(key, length, interned);
+}
+
+ArrayKey::ArrayKey(zend_string *key)
+   : m_key(zend_string_copy(key)),
+     m_hash(zend_string_hash_val(key))
+{}
+
+ArrayKey::ArrayKey(const ArrayKey &other) ZAPI_DECL_NOEXCEPT
+   : m_key(other.m_key),
+     m_hash(other.m_hash)
+{
+   if (m_key) {
+      zend_string_addref(m_key);
+   }
+}
+
+ArrayKey::ArrayKey(ArrayKey &&other) ZAPI_DECL_NOEXCEPT
+   : m_key(other.m_key),
+     m_hash(other.m_hash)
+{
+   other.m_key = nullptr;
+}
+
+ArrayKey::~ArrayKey()
+{
+   if (m_key) {
+      zend_string_release(m_key);
+   }
+}
+
+ArrayKey &ArrayKey::operator =(const ArrayKey &other) ZAPI_DECL_NOEXCEPT
+{
+   if (this != &other) {
+      if (other.m_key) {
+         zend_string_addref(other.m_key);
+      }
+      if (m_key) {
+         zend_string_release(m_key);
+      }
+      m_key = other.m_key;
+      m_hash = other.m_hash;
+   }
+   return *this;
+}
+
+ArrayKey &ArrayKey::operator =(ArrayKey &&other) ZAPI_DECL_NOEXCEPT
+{
+   assert(this != &other);
+   std::swap(m_key, other.m_key);
+   std::swap(m_hash, other.m_hash);
+   return *this;
+}
+
+bool ArrayKey::operator ==(const ArrayKey &other) const ZAPI_DECL_NOEXCEPT
+{
+   if (m_hash != other.m_hash || isIndex() != other.isIndex()) {
+      return false;
+   }
+   return isIndex() || m_key == other.m_key || zend_string_equal_content(m_key, other.m_key);
+}
+
+bool ArrayKey::operator !=(const ArrayKey &other) const ZAPI_DECL_NOEXCEPT
+{
+   return !operator ==(other);
+}
+
+std::string ArrayKey::toString() const
+{
+   if (isIndex()) {
+      return std::to_string(m_hash);
+   }
+   return std::string(ZSTR_VAL(m_key), ZSTR_LEN(m_key));
+}
+
+void ArrayKey::initStringKey(const char *key, size_t length, bool interned)
+{
+   // keys that created outside of request (MINIT) must survive the
+   // memory manager reset, so we allocate them in persistent memory
+   if (interned && !EG(active)) {
+      // shared by all threads, flagged as interned even where ZTS
+      // doesn't intern, so that no thread refcounts it
+      m_key = zapi::internal::new_permanent_string(key, length);
+   } else {
+      zend_string *str = zend_string_init(key, length, !EG(active));
+      m_key = interned ? zend_new_interned_string(str) : str;
+   }
+   m_hash = zend_string_hash_val(m_key);
+}
+
+std::ostream &operator<<(std::ostream &stream, const ArrayKey &key)
+{
+   if (key.isIndex()) {
+      stream << key.getIndex();
+   } else {
+      zend_string *str = key.getZendString();
+      stream.write(ZSTR_VAL(str), ZSTR_LEN(str));
+   }
+   return stream;
+}
+
+} // ds
+} // zapi
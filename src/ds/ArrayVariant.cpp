@@ -15,9 +15,16 @@
 
 #include "zapi/ds/ArrayVariant.h"
 #include "zapi/ds/ArrayItemProxy.h"
+#include "zapi/ds/ArrayBuilder.h"
 #include "zapi/ds/internal/VariantPrivate.h"
+#include "zapi/ds/internal/ArrayItemProxyPrivate.h"
+#include "zapi/ds/ZvalHashSet.h"
+#include "php/Zend/zend_sort.h"
 #include <iostream>
 #include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
 
 #if ZEND_DEBUG
 
@@ -79,6 +86,190 @@ int hash_zval_identical_function(const void *z1, const void *z2)
    return Z_TYPE(result) != IS_TRUE;
 }
 
+// arrays smaller than this use comparison sort
+const uint32_t RADIX_SORT_THRESHOLD = 256;
+const uint64_t RADIX_SIGN_BIT = static_cast<uint64_t>(1) << 63;
+
+// buckets are already in order when we call zend_hash_sort_ex, we just
+// want the engine do the renumber and rehash work for us
+void noop_bucket_sort(void *, size_t, size_t, compare_func_t, swap_func_t)
+{}
+
+void bucket_swap(void *lhs, void *rhs)
+{
+   std::swap(*static_cast<Bucket *>(lhs), *static_cast<Bucket *>(rhs));
+}
+
+// the original position of bucket is saved in Z_NEXT by prepareSort,
+// use it to break the tie, so the result of sorting is stable
+int bucket_ordinal_compare(const Bucket *lhs, const Bucket *rhs)
+{
+   return Z_NEXT(lhs->val) < Z_NEXT(rhs->val) ? -1 : (Z_NEXT(lhs->val) > Z_NEXT(rhs->val) ? 1 : 0);
+}
+
+int compare_zval(zval *lhs, zval *rhs)
+{
+   ZVAL_DEREF(lhs);
+   ZVAL_DEREF(rhs);
+   if (Z_TYPE_P(lhs) == IS_LONG && Z_TYPE_P(rhs) == IS_LONG) {
+      return Z_LVAL_P(lhs) < Z_LVAL_P(rhs) ? -1 : (Z_LVAL_P(lhs) > Z_LVAL_P(rhs) ? 1 : 0);
+   }
+   if (Z_TYPE_P(lhs) == IS_DOUBLE && Z_TYPE_P(rhs) == IS_DOUBLE) {
+      return ZEND_NORMALIZE_BOOL(Z_DVAL_P(lhs) - Z_DVAL_P(rhs));
+   }
+   zval result;
+   if (compare_function(&result, lhs, rhs) == FAILURE) {
+      return 0;
+   }
+   return ZEND_NORMALIZE_BOOL(Z_LVAL(result));
+}
+
+int bucket_value_compare(const void *lhs, const void *rhs)
+{
+   const Bucket *lhsBucket = static_cast<const Bucket *>(lhs);
+   const Bucket *rhsBucket = static_cast<const Bucket *>(rhs);
+   int result = compare_zval(const_cast<zval *>(&lhsBucket->val), 
+                             const_cast<zval *>(&rhsBucket->val));
+   return result != 0 ? result : bucket_ordinal_compare(lhsBucket, rhsBucket);
+}
+
+int bucket_key_compare(const void *lhs, const void *rhs)
+{
+   const Bucket *lhsBucket = static_cast<const Bucket *>(lhs);
+   const Bucket *rhsBucket = static_cast<const Bucket *>(rhs);
+   zval lhsKey;
+   zval rhsKey;
+   if (lhsBucket->key) {
+      ZVAL_STR(&lhsKey, lhsBucket->key);
+   } else {
+      ZVAL_LONG(&lhsKey, lhsBucket->h);
+   }
+   if (rhsBucket->key) {
+      ZVAL_STR(&rhsKey, rhsBucket->key);
+   } else {
+      ZVAL_LONG(&rhsKey, rhsBucket->h);
+   }
+   int result = compare_zval(&lhsKey, &rhsKey);
+   return result != 0 ? result : bucket_ordinal_compare(lhsBucket, rhsBucket);
+}
+
+bool radix_sort_packed(Bucket *first, uint32_t count)
+{
+   zend_uchar type = Z_TYPE(first->val);
+   if (type != IS_LONG && type != IS_DOUBLE) {
+      return false;
+   }
+   std::vector<uint64_t> keys(count);
+   for (uint32_t i = 0; i < count; ++i) {
+      zval *value = &first[i].val;
+      if (Z_TYPE_P(value) != type) {
+         return false;
+      }
+      if (type == IS_LONG) {
+         keys[i] = static_cast<uint64_t>(static_cast<int64_t>(Z_LVAL_P(value))) ^ RADIX_SIGN_BIT;
+      } else {
+         double dvalue = Z_DVAL_P(value);
+         if (zend_isnan(dvalue)) {
+            return false;
+         }
+         uint64_t bits;
+         std::memcpy(&bits, &dvalue, sizeof(bits));
+         keys[i] = (bits & RADIX_SIGN_BIT) ? ~bits : bits ^ RADIX_SIGN_BIT;
+      }
+   }
+   // least significant digit first, one byte per pass, all histograms are
+   // collected in one scan and the passes that all keys share one digit are skipped
+   std::vector<uint32_t> histogram(8 * 256, 0);
+   for (uint32_t i = 0; i < count; ++i) {
+      uint64_t key = keys[i];
+      for (int pass = 0; pass < 8; ++pass) {
+         ++histogram[pass * 256 + ((key >> (pass * 8)) & 0xff)];
+      }
+   }
+   std::vector<uint64_t> buffer(count);
+   uint64_t *src = keys.data();
+   uint64_t *dest = buffer.data();
+   for (int pass = 0; pass < 8; ++pass) {
+      uint32_t *digits = histogram.data() + pass * 256;
+      if (digits[(src[0] >> (pass * 8)) & 0xff] == count) {
+         continue;
+      }
+      uint32_t offset = 0;
+      for (int digit = 0; digit < 256; ++digit) {
+         uint32_t digitCount = digits[digit];
+         digits[digit] = offset;
+         offset += digitCount;
+      }
+      for (uint32_t i = 0; i < count; ++i) {
+         uint64_t key = src[i];
+         dest[digits[(key >> (pass * 8)) & 0xff]++] = key;
+      }
+      std::swap(src, dest);
+   }
+   for (uint32_t i = 0; i < count; ++i) {
+      uint64_t key = src[i];
+      zval *value = &first[i].val;
+      if (type == IS_LONG) {
+         ZVAL_LONG(value, static_cast<zapi_long>(static_cast<int64_t>(key ^ RADIX_SIGN_BIT)));
+      } else {
+         uint64_t bits = (key & RADIX_SIGN_BIT) ? key ^ RADIX_SIGN_BIT : ~key;
+         double dvalue;
+         std::memcpy(&dvalue, &bits, sizeof(dvalue));
+         ZVAL_DOUBLE(value, dvalue);
+      }
+   }
+   return true;
+}
+
+zval *fetch_column(zval *row, const zapi::ds::ArrayKey &column)
+{
+   ZVAL_DEREF(row);
+   if (Z_TYPE_P(row) != IS_ARRAY) {
+      return nullptr;
+   }
+   zval *value = column.isString() 
+         ? zend_hash_find(Z_ARRVAL_P(row), column.getZendString())
+         : zend_hash_index_find(Z_ARRVAL_P(row), column.getIndex());
+   return value;
+}
+
+bool is_packed_array(const zend_array *array)
+{
+   return array->u.flags & HASH_FLAG_PACKED;
+}
+
+// the same as array_column(), numeric strings are integer keys, the rows
+// with a key of the other types are appended
+void update_by_column_key(zapi::ds::ArrayBuilder &builder, zval *key, zval *value)
+{
+   ZVAL_DEREF(key);
+   if (Z_TYPE_P(key) == IS_STRING) {
+      zend_ulong index;
+      if (ZEND_HANDLE_NUMERIC_STR(Z_STRVAL_P(key), Z_STRLEN_P(key), index)) {
+         builder.update(index, nullptr, value);
+      } else {
+         builder.update(0, Z_STR_P(key), value);
+      }
+   } else if (Z_TYPE_P(key) == IS_LONG) {
+      builder.update(Z_LVAL_P(key), nullptr, value);
+   } else {
+      builder.append(value);
+   }
+}
+
+void merge_array(zapi::ds::ArrayBuilder &builder, zend_array *source)
+{
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_STR_KEY_VAL_IND(source, key, value) {
+      if (key) {
+         builder.update(0, key, value);
+      } else {
+         builder.append(value);
+      }
+   } ZEND_HASH_FOREACH_END();
+}
+
 }
 
 namespace zapi
@@ -92,6 +283,12 @@ using zapi::ds::internal::VariantPrivate;
 using ArrayIterator = ArrayVariant::Iterator;
 using ConstArrayIterator = ArrayVariant::ConstIterator;
 
+namespace
+{
+ZAPI_THREAD_LOCAL uint64_t separation_count = 0;
+ZAPI_THREAD_LOCAL ArrayVariant::MutationScope::SeparationHandler separation_handler = nullptr;
+} // anonymous namespace
+
 ArrayVariant::ArrayVariant()
 {
    // constructor empty array
@@ -191,10 +388,15 @@ ArrayVariant::ArrayVariant(const std::initializer_list<std::pair<Variant, Varian
       if (type != Type::Long && type != Type::String) {
          continue;
       }
+      const zval *key = item.first.getZvalPtr();
+      zend_ulong index;
       if (type == Type::Long) {
-         insert(Z_LVAL_P(item.first.getZvalPtr()), item.second);
+         insert(Z_LVAL_P(key), item.second);
+      } else if (ZEND_HANDLE_NUMERIC_STR(Z_STRVAL_P(key), Z_STRLEN_P(key), index)) {
+         // "1" and 1 are the same key in the map
+         insert(index, item.second);
       } else {
-         insert(Z_STRVAL_P(item.first.getZvalPtr()), item.second);
+         insert(std::string(Z_STRVAL_P(key), Z_STRLEN_P(key)), item.second);
       }
    }
 }
@@ -207,10 +409,15 @@ ArrayVariant::ArrayVariant(const std::map<Variant, Variant, zapi::utils::Variant
       if (type != Type::Long && type != Type::String) {
          continue;
       }
+      const zval *key = item.first.getZvalPtr();
+      zend_ulong index;
       if (type == Type::Long) {
-         insert(Z_LVAL_P(item.first.getZvalPtr()), item.second);
+         insert(Z_LVAL_P(key), item.second);
+      } else if (ZEND_HANDLE_NUMERIC_STR(Z_STRVAL_P(key), Z_STRLEN_P(key), index)) {
+         // "1" and 1 are the same key in the map
+         insert(index, item.second);
       } else {
-         insert(Z_STRVAL_P(item.first.getZvalPtr()), item.second);
+         insert(std::string(Z_STRVAL_P(key), Z_STRLEN_P(key)), item.second);
       }
    }
 }
@@ -238,6 +445,11 @@ ArrayItemProxy ArrayVariant::operator [](const char *key)
    return ArrayItemProxy(getZvalPtr(), key);
 }
 
+ArrayItemProxy ArrayVariant::operator [](const ArrayKey &key)
+{
+   return ArrayItemProxy(getZvalPtr(), key);
+}
+
 bool ArrayVariant::operator ==(const ArrayVariant &other) const
 {
    return this == &other ? true 
@@ -372,6 +584,47 @@ ArrayIterator ArrayVariant::insert(const std::string &key, Variant &&value)
    }
 }
 
+ArrayIterator ArrayVariant::insert(const ArrayKey &key, const Variant &value)
+{
+   if (getUnDerefType() != Type::Reference) {
+      SEPARATE_ZVAL_NOREF(getUnDerefZvalPtr());
+   }
+   zval *zvalPtr = const_cast<zval *>(value.getZvalPtr());
+   zval temp;
+   ZVAL_COPY(&temp, zvalPtr);
+   zend_array *selfArrPtr = getZendArrayPtr();
+   zval *valPtr = key.isString() 
+         ? zend_hash_update(selfArrPtr, key.getZendString(), &temp)
+         : zend_hash_index_update(selfArrPtr, key.getIndex(), &temp);
+   if (valPtr) {
+      HashPosition pos = calculateIdxFromZval(valPtr);
+      return ArrayIterator(selfArrPtr, &pos);
+   } else {
+      return ArrayIterator(selfArrPtr, nullptr);
+   }
+}
+
+ArrayIterator ArrayVariant::insert(const ArrayKey &key, Variant &&value)
+{
+   if (getUnDerefType() != Type::Reference) {
+      SEPARATE_ZVAL_NOREF(getUnDerefZvalPtr());
+   }
+   zval *zvalPtr = value.getZvalPtr();
+   zval temp;
+   ZVAL_COPY_VALUE(&temp, zvalPtr);
+   std::memset(&value.m_implPtr->m_buffer, 0, sizeof(value.m_implPtr->m_buffer));
+   zend_array *selfArrPtr = getZendArrayPtr();
+   zval *valPtr = key.isString() 
+         ? zend_hash_update(selfArrPtr, key.getZendString(), &temp)
+         : zend_hash_index_update(selfArrPtr, key.getIndex(), &temp);
+   if (valPtr) {
+      HashPosition pos = calculateIdxFromZval(valPtr);
+      return ArrayIterator(selfArrPtr, &pos);
+   } else {
+      return ArrayIterator(selfArrPtr, nullptr);
+   }
+}
+
 ArrayIterator ArrayVariant::append(const Variant &value)
 {
    if (getUnDerefType() != Type::Reference) {
@@ -409,6 +662,40 @@ ArrayIterator ArrayVariant::append(Variant &&value)
    }
 }
 
+ArrayIterator ArrayVariant::insertZval(const ArrayKey &key, zval *value)
+{
+   if (getUnDerefType() != Type::Reference) {
+      SEPARATE_ZVAL_NOREF(getUnDerefZvalPtr());
+   }
+   zend_array *selfArrPtr = getZendArrayPtr();
+   zval *valPtr = key.isString()
+         ? zend_hash_update(selfArrPtr, key.getZendString(), value)
+         : zend_hash_index_update(selfArrPtr, key.getIndex(), value);
+   if (valPtr) {
+      HashPosition pos = calculateIdxFromZval(valPtr);
+      return ArrayIterator(selfArrPtr, &pos);
+   } else {
+      zval_ptr_dtor(value);
+      return ArrayIterator(selfArrPtr, nullptr);
+   }
+}
+
+ArrayIterator ArrayVariant::appendZval(zval *value)
+{
+   if (getUnDerefType() != Type::Reference) {
+      SEPARATE_ZVAL_NOREF(getUnDerefZvalPtr());
+   }
+   zend_array *selfArrPtr = getZendArrayPtr();
+   zval *valPtr = zend_hash_next_index_insert(selfArrPtr, value);
+   if (valPtr) {
+      HashPosition pos = calculateIdxFromZval(valPtr);
+      return ArrayIterator(selfArrPtr, &pos);
+   } else {
+      zval_ptr_dtor(value);
+      return ArrayIterator(selfArrPtr, nullptr);
+   }
+}
+
 void ArrayVariant::clear() ZAPI_DECL_NOEXCEPT
 {
    if (getUnDerefType() != Type::Reference) {
@@ -433,6 +720,17 @@ bool ArrayVariant::remove(const std::string &key) ZAPI_DECL_NOEXCEPT
    return zend_hash_str_del(getZendArrayPtr(), key.c_str(), key.length()) == ZAPI_SUCCESS;
 }
 
+bool ArrayVariant::remove(const ArrayKey &key) ZAPI_DECL_NOEXCEPT
+{
+   if (getUnDerefType() != Type::Reference) {
+      SEPARATE_ZVAL_NOREF(getUnDerefZvalPtr());
+   }
+   if (key.isString()) {
+      return zend_hash_del(getZendArrayPtr(), key.getZendString()) == ZAPI_SUCCESS;
+   }
+   return zend_hash_index_del(getZendArrayPtr(), key.getIndex()) == ZAPI_SUCCESS;
+}
+
 ArrayVariant::Iterator ArrayVariant::erase(ConstIterator &iter)
 {
    if (getUnDerefType() != Type::Reference) {
@@ -484,6 +782,16 @@ Variant ArrayVariant::take(zapi_ulong index)
    return ret;
 }
 
+Variant ArrayVariant::take(const ArrayKey &key)
+{
+   Iterator iter = find(key);
+   Variant ret(iter.getValue());
+   if (iter != end()) {
+      remove(key);
+   }
+   return ret;
+}
+
 bool ArrayVariant::isEmpty() const ZAPI_DECL_NOEXCEPT
 {
    return 0 == getSize();
@@ -528,6 +836,20 @@ Variant ArrayVariant::getValue(const std::string &key) const
    return val;
 }
 
+Variant ArrayVariant::getValue(const ArrayKey &key) const
+{
+   uint32_t idx = findArrayIdx(key);
+   if (HT_INVALID_IDX == idx) {
+      internal::print_key_not_exist_notice(key);
+      return nullptr;
+   }
+   zval *value = &getZendArrayPtr()->arData[idx].val;
+   if (Z_TYPE_P(value) == IS_INDIRECT) {
+      value = Z_INDIRECT_P(value);
+   }
+   return value;
+}
+
 bool ArrayVariant::contains(zapi_ulong index) const
 {
    return zend_hash_index_exists(getZendArrayPtr(), index) == 1;
@@ -538,6 +860,11 @@ bool ArrayVariant::contains(const std::string &key) const
    return zend_hash_str_exists(getZendArrayPtr(), key.c_str(), key.length()) == 1;
 }
 
+bool ArrayVariant::contains(const ArrayKey &key) const
+{
+   return findArrayIdx(key) != HT_INVALID_IDX;
+}
+
 zapi_long ArrayVariant::getNextInsertIndex() const
 {
    return getZendArrayPtr()->nNextFreeElement;
@@ -623,6 +950,11 @@ ArrayIterator ArrayVariant::find(const std::string &key)
    return static_cast<ArrayIterator>(static_cast<const ArrayVariant>(*this).find(key));
 }
 
+ArrayIterator ArrayVariant::find(const ArrayKey &key)
+{
+   return static_cast<ArrayIterator>(static_cast<const ArrayVariant &>(*this).find(key));
+}
+
 ConstArrayIterator ArrayVariant::find(zapi_ulong index) const
 {
    zend_array *array = getZendArrayPtr();
@@ -657,6 +989,17 @@ ConstArrayIterator ArrayVariant::find(const std::string &key) const
    return ConstArrayIterator(array, &idx);
 }
 
+ConstArrayIterator ArrayVariant::find(const ArrayKey &key) const
+{
+   zend_array *array = getZendArrayPtr();
+   IS_CONSISTENT(array);
+   uint32_t idx = findArrayIdx(key);
+   if (idx == HT_INVALID_IDX) {
+      return end();
+   }
+   return ConstArrayIterator(array, &idx);
+}
+
 void ArrayVariant::map(Visitor visitor) const ZAPI_DECL_NOEXCEPT
 {
    zapi_ulong index;
@@ -675,6 +1018,188 @@ void ArrayVariant::map(Visitor visitor) const ZAPI_DECL_NOEXCEPT
    } ZEND_HASH_FOREACH_END();
 }
 
+void ArrayVariant::sort(bool renumber)
+{
+   SizeType count;
+   Bucket *first = prepareSort(count);
+   if (first) {
+      // homogeneous integer and float list has a radix sort path
+      if (!renumber || !(getZendArrayPtr()->u.flags & HASH_FLAG_PACKED) ||
+          count < RADIX_SORT_THRESHOLD || !radix_sort_packed(first, count)) {
+         zend_sort(first, count, sizeof(Bucket), bucket_value_compare, bucket_swap);
+      }
+   }
+   finishSort(renumber);
+}
+
+void ArrayVariant::sortByKey()
+{
+   SizeType count;
+   Bucket *first = prepareSort(count);
+   if (first) {
+      zend_sort(first, count, sizeof(Bucket), bucket_key_compare, bucket_swap);
+   }
+   finishSort(false);
+}
+
+void ArrayVariant::sortByColumn(const ArrayKey &column, bool renumber)
+{
+   SizeType count;
+   Bucket *first = prepareSort(count);
+   if (first) {
+      // the engine comparison of mixed types is not a strict weak ordering,
+      // merge sort is safe with it, the introsort of std::sort is not
+      std::stable_sort(first, first + count, [&column](const Bucket &lhs, const Bucket &rhs) -> bool {
+         zval nullValue;
+         ZVAL_NULL(&nullValue);
+         zval *lhsValue = fetch_column(const_cast<zval *>(&lhs.val), column);
+         zval *rhsValue = fetch_column(const_cast<zval *>(&rhs.val), column);
+         return compare_zval(lhsValue ? lhsValue : &nullValue, rhsValue ? rhsValue : &nullValue) < 0;
+      });
+   }
+   finishSort(renumber);
+}
+
+void ArrayVariant::partialSort(SizeType count, bool renumber)
+{
+   SizeType total;
+   Bucket *first = prepareSort(total);
+   if (first) {
+      std::partial_sort(first, first + std::min(count, total), first + total, 
+                        [](const Bucket &lhs, const Bucket &rhs) -> bool {
+         return bucket_value_compare(&lhs, &rhs) < 0;
+      });
+   }
+   finishSort(renumber);
+}
+
+ArrayVariant ArrayVariant::intersectKey(const ArrayVariant &other) const
+{
+   return filterByKey({other}, true);
+}
+
+ArrayVariant ArrayVariant::intersectKey(ArrayRefList others) const
+{
+   return filterByKey(others, true);
+}
+
+ArrayVariant ArrayVariant::diffKey(const ArrayVariant &other) const
+{
+   return filterByKey({other}, false);
+}
+
+ArrayVariant ArrayVariant::diffKey(ArrayRefList others) const
+{
+   return filterByKey(others, false);
+}
+
+ArrayVariant ArrayVariant::intersect(const ArrayVariant &other, bool strict) const
+{
+   return filterByValue({other}, true, strict);
+}
+
+ArrayVariant ArrayVariant::intersect(ArrayRefList others, bool strict) const
+{
+   return filterByValue(others, true, strict);
+}
+
+ArrayVariant ArrayVariant::diff(const ArrayVariant &other, bool strict) const
+{
+   return filterByValue({other}, false, strict);
+}
+
+ArrayVariant ArrayVariant::diff(ArrayRefList others, bool strict) const
+{
+   return filterByValue(others, false, strict);
+}
+
+ArrayVariant ArrayVariant::unique(bool strict) const
+{
+   zend_array *self = getZendArrayPtr();
+   SizeType size = zend_hash_num_elements(self);
+   internal::ZvalHashSet seen(size, strict);
+   ArrayBuilder builder(size, is_packed_array(self));
+   zapi_ulong index;
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(self, index, key, value) {
+      if (seen.insert(value)) {
+         builder.add(index, key, value);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
+ArrayVariant ArrayVariant::merge(const ArrayVariant &other) const
+{
+   return merge({other});
+}
+
+ArrayVariant ArrayVariant::merge(ArrayRefList others) const
+{
+   zend_array *self = getZendArrayPtr();
+   SizeType capacity = zend_hash_num_elements(self);
+   bool packed = is_packed_array(self);
+   for (const ArrayVariant &other : others) {
+      capacity += zend_hash_num_elements(other.getZendArrayPtr());
+      packed = packed && is_packed_array(other.getZendArrayPtr());
+   }
+   ArrayBuilder builder(capacity, packed);
+   merge_array(builder, self);
+   for (const ArrayVariant &other : others) {
+      merge_array(builder, other.getZendArrayPtr());
+   }
+   return builder.build();
+}
+
+ArrayVariant ArrayVariant::indexBy(const ArrayKey &column) const
+{
+   zend_array *self = getZendArrayPtr();
+   ArrayBuilder builder(zend_hash_num_elements(self), false);
+   zval *row;
+   ZEND_HASH_FOREACH_VAL_IND(self, row) {
+      zval *key = fetch_column(row, column);
+      if (key) {
+         update_by_column_key(builder, key, row);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
+ArrayVariant ArrayVariant::column(const ArrayKey &column) const
+{
+   zend_array *self = getZendArrayPtr();
+   ArrayBuilder builder(zend_hash_num_elements(self));
+   zval *row;
+   ZEND_HASH_FOREACH_VAL_IND(self, row) {
+      zval *value = fetch_column(row, column);
+      if (value) {
+         builder.append(value);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
+ArrayVariant ArrayVariant::column(const ArrayKey &column, const ArrayKey &indexColumn) const
+{
+   zend_array *self = getZendArrayPtr();
+   ArrayBuilder builder(zend_hash_num_elements(self), false);
+   zval *row;
+   ZEND_HASH_FOREACH_VAL_IND(self, row) {
+      zval *value = fetch_column(row, column);
+      if (!value) {
+         continue;
+      }
+      zval *key = fetch_column(row, indexColumn);
+      if (key) {
+         update_by_column_key(builder, key, value);
+      } else {
+         builder.append(value);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
 ArrayIterator ArrayVariant::begin() ZAPI_DECL_NOEXCEPT
 {
    HashPosition pos = 0;
@@ -773,6 +1298,175 @@ uint32_t ArrayVariant::findArrayIdx(zapi_ulong index) const ZAPI_DECL_NOEXCEPT
    return HT_INVALID_IDX;
 }
 
+uint32_t ArrayVariant::findArrayIdx(const ArrayKey &key) const ZAPI_DECL_NOEXCEPT
+{
+   zend_array *ht = getZendArrayPtr();
+   zapi_ulong h = key.getHash();
+   if (key.isIndex()) {
+      if (ht->u.flags & HASH_FLAG_PACKED) {
+         if (h < ht->nNumUsed && Z_TYPE(ht->arData[h].val) != IS_UNDEF) {
+            return h;
+         }
+         return HT_INVALID_IDX;
+      }
+      return findArrayIdx(h);
+   }
+   // the hash value is already cached in key, so we just walk the
+   // collision chain, interned keys match by pointer at first
+   zend_string *keyStr = key.getZendString();
+   uint32_t nIndex;
+   uint32_t idx;
+   Bucket *p, *arData;
+   arData = ht->arData;
+   nIndex = h | ht->nTableMask;
+   idx = HT_HASH_EX(arData, nIndex);
+   while (idx != HT_INVALID_IDX) {
+      ZEND_ASSERT(idx < HT_IDX_TO_HASH(ht->nTableSize));
+      p = HT_HASH_TO_BUCKET_EX(arData, idx);
+      if (p->key == keyStr) {
+         return idx;
+      }
+      if (p->h == h && p->key && zend_string_equal_content(p->key, keyStr)) {
+         return idx;
+      }
+      idx = Z_NEXT(p->val);
+   }
+   return HT_INVALID_IDX;
+}
+
+Bucket *ArrayVariant::prepareSort(SizeType &count)
+{
+   if (getUnDerefType() != Type::Reference) {
+      SEPARATE_ZVAL_NOREF(getUnDerefZvalPtr());
+   }
+   zend_array *ht = getZendArrayPtr();
+   IS_CONSISTENT(ht);
+   count = zend_hash_num_elements(ht);
+   if (count <= 1) {
+      return nullptr;
+   }
+   // squeeze the holes out and remember the original position of every
+   // bucket, the hash chains are rebuilt by the engine in finishSort
+   uint32_t i = 0;
+   for (uint32_t j = 0; j < ht->nNumUsed; ++j) {
+      Bucket *p = ht->arData + j;
+      if (Z_TYPE(p->val) == IS_UNDEF) {
+         continue;
+      }
+      if (i != j) {
+         ht->arData[i] = *p;
+      }
+      Z_NEXT(ht->arData[i].val) = i;
+      ++i;
+   }
+   ht->nNumUsed = i;
+   return ht->arData;
+}
+
+void ArrayVariant::finishSort(bool renumber)
+{
+   zend_hash_sort_ex(getZendArrayPtr(), noop_bucket_sort, nullptr, renumber);
+}
+
+// keep the entry when its key exist in all others (keep is true) or
+// in none of them (keep is false), the hash tables of others do the lookup
+ArrayVariant ArrayVariant::filterByKey(ArrayRefList others, bool keep) const
+{
+   zend_array *self = getZendArrayPtr();
+   ArrayBuilder builder(zend_hash_num_elements(self), is_packed_array(self));
+   zapi_ulong index;
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(self, index, key, value) {
+      bool matched = true;
+      for (const ArrayVariant &other : others) {
+         zend_array *array = other.getZendArrayPtr();
+         bool exist = key ? zend_hash_exists(array, key) : zend_hash_index_exists(array, index);
+         if (exist != keep) {
+            matched = false;
+            break;
+         }
+      }
+      if (matched) {
+         builder.add(index, key, value);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
+// the same as filterByKey, but looks the values up in the temporary
+// value sets that are built from others
+ArrayVariant ArrayVariant::filterByValue(ArrayRefList others, bool keep, bool strict) const
+{
+   std::vector<std::unique_ptr<internal::ZvalHashSet>> sets;
+   sets.reserve(others.size());
+   for (const ArrayVariant &other : others) {
+      zend_array *array = other.getZendArrayPtr();
+      sets.emplace_back(new internal::ZvalHashSet(zend_hash_num_elements(array), strict));
+      internal::ZvalHashSet &set = *sets.back();
+      zval *value;
+      ZEND_HASH_FOREACH_VAL_IND(array, value) {
+         set.insert(value);
+      } ZEND_HASH_FOREACH_END();
+   }
+   zend_array *self = getZendArrayPtr();
+   ArrayBuilder builder(zend_hash_num_elements(self), is_packed_array(self));
+   zapi_ulong index;
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(self, index, key, value) {
+      bool matched = true;
+      for (const std::unique_ptr<internal::ZvalHashSet> &set : sets) {
+         if (set->contains(value) != keep) {
+            matched = false;
+            break;
+         }
+      }
+      if (matched) {
+         builder.add(index, key, value);
+      }
+   } ZEND_HASH_FOREACH_END();
+   return builder.build();
+}
+
+ArrayVariant::MutationScope::MutationScope(ArrayVariant &array)
+   : m_separated(false)
+{
+   // the array behind a reference is separated as well, the scope
+   // can't share the hash table with others
+   zval *self = array.getZvalPtr();
+   zend_array *source = Z_ARR_P(self);
+   SEPARATE_ARRAY(self);
+   m_array = Z_ARR_P(self);
+   if (m_array != source) {
+      m_separated = true;
+      ++separation_count;
+      if (separation_handler) {
+         separation_handler(source, m_array);
+      }
+   }
+}
+
+void ArrayVariant::MutationScope::reserve(SizeType size)
+{
+   zend_hash_extend(m_array, size, (m_array->u.flags & HASH_FLAG_PACKED) != 0);
+}
+
+uint64_t ArrayVariant::MutationScope::getSeparationCount() ZAPI_DECL_NOEXCEPT
+{
+   return separation_count;
+}
+
+void ArrayVariant::MutationScope::resetSeparationCount() ZAPI_DECL_NOEXCEPT
+{
+   separation_count = 0;
+}
+
+void ArrayVariant::MutationScope::setSeparationHandler(SeparationHandler handler) ZAPI_DECL_NOEXCEPT
+{
+   separation_handler = handler;
+}
+
 // iterator classes
 
 ArrayIterator::Iterator(_zend_array *array, HashPosition *pos)
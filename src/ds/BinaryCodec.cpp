@@ -0,0 +1,991 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/ds/BinaryCodec.h"
+#include "zapi/lang/StdClass.h"
+#include "zapi/vm/internal/AbstractClassPrivate.h"
+#include "zapi/vm/ObjectBinder.h"
+#include "zapi/protocol/BinarySerializable.h"
+#include "zapi/kernel/Exception.h"
+#include "php/Zend/zend_interfaces.h"
+#include <cstring>
+#include <cerrno>
+
+#ifdef ZAPI_OS_WIN
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace zapi
+{
+namespace ds
+{
+
+namespace
+{
+
+using zapi::protocol::BinarySerializable;
+using zapi::vm::ObjectBinder;
+using zapi::vm::internal::AbstractClassPrivate;
+using zapi::kernel::Exception;
+
+// document layout: 'Z' 'B' version value
+//
+// value := NULL | FALSE | TRUE
+//        | LONG zigzag-varint | DOUBLE 8 bytes little endian
+//        | STRING varint-length bytes | STRING_REF varint-index
+//        | LIST varint-count (value | LONG_RUN n longs | DOUBLE_RUN n doubles)*
+//        | MAP varint-count (key value)*, key := LONG | STRING | STRING_REF
+//        | OBJECT class-name varint-count (key value)*
+//        | NATIVE class-name value* END
+//        | OBJECT_REF varint-index
+//
+// the STRINGs of 2 to 128 bytes and the objects are numbered in the order
+// they appear, the numbering restarts with every document
+constexpr unsigned char FORMAT_VERSION = 1;
+
+enum Tag : unsigned char
+{
+   TagNull,
+   TagFalse,
+   TagTrue,
+   TagLong,
+   TagDouble,
+   TagString,
+   TagStringRef,
+   TagList,
+   TagMap,
+   TagObject,
+   TagNative,
+   TagObjectRef,
+   TagLongRun,
+   TagDoubleRun,
+   TagEnd
+};
+
+constexpr size_t MAX_SHARED_STRING_LENGTH = 128;
+constexpr uint32_t MIN_RUN_LENGTH = 4;
+constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+struct DepthGuard
+{
+   explicit DepthGuard(uint32_t &depth)
+      : m_depth(++depth)
+   {}
+
+   ~DepthGuard()
+   {
+      --m_depth;
+   }
+
+   uint32_t &m_depth;
+};
+
+bool is_list(zend_array *array)
+{
+   zend_ulong expected = 0;
+   zend_ulong index;
+   zend_string *key;
+   ZEND_HASH_FOREACH_KEY(array, index, key) {
+      if (key || index != expected) {
+         return false;
+      }
+      ++expected;
+   } ZEND_HASH_FOREACH_END();
+   return true;
+}
+
+BinarySerializable *binary_hook(zval *object)
+{
+   if (Z_OBJCE_P(object)->create_object != &AbstractClassPrivate::createObject) {
+      return nullptr;
+   }
+   return dynamic_cast<BinarySerializable *>(ObjectBinder::retrieveSelfPtr(object)->getNativeObject());
+}
+
+// the objects whose state is not in their properties, the classes
+// serialized by their own hooks or __sleep() and the internal classes
+// keeping native state without a zapi binder
+bool is_unsupported_class(zend_class_entry *entry)
+{
+   if (entry->serialize || entry->unserialize) {
+      return true;
+   }
+   if (zend_hash_str_exists(&entry->function_table, "__sleep", sizeof("__sleep") - 1)) {
+      return true;
+   }
+   return entry->create_object && entry->create_object != &AbstractClassPrivate::createObject;
+}
+
+uint64_t zigzag_encode(zend_long value)
+{
+   int64_t number = value;
+   return number < 0 ? (~static_cast<uint64_t>(number) << 1) | 1 : static_cast<uint64_t>(number) << 1;
+}
+
+int64_t zigzag_decode(uint64_t value)
+{
+   return (value & 1) ? ~static_cast<int64_t>(value >> 1) : static_cast<int64_t>(value >> 1);
+}
+
+} // anonymous namespace
+
+BinaryWriter::BinaryWriter()
+   : BinaryWriter(-1)
+{}
+
+BinaryWriter::BinaryWriter(int fd, uint32_t maxDepth)
+   : m_fd(fd),
+     m_flushed(0),
+     m_maxDepth(maxDepth),
+     m_depth(0),
+     m_error(Error::None)
+{
+   m_buffer.s = nullptr;
+   m_buffer.a = 0;
+   ALLOC_HASHTABLE(m_strings);
+   zend_hash_init(m_strings, 16, nullptr, nullptr, 0);
+   ALLOC_HASHTABLE(m_objects);
+   zend_hash_init(m_objects, 8, nullptr, nullptr, 0);
+}
+
+BinaryWriter::~BinaryWriter()
+{
+   resetTables();
+   zend_hash_destroy(m_strings);
+   FREE_HASHTABLE(m_strings);
+   zend_hash_destroy(m_objects);
+   FREE_HASHTABLE(m_objects);
+   flush();
+   smart_str_free(&m_buffer);
+}
+
+bool BinaryWriter::write(const Variant &value)
+{
+   m_error = Error::None;
+   m_depth = 0;
+   size_t length = getSize();
+   size_t flushed = m_flushed;
+   writeByte('Z');
+   writeByte('B');
+   writeByte(FORMAT_VERSION);
+   writeZval(const_cast<zval *>(value.getZvalPtr()));
+   resetTables();
+   if (m_error != Error::None) {
+      // the bytes already flushed can't be taken back
+      if (m_buffer.s) {
+         ZSTR_LEN(m_buffer.s) = flushed == m_flushed ? length : 0;
+      }
+      return false;
+   }
+   return flush();
+}
+
+void BinaryWriter::writeValue(const Variant &value)
+{
+   writeZval(const_cast<zval *>(value.getZvalPtr()));
+}
+
+bool BinaryWriter::flush()
+{
+   if (m_fd < 0 || !m_buffer.s || ZSTR_LEN(m_buffer.s) == 0) {
+      return true;
+   }
+   const char *data = ZSTR_VAL(m_buffer.s);
+   size_t remaining = ZSTR_LEN(m_buffer.s);
+   while (remaining > 0) {
+#ifdef ZAPI_OS_WIN
+      int written = ::_write(m_fd, data, static_cast<unsigned int>(remaining));
+#else
+      ssize_t written = ::write(m_fd, data, remaining);
+#endif
+      if (written < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         fail(Error::Io);
+         return false;
+      }
+      data += written;
+      remaining -= written;
+   }
+   m_flushed += ZSTR_LEN(m_buffer.s);
+   ZSTR_LEN(m_buffer.s) = 0;
+   return true;
+}
+
+const char *BinaryWriter::getData() const ZAPI_DECL_NOEXCEPT
+{
+   return m_buffer.s ? ZSTR_VAL(m_buffer.s) : "";
+}
+
+size_t BinaryWriter::getSize() const ZAPI_DECL_NOEXCEPT
+{
+   return m_buffer.s ? ZSTR_LEN(m_buffer.s) : 0;
+}
+
+Variant BinaryWriter::detach()
+{
+   zval bytes;
+   if (m_buffer.s) {
+      smart_str_0(&m_buffer);
+      ZVAL_NEW_STR(&bytes, m_buffer.s);
+      m_buffer.s = nullptr;
+      m_buffer.a = 0;
+   } else {
+      ZVAL_EMPTY_STRING(&bytes);
+   }
+   Variant result(&bytes);
+   zval_ptr_dtor(&bytes);
+   return result;
+}
+
+void BinaryWriter::clear()
+{
+   if (m_buffer.s) {
+      ZSTR_LEN(m_buffer.s) = 0;
+   }
+   m_error = Error::None;
+}
+
+void BinaryWriter::writeZval(zval *value)
+{
+   if (m_error != Error::None) {
+      return;
+   }
+   if (m_fd >= 0 && getSize() >= FLUSH_THRESHOLD && !flush()) {
+      return;
+   }
+   if (Z_TYPE_P(value) == IS_INDIRECT) {
+      value = Z_INDIRECT_P(value);
+   }
+   ZVAL_DEREF(value);
+   switch (Z_TYPE_P(value)) {
+   case IS_UNDEF:
+   case IS_NULL:
+      writeByte(TagNull);
+      break;
+   case IS_FALSE:
+      writeByte(TagFalse);
+      break;
+   case IS_TRUE:
+      writeByte(TagTrue);
+      break;
+   case IS_LONG:
+      writeByte(TagLong);
+      writeLong(Z_LVAL_P(value));
+      break;
+   case IS_DOUBLE:
+      writeByte(TagDouble);
+      writeDouble(Z_DVAL_P(value));
+      break;
+   case IS_STRING:
+      writeString(Z_STR_P(value));
+      break;
+   case IS_ARRAY:
+      writeArray(Z_ARRVAL_P(value));
+      break;
+   case IS_OBJECT:
+      writeObject(value);
+      break;
+   default:
+      fail(Error::UnsupportedType);
+   }
+}
+
+void BinaryWriter::writeArray(zend_array *array)
+{
+   DepthGuard guard(m_depth);
+   if (m_depth > m_maxDepth) {
+      fail(Error::Depth);
+      return;
+   }
+   // immutable arrays can't contain themselves
+   bool guarded = ZEND_HASH_APPLY_PROTECTION(array) && !(GC_FLAGS(array) & IS_ARRAY_IMMUTABLE);
+   if (guarded) {
+      if (ZEND_HASH_GET_APPLY_COUNT(array) > 0) {
+         fail(Error::Recursion);
+         return;
+      }
+      ZEND_HASH_INC_APPLY_COUNT(array);
+   }
+   if (is_list(array)) {
+      writeList(array);
+   } else {
+      writeByte(TagMap);
+      writeVarint(zend_hash_num_elements(array));
+      zend_ulong index;
+      zend_string *key;
+      zval *item;
+      ZEND_HASH_FOREACH_KEY_VAL(array, index, key, item) {
+         if (key) {
+            writeString(key);
+         } else {
+            writeByte(TagLong);
+            writeLong(static_cast<zend_long>(index));
+         }
+         writeZval(item);
+         if (m_error != Error::None) {
+            break;
+         }
+      } ZEND_HASH_FOREACH_END();
+   }
+   if (guarded) {
+      ZEND_HASH_DEC_APPLY_COUNT(array);
+   }
+}
+
+void BinaryWriter::writeList(zend_array *array)
+{
+   uint32_t count = zend_hash_num_elements(array);
+   writeByte(TagList);
+   writeVarint(count);
+   if (array->nNumUsed != count) {
+      zval *item;
+      ZEND_HASH_FOREACH_VAL(array, item) {
+         writeZval(item);
+         if (m_error != Error::None) {
+            break;
+         }
+      } ZEND_HASH_FOREACH_END();
+      return;
+   }
+   // without holes the bucket i holds the item i, so the runs can be measured
+   // before they are written
+   Bucket *data = array->arData;
+   uint32_t i = 0;
+   while (i < count && m_error == Error::None) {
+      zend_uchar type = Z_TYPE(data[i].val);
+      if (type != IS_LONG && type != IS_DOUBLE) {
+         writeZval(&data[i].val);
+         ++i;
+         continue;
+      }
+      uint32_t end = i + 1;
+      while (end < count && Z_TYPE(data[end].val) == type) {
+         ++end;
+      }
+      if (end - i < MIN_RUN_LENGTH) {
+         for (; i < end; ++i) {
+            writeZval(&data[i].val);
+         }
+         continue;
+      }
+      writeByte(type == IS_LONG ? TagLongRun : TagDoubleRun);
+      writeVarint(end - i);
+      for (; i < end; ++i) {
+         if (type == IS_LONG) {
+            writeLong(Z_LVAL(data[i].val));
+         } else {
+            writeDouble(Z_DVAL(data[i].val));
+         }
+      }
+   }
+}
+
+void BinaryWriter::writeObject(zval *value)
+{
+   zend_object *object = Z_OBJ_P(value);
+   zend_class_entry *entry = object->ce;
+   // the native hook takes precedence over the class hooks
+   BinarySerializable *hook = binary_hook(value);
+   if (!hook && is_unsupported_class(entry)) {
+      fail(Error::UnsupportedType);
+      return;
+   }
+   zval *found = zend_hash_index_find(m_objects, object->handle);
+   if (found) {
+      writeByte(TagObjectRef);
+      writeVarint(static_cast<uint64_t>(Z_LVAL_P(found)));
+      return;
+   }
+   DepthGuard guard(m_depth);
+   if (m_depth > m_maxDepth) {
+      fail(Error::Depth);
+      return;
+   }
+   zval index;
+   ZVAL_LONG(&index, zend_hash_num_elements(m_objects));
+   zend_hash_index_add_new(m_objects, object->handle, &index);
+   ++GC_REFCOUNT(object);
+   m_objectRefs.push_back(object);
+   if (hook) {
+      writeByte(TagNative);
+      writeString(entry->name);
+      // user may throw an exception in the writeBinary() function
+      try {
+         hook->writeBinary(*this);
+      } catch (Exception &exception) {
+         fail(Error::Rejected);
+         return;
+      }
+      writeByte(TagEnd);
+      return;
+   }
+   writeByte(TagObject);
+   writeString(entry->name);
+   zend_array *properties = Z_OBJPROP_P(value);
+   if (!properties) {
+      writeVarint(0);
+      return;
+   }
+   // the unset declared properties are still in the table
+   uint32_t count = 0;
+   zval *item;
+   ZEND_HASH_FOREACH_VAL_IND(properties, item) {
+      ++count;
+   } ZEND_HASH_FOREACH_END();
+   writeVarint(count);
+   zend_ulong key;
+   zend_string *name;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(properties, key, name, item) {
+      if (name) {
+         writeString(name);
+      } else {
+         writeByte(TagLong);
+         writeLong(static_cast<zend_long>(key));
+      }
+      writeZval(item);
+      if (m_error != Error::None) {
+         break;
+      }
+   } ZEND_HASH_FOREACH_END();
+}
+
+void BinaryWriter::writeString(zend_string *str)
+{
+   size_t length = ZSTR_LEN(str);
+   if (length > 1 && length <= MAX_SHARED_STRING_LENGTH) {
+      zval *found = zend_hash_find(m_strings, str);
+      if (found) {
+         writeByte(TagStringRef);
+         writeVarint(static_cast<uint64_t>(Z_LVAL_P(found)));
+         return;
+      }
+      zval index;
+      ZVAL_LONG(&index, zend_hash_num_elements(m_strings));
+      zend_hash_add_new(m_strings, str, &index);
+   }
+   writeByte(TagString);
+   writeVarint(length);
+   smart_str_appendl(&m_buffer, ZSTR_VAL(str), length);
+}
+
+void BinaryWriter::writeVarint(uint64_t value)
+{
+   char bytes[10];
+   size_t length = 0;
+   while (value >= 0x80) {
+      bytes[length++] = static_cast<char>((value & 0x7f) | 0x80);
+      value >>= 7;
+   }
+   bytes[length++] = static_cast<char>(value);
+   smart_str_appendl(&m_buffer, bytes, length);
+}
+
+void BinaryWriter::writeLong(zend_long value)
+{
+   writeVarint(zigzag_encode(value));
+}
+
+void BinaryWriter::writeDouble(double value)
+{
+   uint64_t bits;
+   std::memcpy(&bits, &value, sizeof(bits));
+   char bytes[8];
+   for (int i = 0; i < 8; ++i) {
+      bytes[i] = static_cast<char>(bits >> (i * 8));
+   }
+   smart_str_appendl(&m_buffer, bytes, 8);
+}
+
+void BinaryWriter::writeByte(unsigned char byte)
+{
+   smart_str_appendc(&m_buffer, static_cast<char>(byte));
+}
+
+void BinaryWriter::resetTables()
+{
+   zend_hash_clean(m_strings);
+   zend_hash_clean(m_objects);
+   for (zend_object *object : m_objectRefs) {
+      OBJ_RELEASE(object);
+   }
+   m_objectRefs.clear();
+}
+
+BinaryReader::BinaryReader(const char *data, size_t length, uint32_t maxDepth)
+   : m_begin(data),
+     m_cursor(data),
+     m_end(data + length),
+     m_maxDepth(maxDepth),
+     m_depth(0),
+     m_error(Error::None)
+{}
+
+BinaryReader::BinaryReader(const std::string &data, uint32_t maxDepth)
+   : BinaryReader(data.data(), data.length(), maxDepth)
+{}
+
+BinaryReader::~BinaryReader()
+{
+   resetTables();
+}
+
+bool BinaryReader::read(Variant &result)
+{
+   if (m_error != Error::None || atEnd()) {
+      return false;
+   }
+   if (m_end - m_cursor < 3 || m_cursor[0] != 'Z' || m_cursor[1] != 'B' ||
+       static_cast<unsigned char>(m_cursor[2]) != FORMAT_VERSION) {
+      return fail(Error::Header);
+   }
+   m_cursor += 3;
+   m_depth = 0;
+   zval value;
+   bool status = readZval(&value);
+   if (status && !wakeupObjects()) {
+      zval_ptr_dtor(&value);
+      status = false;
+   }
+   resetTables();
+   if (!status) {
+      return false;
+   }
+   result = Variant(&value);
+   zval_ptr_dtor(&value);
+   return true;
+}
+
+bool BinaryReader::readValue(Variant &value)
+{
+   if (m_error != Error::None) {
+      return false;
+   }
+   zval item;
+   if (!readZval(&item)) {
+      return false;
+   }
+   value = Variant(&item);
+   zval_ptr_dtor(&item);
+   return true;
+}
+
+bool BinaryReader::readZval(zval *result)
+{
+   if (m_cursor == m_end) {
+      return fail(Error::Truncated);
+   }
+   unsigned char tag = static_cast<unsigned char>(*m_cursor++);
+   switch (tag) {
+   case TagNull:
+      ZVAL_NULL(result);
+      return true;
+   case TagFalse:
+      ZVAL_FALSE(result);
+      return true;
+   case TagTrue:
+      ZVAL_TRUE(result);
+      return true;
+   case TagLong: {
+      zend_long value;
+      if (!readLong(value)) {
+         return false;
+      }
+      ZVAL_LONG(result, value);
+      return true;
+   }
+   case TagDouble: {
+      double value;
+      if (!readDouble(value)) {
+         return false;
+      }
+      ZVAL_DOUBLE(result, value);
+      return true;
+   }
+   case TagString:
+   case TagStringRef: {
+      zend_string *str;
+      if (!readString(tag, str)) {
+         return false;
+      }
+      ZVAL_STR(result, str);
+      return true;
+   }
+   case TagList:
+      return readList(result);
+   case TagMap:
+      return readMap(result);
+   case TagObject:
+      return readObject(result, false);
+   case TagNative:
+      return readObject(result, true);
+   case TagObjectRef: {
+      uint64_t index;
+      if (!readVarint(index)) {
+         return false;
+      }
+      if (index >= m_objects.size()) {
+         return fail(Error::Corrupted);
+      }
+      ZVAL_OBJ(result, m_objects[index]);
+      Z_ADDREF_P(result);
+      return true;
+   }
+   default:
+      return fail(Error::Corrupted);
+   }
+}
+
+bool BinaryReader::readList(zval *result)
+{
+   uint64_t count;
+   if (!readVarint(count)) {
+      return false;
+   }
+   // every item takes one byte at least
+   if (count > static_cast<uint64_t>(m_end - m_cursor)) {
+      return fail(Error::Truncated);
+   }
+   DepthGuard guard(m_depth);
+   if (m_depth > m_maxDepth) {
+      return fail(Error::Depth);
+   }
+   array_init_size(result, static_cast<uint32_t>(count));
+   zend_array *array = Z_ARRVAL_P(result);
+   zend_hash_real_init(array, 1);
+   uint64_t filled = 0;
+   zval item;
+   while (filled < count) {
+      if (m_cursor == m_end) {
+         fail(Error::Truncated);
+         break;
+      }
+      unsigned char tag = static_cast<unsigned char>(*m_cursor);
+      if (tag != TagLongRun && tag != TagDoubleRun) {
+         if (!readZval(&item)) {
+            break;
+         }
+         zend_hash_next_index_insert_new(array, &item);
+         ++filled;
+         continue;
+      }
+      ++m_cursor;
+      uint64_t length;
+      if (!readVarint(length)) {
+         break;
+      }
+      if (length == 0 || length > count - filled) {
+         fail(Error::Corrupted);
+         break;
+      }
+      for (uint64_t i = 0; i < length; ++i) {
+         if (tag == TagLongRun) {
+            zend_long value;
+            if (!readLong(value)) {
+               break;
+            }
+            ZVAL_LONG(&item, value);
+         } else {
+            double value;
+            if (!readDouble(value)) {
+               break;
+            }
+            ZVAL_DOUBLE(&item, value);
+         }
+         zend_hash_next_index_insert_new(array, &item);
+      }
+      if (m_error != Error::None) {
+         break;
+      }
+      filled += length;
+   }
+   if (m_error != Error::None) {
+      zval_ptr_dtor(result);
+      return false;
+   }
+   return true;
+}
+
+bool BinaryReader::readMap(zval *result)
+{
+   uint64_t count;
+   if (!readVarint(count)) {
+      return false;
+   }
+   // every pair takes two bytes at least
+   if (count > static_cast<uint64_t>(m_end - m_cursor) / 2) {
+      return fail(Error::Truncated);
+   }
+   DepthGuard guard(m_depth);
+   if (m_depth > m_maxDepth) {
+      return fail(Error::Depth);
+   }
+   array_init_size(result, static_cast<uint32_t>(count));
+   zend_array *array = Z_ARRVAL_P(result);
+   zend_hash_real_init(array, 0);
+   zval item;
+   for (uint64_t i = 0; i < count; ++i) {
+      if (m_cursor == m_end) {
+         fail(Error::Truncated);
+         break;
+      }
+      unsigned char tag = static_cast<unsigned char>(*m_cursor++);
+      if (tag == TagLong) {
+         zend_long index;
+         if (!readLong(index) || !readZval(&item)) {
+            break;
+         }
+         zend_hash_index_update(array, static_cast<zend_ulong>(index), &item);
+      } else if (tag == TagString || tag == TagStringRef) {
+         zend_string *key;
+         if (!readString(tag, key)) {
+            break;
+         }
+         if (!readZval(&item)) {
+            zend_string_release(key);
+            break;
+         }
+         zend_hash_update(array, key, &item);
+         zend_string_release(key);
+      } else {
+         fail(Error::Corrupted);
+         break;
+      }
+   }
+   if (m_error != Error::None) {
+      zval_ptr_dtor(result);
+      return false;
+   }
+   return true;
+}
+
+bool BinaryReader::readObject(zval *result, bool native)
+{
+   DepthGuard guard(m_depth);
+   if (m_depth > m_maxDepth) {
+      return fail(Error::Depth);
+   }
+   if (m_cursor == m_end) {
+      return fail(Error::Truncated);
+   }
+   unsigned char tag = static_cast<unsigned char>(*m_cursor++);
+   if (tag != TagString && tag != TagStringRef) {
+      return fail(Error::Corrupted);
+   }
+   zend_string *name;
+   if (!readString(tag, name)) {
+      return false;
+   }
+   zend_class_entry *entry = zend_lookup_class(name);
+   zend_string_release(name);
+   if (!entry) {
+      return fail(Error::ClassNotFound);
+   }
+   if ((entry->ce_flags & (ZEND_ACC_INTERFACE | ZEND_ACC_TRAIT | ZEND_ACC_IMPLICIT_ABSTRACT_CLASS |
+                           ZEND_ACC_EXPLICIT_ABSTRACT_CLASS)) ||
+       entry->unserialize == zend_class_unserialize_deny) {
+      return fail(Error::NotSerializable);
+   }
+   if (object_init_ex(result, entry) != SUCCESS) {
+      return fail(Error::NotSerializable);
+   }
+   zend_object *object = Z_OBJ_P(result);
+   ++GC_REFCOUNT(object);
+   m_objects.push_back(object);
+   if (native) {
+      BinarySerializable *hook = binary_hook(result);
+      if (!hook) {
+         zval_ptr_dtor(result);
+         return fail(Error::NotSerializable);
+      }
+      bool accepted;
+      // user may throw an exception in the readBinary() function
+      try {
+         accepted = hook->readBinary(*this);
+      } catch (Exception &exception) {
+         accepted = false;
+      }
+      if (!accepted) {
+         fail(Error::Rejected);
+      }
+      // skip the values the hook didn't read
+      while (m_error == Error::None) {
+         if (m_cursor == m_end) {
+            fail(Error::Truncated);
+         } else if (static_cast<unsigned char>(*m_cursor) == TagEnd) {
+            ++m_cursor;
+            return true;
+         } else {
+            zval skipped;
+            if (readZval(&skipped)) {
+               zval_ptr_dtor(&skipped);
+            }
+         }
+      }
+      zval_ptr_dtor(result);
+      return false;
+   }
+   uint64_t count;
+   if (!readVarint(count)) {
+      zval_ptr_dtor(result);
+      return false;
+   }
+   zend_array *properties = Z_OBJPROP_P(result);
+   zval item;
+   for (uint64_t i = 0; i < count; ++i) {
+      if (m_cursor == m_end) {
+         fail(Error::Truncated);
+         break;
+      }
+      tag = static_cast<unsigned char>(*m_cursor++);
+      if (tag == TagLong) {
+         zend_long index;
+         if (!readLong(index) || !readZval(&item)) {
+            break;
+         }
+         zend_hash_index_update(properties, static_cast<zend_ulong>(index), &item);
+      } else if (tag == TagString || tag == TagStringRef) {
+         zend_string *key;
+         if (!readString(tag, key)) {
+            break;
+         }
+         if (!readZval(&item)) {
+            zend_string_release(key);
+            break;
+         }
+         // goes through the slots of the declared properties
+         zend_hash_update_ind(properties, key, &item);
+         zend_string_release(key);
+      } else {
+         fail(Error::Corrupted);
+         break;
+      }
+   }
+   if (m_error != Error::None) {
+      zval_ptr_dtor(result);
+      return false;
+   }
+   if (zend_hash_str_exists(&entry->function_table, "__wakeup", sizeof("__wakeup") - 1)) {
+      m_wakeups.push_back(object);
+   }
+   return true;
+}
+
+bool BinaryReader::wakeupObjects()
+{
+   for (zend_object *object : m_wakeups) {
+      zval value;
+      ZVAL_OBJ(&value, object);
+      zend_call_method_with_0_params(&value, object->ce, nullptr, "__wakeup", nullptr);
+      if (EG(exception)) {
+         return fail(Error::Rejected);
+      }
+   }
+   return true;
+}
+
+bool BinaryReader::readString(unsigned char tag, zend_string *&str)
+{
+   uint64_t length;
+   if (!readVarint(length)) {
+      return false;
+   }
+   if (tag == TagStringRef) {
+      if (length >= m_strings.size()) {
+         return fail(Error::Corrupted);
+      }
+      str = zend_string_copy(m_strings[length]);
+      return true;
+   }
+   if (length > static_cast<uint64_t>(m_end - m_cursor)) {
+      return fail(Error::Truncated);
+   }
+   if (length == 0) {
+      str = ZSTR_EMPTY_ALLOC();
+      return true;
+   }
+   str = zend_string_init(m_cursor, length, 0);
+   m_cursor += length;
+   if (length > 1 && length <= MAX_SHARED_STRING_LENGTH) {
+      m_strings.push_back(zend_string_copy(str));
+   }
+   return true;
+}
+
+bool BinaryReader::readVarint(uint64_t &value)
+{
+   value = 0;
+   for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (m_cursor == m_end) {
+         return fail(Error::Truncated);
+      }
+      unsigned char byte = static_cast<unsigned char>(*m_cursor++);
+      if (shift == 63 && byte > 1) {
+         return fail(Error::Corrupted);
+      }
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+         return true;
+      }
+   }
+   return fail(Error::Corrupted);
+}
+
+bool BinaryReader::readLong(zend_long &value)
+{
+   uint64_t encoded;
+   if (!readVarint(encoded)) {
+      return false;
+   }
+   int64_t number = zigzag_decode(encoded);
+   if (number < ZEND_LONG_MIN || number > ZEND_LONG_MAX) {
+      return fail(Error::Corrupted);
+   }
+   value = static_cast<zend_long>(number);
+   return true;
+}
+
+bool BinaryReader::readDouble(double &value)
+{
+   if (m_end - m_cursor < 8) {
+      return fail(Error::Truncated);
+   }
+   uint64_t bits = 0;
+   for (int i = 0; i < 8; ++i) {
+      bits |= static_cast<uint64_t>(static_cast<unsigned char>(m_cursor[i])) << (i * 8);
+   }
+   m_cursor += 8;
+   std::memcpy(&value, &bits, sizeof(value));
+   return true;
+}
+
+void BinaryReader::resetTables()
+{
+   for (zend_string *str : m_strings) {
+      zend_string_release(str);
+   }
+   m_strings.clear();
+   for (zend_object *object : m_objects) {
+      OBJ_RELEASE(object);
+   }
+   m_objects.clear();
+   m_wakeups.clear();
+}
+
+} // ds
+} // zapi
@@ -67,27 +67,25 @@ namespace ds
 {
 
 CallableVariant::CallableVariant(HaveArgCallable callable)
-   : Variant(ObjectVariant(Closure::getClassEntry(), std::make_shared<Closure>(std::function<HaveArgCallable>(callable))))
-{}
+{
+   Closure::create(getUnDerefZvalPtr(), callable);
+}
 
 CallableVariant::CallableVariant(NoArgCallable callable)
-   : Variant(ObjectVariant(Closure::getClassEntry(), std::make_shared<Closure>([callable](Parameters &params) -> Variant {
-                              return callable();
-                           })))
-{}
+{
+   Closure::create(getUnDerefZvalPtr(), [callable](Parameters &params) -> Variant {
+      return callable();
+   });
+}
 
 CallableVariant::CallableVariant(const Variant &other)
 {
    zval *from = const_cast<zval *>(other.getZvalPtr());
    zval *self = getUnDerefZvalPtr();
-   zend_class_entry *classEntry = nullptr;
-   if (other.getType() == Type::Object &&
-       (classEntry = Z_OBJCE_P(from)) && 0 == std::memcmp("ZapiClosure", classEntry->name->val, classEntry->name->len)) {
+   if (Closure::isClosure(from)) {
       ZVAL_COPY(self, from);
    } else {
-      ObjectVariant defaultCallable(Closure::getClassEntry(), std::make_shared<Closure>(do_nothing));
-      zval temp = defaultCallable.detach(true);
-      ZVAL_COPY_VALUE(self, &temp);
+      Closure::create(self, do_nothing);
    }
 }
 
@@ -99,12 +97,9 @@ CallableVariant::CallableVariant(Variant &&other)
    : Variant(std::move(other))
 {
    zval *self = getUnDerefZvalPtr();
-   zend_class_entry *classEntry = nullptr;
-   if (getUnDerefType() != Type::Object || 
-       ((classEntry = Z_OBJCE_P(self)) && 0 != std::memcmp("ZapiClosure", classEntry->name->val, classEntry->name->len))) {
-      ObjectVariant defaultCallable(Closure::getClassEntry(), std::make_shared<Closure>(do_nothing));
-      zval temp = defaultCallable.detach(true);
-      ZVAL_COPY_VALUE(self, &temp);
+   if (!Closure::isClosure(self)) {
+      zval_ptr_dtor(self);
+      Closure::create(self, do_nothing);
    }
 }
 
@@ -123,21 +118,13 @@ CallableVariant::CallableVariant(zval &&other)
 CallableVariant::CallableVariant(zval *other)
 {
    zval *self = getUnDerefZvalPtr();
-   if (nullptr != other && Z_TYPE_P(other) != IS_NULL) {
-      if ((Z_TYPE_P(other) == IS_OBJECT || 
-           (Z_TYPE_P(other) == IS_REFERENCE && Z_TYPE_P(Z_REFVAL_P(other)) == IS_OBJECT))) {
-         ZVAL_DEREF(other);
-         zend_class_entry *classEntry = Z_OBJCE_P(other);
-         if (classEntry && 0 == std::memcmp("ZapiClosure", classEntry->name->val, classEntry->name->len)) {
-            ZVAL_COPY(self, other);
-            return;
-         }
-      }
+   if (nullptr != other && Closure::isClosure(other)) {
+      ZVAL_DEREF(other);
+      ZVAL_COPY(self, other);
+      return;
    }
    // construct default
-   ObjectVariant defaultCallable(Closure::getClassEntry(), std::make_shared<Closure>(do_nothing));
-   zval temp = defaultCallable.detach(true);
-   ZVAL_COPY_VALUE(self, &temp);
+   Closure::create(self, do_nothing);
 }
 
 CallableVariant &CallableVariant::operator =(const CallableVariant &other)
@@ -153,16 +140,12 @@ CallableVariant &CallableVariant::operator =(const Variant &other)
    if (this != &other) {
       zval *self = getZvalPtr();
       zval *from = const_cast<zval *>(other.getZvalPtr());
-      zend_class_entry *classEntry = nullptr;
-      if (other.getType() == Type::Object &&
-          (classEntry = Z_OBJCE_P(from)) && 0 == std::memcmp("ZapiClosure", classEntry->name->val, classEntry->name->len)) {
+      if (Closure::isClosure(from)) {
          // standard copy
          Variant::operator =(from);
       } else {
-         ObjectVariant defaultCallable(Closure::getClassEntry(), std::make_shared<Closure>(do_nothing));
-         zval temp = defaultCallable.detach(true);
          zval_dtor(self);
-         ZVAL_COPY_VALUE(self, &temp);
+         Closure::create(self, do_nothing);
       }
    }
    return *this;
@@ -180,12 +163,9 @@ CallableVariant &CallableVariant::operator =(Variant &&other)
    assert(this != &other);
    m_implPtr = std::move(other.m_implPtr);
    zval *self = getUnDerefZvalPtr();
-   zend_class_entry *classEntry = nullptr;
-   if (getUnDerefType() != Type::Object ||
-       ((classEntry = Z_OBJCE_P(self)) && 0 == std::memcmp("ZapiClosure", classEntry->name->val, classEntry->name->len))) {
-      ObjectVariant defaultCallable(Closure::getClassEntry(), std::make_shared<Closure>(do_nothing));
-      zval temp = defaultCallable.detach(true);
-      ZVAL_COPY_VALUE(self, &temp);
+   if (!Closure::isClosure(self)) {
+      zval_ptr_dtor(self);
+      Closure::create(self, do_nothing);
    }
    return *this;
 }
@@ -196,12 +176,24 @@ Variant CallableVariant::exec(int argc, Variant *argv) const
    for (int i = 0; i < argc; i++) {
       params[i] = *argv[i].getZvalPtr();
    }
-   return do_execute(const_cast<zval *>(getUnDerefZvalPtr()), argc, params.get());
+   zval *self = const_cast<zval *>(getUnDerefZvalPtr());
+   if (Closure::isClosure(self)) {
+      // native closure, no need to go through the engine, a moved-in
+      // reference holds the closure behind it
+      ZVAL_DEREF(self);
+      return Closure::call(self, params.get(), argc);
+   }
+   return do_execute(self, argc, params.get());
 }
 
 Variant CallableVariant::operator ()() const
 {
-   return do_execute(const_cast<zval *>(getUnDerefZvalPtr()), 0, nullptr);
+   zval *self = const_cast<zval *>(getUnDerefZvalPtr());
+   if (Closure::isClosure(self)) {
+      ZVAL_DEREF(self);
+      return Closure::call(self, nullptr, 0);
+   }
+   return do_execute(self, 0, nullptr);
 }
 
 CallableVariant::~CallableVariant()
@@ -0,0 +1,1196 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/ds/JsonCodec.h"
+#include "php/Zend/zend_interfaces.h"
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || (defined(ZAPI_CC_MSVC) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#  include <emmintrin.h>
+#  ifdef ZAPI_CC_MSVC
+#     include <intrin.h>
+#  endif
+#  define ZAPI_JSON_SSE2
+#endif
+
+namespace zapi
+{
+namespace ds
+{
+
+namespace internal
+{
+
+// direct mapped, a key that collides with another one just replaces it
+struct JsonKeyCache
+{
+   static constexpr size_t slotCount = 256;
+   static constexpr size_t maxKeyLength = 64;
+
+   JsonKeyCache()
+   {
+      std::memset(slots, 0, sizeof(slots));
+   }
+
+   ~JsonKeyCache()
+   {
+      clear();
+   }
+
+   zend_string *get(const char *key, size_t length)
+   {
+      zend_ulong hash = zend_inline_hash_func(key, length);
+      if (length > maxKeyLength) {
+         zend_string *str = zend_string_init(key, length, 0);
+         ZSTR_H(str) = hash;
+         return str;
+      }
+      zend_string *&slot = slots[hash & (slotCount - 1)];
+      if (slot && ZSTR_H(slot) == hash && ZSTR_LEN(slot) == length &&
+          std::memcmp(ZSTR_VAL(slot), key, length) == 0) {
+         zend_string_addref(slot);
+         return slot;
+      }
+      if (slot) {
+         zend_string_release(slot);
+      }
+      slot = zend_string_init(key, length, 0);
+      ZSTR_H(slot) = hash;
+      zend_string_addref(slot);
+      return slot;
+   }
+
+   void clear()
+   {
+      for (zend_string *&slot : slots) {
+         if (slot) {
+            zend_string_release(slot);
+            slot = nullptr;
+         }
+      }
+   }
+
+   zend_string *slots[slotCount];
+};
+
+} // internal
+
+namespace
+{
+
+using internal::JsonKeyCache;
+using DecodeError = JsonDecoder::Error;
+
+const char json_hex_digits[] = "0123456789abcdef";
+
+inline bool is_json_space(char c)
+{
+   return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool is_json_digit(char c)
+{
+   return c >= '0' && c <= '9';
+}
+
+#ifdef ZAPI_JSON_SSE2
+inline unsigned count_trailing_zeros(unsigned mask)
+{
+#  ifdef ZAPI_CC_MSVC
+   unsigned long index;
+   _BitScanForward(&index, mask);
+   return static_cast<unsigned>(index);
+#  else
+   return static_cast<unsigned>(__builtin_ctz(mask));
+#  endif
+}
+#endif
+
+const char *skip_whitespace(const char *cursor, const char *end)
+{
+   if (cursor < end && !is_json_space(*cursor)) {
+      return cursor;
+   }
+#ifdef ZAPI_JSON_SSE2
+   const __m128i space = _mm_set1_epi8(' ');
+   const __m128i newline = _mm_set1_epi8('\n');
+   const __m128i carriage = _mm_set1_epi8('\r');
+   const __m128i tab = _mm_set1_epi8('\t');
+   while (end - cursor >= 16) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cursor));
+      __m128i blank = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, newline)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(chunk, carriage), _mm_cmpeq_epi8(chunk, tab)));
+      unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(blank)) & 0xFFFF;
+      if (mask) {
+         return cursor + count_trailing_zeros(mask);
+      }
+      cursor += 16;
+   }
+#endif
+   while (cursor < end && is_json_space(*cursor)) {
+      ++cursor;
+   }
+   return cursor;
+}
+
+/**
+ * Find the first byte of a string that needs attention: the quote, the
+ * backslash, extra, a control character or a byte of a multibyte sequence.
+ * The signed compare against 0x20 catches both the control characters and
+ * the bytes above 0x7F
+ */
+const char *find_special(const char *cursor, const char *end, char extra)
+{
+#ifdef ZAPI_JSON_SSE2
+   const __m128i quote = _mm_set1_epi8('"');
+   const __m128i backslash = _mm_set1_epi8('\\');
+   const __m128i other = _mm_set1_epi8(extra);
+   const __m128i control = _mm_set1_epi8(0x20);
+   while (end - cursor >= 16) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cursor));
+      __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                     _mm_or_si128(_mm_cmpeq_epi8(chunk, other), _mm_cmplt_epi8(chunk, control)));
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+      if (mask) {
+         return cursor + count_trailing_zeros(mask);
+      }
+      cursor += 16;
+   }
+#endif
+   while (cursor < end) {
+      unsigned char c = static_cast<unsigned char>(*cursor);
+      if (c == '"' || c == '\\' || c == static_cast<unsigned char>(extra) || c < 0x20 || c > 0x7F) {
+         break;
+      }
+      ++cursor;
+   }
+   return cursor;
+}
+
+// length of the UTF-8 sequence at cursor, 0 when it is malformed, overlong
+// or encodes a surrogate
+size_t decode_utf8(const char *cursor, const char *end, uint32_t &codePoint)
+{
+   const unsigned char *bytes = reinterpret_cast<const unsigned char *>(cursor);
+   size_t available = static_cast<size_t>(end - cursor);
+   unsigned char lead = bytes[0];
+   if (lead < 0x80) {
+      codePoint = lead;
+      return 1;
+   }
+   size_t length;
+   uint32_t minimum;
+   if (lead >= 0xC2 && lead <= 0xDF) {
+      length = 2;
+      minimum = 0x80;
+      codePoint = lead & 0x1F;
+   } else if (lead >= 0xE0 && lead <= 0xEF) {
+      length = 3;
+      minimum = 0x800;
+      codePoint = lead & 0x0F;
+   } else if (lead >= 0xF0 && lead <= 0xF4) {
+      length = 4;
+      minimum = 0x10000;
+      codePoint = lead & 0x07;
+   } else {
+      return 0;
+   }
+   if (available < length) {
+      return 0;
+   }
+   for (size_t i = 1; i < length; ++i) {
+      if ((bytes[i] & 0xC0) != 0x80) {
+         return 0;
+      }
+      codePoint = (codePoint << 6) | (bytes[i] & 0x3F);
+   }
+   if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+      return 0;
+   }
+   return length;
+}
+
+void append_utf8(std::string &target, uint32_t codePoint)
+{
+   if (codePoint < 0x80) {
+      target.push_back(static_cast<char>(codePoint));
+   } else if (codePoint < 0x800) {
+      target.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+      target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+   } else if (codePoint < 0x10000) {
+      target.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+      target.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+   } else {
+      target.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+      target.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+      target.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+   }
+}
+
+bool read_hex4(const char *cursor, const char *end, uint32_t &unit)
+{
+   if (end - cursor < 4) {
+      return false;
+   }
+   unit = 0;
+   for (int i = 0; i < 4; ++i) {
+      char c = cursor[i];
+      unit <<= 4;
+      if (c >= '0' && c <= '9') {
+         unit |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+         unit |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+         unit |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+         return false;
+      }
+   }
+   return true;
+}
+
+/**
+ * Recursive descent over one complete document, a failed parse function
+ * releases what it built so the callers only release their own values
+ */
+class JsonParser
+{
+public:
+   JsonParser(const char *begin, const char *end, uint32_t maxDepth, JsonKeyCache &keys)
+      : m_begin(begin),
+        m_end(end),
+        m_cursor(begin),
+        m_errorPos(begin),
+        m_maxDepth(maxDepth),
+        m_error(DecodeError::None),
+        m_keys(keys)
+   {}
+
+   bool parse(zval *result)
+   {
+      m_cursor = skip_whitespace(m_cursor, m_end);
+      if (!parseValue(result, 0)) {
+         return false;
+      }
+      m_cursor = skip_whitespace(m_cursor, m_end);
+      if (m_cursor != m_end) {
+         zval_ptr_dtor(result);
+         return fail(DecodeError::Syntax);
+      }
+      return true;
+   }
+
+   DecodeError getError() const
+   {
+      return m_error;
+   }
+
+   size_t getErrorOffset() const
+   {
+      return static_cast<size_t>(m_errorPos - m_begin);
+   }
+
+private:
+   bool fail(DecodeError error)
+   {
+      m_error = error;
+      m_errorPos = m_cursor;
+      return false;
+   }
+
+   bool parseValue(zval *result, uint32_t depth)
+   {
+      if (m_cursor == m_end) {
+         return fail(DecodeError::Syntax);
+      }
+      switch (*m_cursor) {
+      case '{':
+         return parseObject(result, depth);
+      case '[':
+         return parseArray(result, depth);
+      case '"': {
+         const char *str;
+         size_t length;
+         ++m_cursor;
+         if (!parseString(str, length)) {
+            return false;
+         }
+         if (length == 0) {
+            ZVAL_EMPTY_STRING(result);
+         } else {
+            ZVAL_STRINGL(result, str, length);
+         }
+         return true;
+      }
+      case 't':
+         if (!parseLiteral("true", 4)) {
+            return false;
+         }
+         ZVAL_TRUE(result);
+         return true;
+      case 'f':
+         if (!parseLiteral("false", 5)) {
+            return false;
+         }
+         ZVAL_FALSE(result);
+         return true;
+      case 'n':
+         if (!parseLiteral("null", 4)) {
+            return false;
+         }
+         ZVAL_NULL(result);
+         return true;
+      default:
+         return parseNumber(result);
+      }
+   }
+
+   bool parseLiteral(const char *literal, size_t length)
+   {
+      if (static_cast<size_t>(m_end - m_cursor) < length || std::memcmp(m_cursor, literal, length) != 0) {
+         return fail(DecodeError::Syntax);
+      }
+      m_cursor += length;
+      return true;
+   }
+
+   bool parseNumber(zval *result)
+   {
+      const char *start = m_cursor;
+      const char *cursor = m_cursor;
+      bool negative = false;
+      if (*cursor == '-') {
+         negative = true;
+         ++cursor;
+      }
+      if (cursor == m_end || !is_json_digit(*cursor)) {
+         return fail(DecodeError::Syntax);
+      }
+      bool isDouble = false;
+      zend_ulong value = 0;
+      const zend_ulong limit = negative
+            ? static_cast<zend_ulong>(ZEND_LONG_MAX) + 1
+            : static_cast<zend_ulong>(ZEND_LONG_MAX);
+      if (*cursor == '0') {
+         ++cursor;
+      } else {
+         while (cursor != m_end && is_json_digit(*cursor)) {
+            zend_ulong digit = static_cast<zend_ulong>(*cursor - '0');
+            if (value > (limit - digit) / 10) {
+               isDouble = true;
+            } else {
+               value = value * 10 + digit;
+            }
+            ++cursor;
+         }
+      }
+      if (cursor != m_end && *cursor == '.') {
+         ++cursor;
+         if (cursor == m_end || !is_json_digit(*cursor)) {
+            m_cursor = cursor;
+            return fail(DecodeError::Syntax);
+         }
+         while (cursor != m_end && is_json_digit(*cursor)) {
+            ++cursor;
+         }
+         isDouble = true;
+      }
+      if (cursor != m_end && (*cursor == 'e' || *cursor == 'E')) {
+         ++cursor;
+         if (cursor != m_end && (*cursor == '+' || *cursor == '-')) {
+            ++cursor;
+         }
+         if (cursor == m_end || !is_json_digit(*cursor)) {
+            m_cursor = cursor;
+            return fail(DecodeError::Syntax);
+         }
+         while (cursor != m_end && is_json_digit(*cursor)) {
+            ++cursor;
+         }
+         isDouble = true;
+      }
+      m_cursor = cursor;
+      if (!isDouble) {
+         ZVAL_LONG(result, negative ? static_cast<zend_long>(0 - value) : static_cast<zend_long>(value));
+         return true;
+      }
+      // the input is not terminated, zend_strtod needs a terminated copy
+      size_t length = static_cast<size_t>(cursor - start);
+      char local[64];
+      if (length < sizeof(local)) {
+         std::memcpy(local, start, length);
+         local[length] = '\0';
+         ZVAL_DOUBLE(result, zend_strtod(local, nullptr));
+      } else {
+         std::string number(start, length);
+         ZVAL_DOUBLE(result, zend_strtod(number.c_str(), nullptr));
+      }
+      return true;
+   }
+
+   // m_cursor is after the opening quote, str points into the input when
+   // there is no escape sequence, otherwise into m_scratch
+   bool parseString(const char *&str, size_t &length)
+   {
+      const char *cursor = m_cursor;
+      const char *run = cursor;
+      bool escaped = false;
+      for (;;) {
+         cursor = find_special(cursor, m_end, '"');
+         if (cursor == m_end) {
+            m_cursor = cursor;
+            return fail(DecodeError::Syntax);
+         }
+         unsigned char c = static_cast<unsigned char>(*cursor);
+         if (c == '"') {
+            if (escaped) {
+               m_scratch.append(run, cursor);
+               str = m_scratch.data();
+               length = m_scratch.length();
+            } else {
+               str = run;
+               length = static_cast<size_t>(cursor - run);
+            }
+            m_cursor = cursor + 1;
+            return true;
+         } else if (c == '\\') {
+            if (!escaped) {
+               m_scratch.assign(run, cursor);
+               escaped = true;
+            } else {
+               m_scratch.append(run, cursor);
+            }
+            if (!parseEscape(cursor)) {
+               return false;
+            }
+            run = cursor;
+         } else if (c < 0x20) {
+            m_cursor = cursor;
+            return fail(DecodeError::ControlCharacter);
+         } else {
+            uint32_t codePoint;
+            size_t sequence = decode_utf8(cursor, m_end, codePoint);
+            if (!sequence) {
+               m_cursor = cursor;
+               return fail(DecodeError::Utf8);
+            }
+            cursor += sequence;
+         }
+      }
+   }
+
+   // cursor is at the backslash, moved after the escape sequence
+   bool parseEscape(const char *&cursor)
+   {
+      if (m_end - cursor < 2) {
+         m_cursor = cursor;
+         return fail(DecodeError::Syntax);
+      }
+      char c = cursor[1];
+      cursor += 2;
+      switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+         m_scratch.push_back(c);
+         return true;
+      case 'b':
+         m_scratch.push_back('\b');
+         return true;
+      case 'f':
+         m_scratch.push_back('\f');
+         return true;
+      case 'n':
+         m_scratch.push_back('\n');
+         return true;
+      case 'r':
+         m_scratch.push_back('\r');
+         return true;
+      case 't':
+         m_scratch.push_back('\t');
+         return true;
+      case 'u':
+         break;
+      default:
+         m_cursor = cursor - 2;
+         return fail(DecodeError::Syntax);
+      }
+      uint32_t unit;
+      if (!read_hex4(cursor, m_end, unit)) {
+         m_cursor = cursor;
+         return fail(DecodeError::Syntax);
+      }
+      cursor += 4;
+      if (unit >= 0xD800 && unit <= 0xDBFF) {
+         uint32_t low;
+         if (m_end - cursor < 6 || cursor[0] != '\\' || cursor[1] != 'u' ||
+             !read_hex4(cursor + 2, m_end, low) || low < 0xDC00 || low > 0xDFFF) {
+            m_cursor = cursor;
+            return fail(DecodeError::Utf16);
+         }
+         cursor += 6;
+         unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+      } else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+         m_cursor = cursor;
+         return fail(DecodeError::Utf16);
+      }
+      append_utf8(m_scratch, unit);
+      return true;
+   }
+
+   // after a value of a container, true when there is another one
+   bool nextItem(char close, bool &more)
+   {
+      m_cursor = skip_whitespace(m_cursor, m_end);
+      if (m_cursor == m_end) {
+         return fail(DecodeError::Syntax);
+      }
+      if (*m_cursor == ',') {
+         m_cursor = skip_whitespace(m_cursor + 1, m_end);
+         more = true;
+         return true;
+      }
+      if (*m_cursor == close) {
+         ++m_cursor;
+         more = false;
+         return true;
+      }
+      return fail(DecodeError::Syntax);
+   }
+
+   bool parseArray(zval *result, uint32_t depth)
+   {
+      if (++depth > m_maxDepth) {
+         return fail(DecodeError::Depth);
+      }
+      m_cursor = skip_whitespace(m_cursor + 1, m_end);
+      array_init(result);
+      if (m_cursor != m_end && *m_cursor == ']') {
+         ++m_cursor;
+         return true;
+      }
+      zend_array *array = Z_ARRVAL_P(result);
+      zend_hash_real_init(array, 1);
+      bool more = true;
+      while (more) {
+         zval item;
+         if (!parseValue(&item, depth)) {
+            zval_ptr_dtor(result);
+            return false;
+         }
+         zend_hash_next_index_insert_new(array, &item);
+         if (!nextItem(']', more)) {
+            zval_ptr_dtor(result);
+            return false;
+         }
+      }
+      return true;
+   }
+
+   bool parseObject(zval *result, uint32_t depth)
+   {
+      if (++depth > m_maxDepth) {
+         return fail(DecodeError::Depth);
+      }
+      m_cursor = skip_whitespace(m_cursor + 1, m_end);
+      array_init(result);
+      if (m_cursor != m_end && *m_cursor == '}') {
+         ++m_cursor;
+         return true;
+      }
+      zend_array *array = Z_ARRVAL_P(result);
+      bool more = true;
+      while (more) {
+         if (m_cursor == m_end || *m_cursor != '"') {
+            zval_ptr_dtor(result);
+            return fail(DecodeError::Syntax);
+         }
+         ++m_cursor;
+         const char *keyStr;
+         size_t keyLength;
+         if (!parseString(keyStr, keyLength)) {
+            zval_ptr_dtor(result);
+            return false;
+         }
+         // the key may live in m_scratch, take it before the value
+         zend_ulong index;
+         zend_string *key = nullptr;
+         if (keyLength == 0 || !ZEND_HANDLE_NUMERIC_STR_EX(keyStr, keyLength, index)) {
+            key = keyLength == 0 ? ZSTR_EMPTY_ALLOC() : m_keys.get(keyStr, keyLength);
+         }
+         m_cursor = skip_whitespace(m_cursor, m_end);
+         if (m_cursor == m_end || *m_cursor != ':') {
+            if (key) {
+               zend_string_release(key);
+            }
+            zval_ptr_dtor(result);
+            return fail(DecodeError::Syntax);
+         }
+         m_cursor = skip_whitespace(m_cursor + 1, m_end);
+         zval item;
+         if (!parseValue(&item, depth)) {
+            if (key) {
+               zend_string_release(key);
+            }
+            zval_ptr_dtor(result);
+            return false;
+         }
+         if (key) {
+            zend_hash_update(array, key, &item);
+            zend_string_release(key);
+         } else {
+            zend_hash_index_update(array, index, &item);
+         }
+         if (!nextItem('}', more)) {
+            zval_ptr_dtor(result);
+            return false;
+         }
+      }
+      return true;
+   }
+
+private:
+   const char *m_begin;
+   const char *m_end;
+   const char *m_cursor;
+   const char *m_errorPos;
+   uint32_t m_maxDepth;
+   DecodeError m_error;
+   JsonKeyCache &m_keys;
+   std::string m_scratch;
+};
+
+bool is_list(zend_array *array)
+{
+   if ((array->u.flags & HASH_FLAG_PACKED) && array->nNumUsed == array->nNumOfElements) {
+      return true;
+   }
+   zend_ulong expected = 0;
+   zend_ulong index;
+   zend_string *key;
+   ZEND_HASH_FOREACH_KEY(array, index, key) {
+      if (key || index != expected) {
+         return false;
+      }
+      ++expected;
+   } ZEND_HASH_FOREACH_END();
+   return true;
+}
+
+} // anonymous namespace
+
+JsonDecoder::JsonDecoder(uint32_t maxDepth)
+   : m_maxDepth(maxDepth),
+     m_error(Error::None),
+     m_errorOffset(0),
+     m_keys(new internal::JsonKeyCache),
+     m_streamOffset(0),
+     m_consumed(0),
+     m_scanned(0),
+     m_finished(false)
+{
+   resetScanState();
+}
+
+JsonDecoder::~JsonDecoder()
+{}
+
+bool JsonDecoder::decode(const char *json, size_t length, Variant &result)
+{
+   m_error = Error::None;
+   m_errorOffset = 0;
+   return parse(json, json + length, 0, result);
+}
+
+bool JsonDecoder::decode(const std::string &json, Variant &result)
+{
+   return decode(json.data(), json.length(), result);
+}
+
+bool JsonDecoder::parse(const char *begin, const char *end, size_t offset, Variant &result)
+{
+   JsonParser parser(begin, end, m_maxDepth, *m_keys);
+   zval value;
+   if (!parser.parse(&value)) {
+      m_error = parser.getError();
+      m_errorOffset = offset + parser.getErrorOffset();
+      return false;
+   }
+   result = Variant(&value);
+   zval_ptr_dtor(&value);
+   return true;
+}
+
+void JsonDecoder::feed(const char *data, size_t length)
+{
+   m_buffer.append(data, length);
+}
+
+void JsonDecoder::feed(const std::string &data)
+{
+   m_buffer.append(data);
+}
+
+void JsonDecoder::finish()
+{
+   m_finished = true;
+}
+
+void JsonDecoder::reset()
+{
+   m_error = Error::None;
+   m_errorOffset = 0;
+   m_keys->clear();
+   m_buffer.clear();
+   m_streamOffset = 0;
+   m_consumed = 0;
+   m_scanned = 0;
+   m_finished = false;
+   resetScanState();
+}
+
+void JsonDecoder::resetScanState() ZAPI_DECL_NOEXCEPT
+{
+   m_scanDepth = 0;
+   m_valueStarted = false;
+   m_inScalar = false;
+   m_inString = false;
+   m_escaped = false;
+}
+
+bool JsonDecoder::next(Variant &result)
+{
+   if (m_error != Error::None) {
+      return false;
+   }
+   size_t boundary;
+   if (!scanValueEnd(boundary)) {
+      if (!m_finished || !m_valueStarted) {
+         return false;
+      }
+      // a scalar is only closed by the end of the stream
+      if (!m_inScalar) {
+         m_error = Error::Incomplete;
+         m_errorOffset = m_streamOffset + m_buffer.length();
+         return false;
+      }
+      boundary = m_buffer.length();
+   }
+   const char *data = m_buffer.data();
+   bool status = parse(data + m_consumed, data + boundary, m_streamOffset + m_consumed, result);
+   m_consumed = boundary;
+   m_scanned = boundary;
+   resetScanState();
+   // drop the consumed bytes once they are the larger part of the buffer
+   if (m_consumed >= 4096 && m_consumed * 2 >= m_buffer.length()) {
+      m_buffer.erase(0, m_consumed);
+      m_streamOffset += m_consumed;
+      m_scanned -= m_consumed;
+      m_consumed = 0;
+   }
+   return status;
+}
+
+/**
+ * Track strings and brackets from where the last call stopped until the
+ * current top-level value is closed, boundary is the offset after it
+ */
+bool JsonDecoder::scanValueEnd(size_t &boundary)
+{
+   const char *begin = m_buffer.data();
+   const char *end = begin + m_buffer.length();
+   const char *cursor = begin + m_scanned;
+   while (cursor < end) {
+      if (m_inString) {
+         if (m_escaped) {
+            m_escaped = false;
+            ++cursor;
+            continue;
+         }
+         cursor = find_special(cursor, end, '"');
+         if (cursor == end) {
+            break;
+         }
+         char c = *cursor++;
+         if (c == '\\') {
+            m_escaped = true;
+         } else if (c == '"') {
+            m_inString = false;
+            if (m_scanDepth == 0) {
+               boundary = static_cast<size_t>(cursor - begin);
+               return true;
+            }
+         }
+         continue;
+      }
+      if (!m_valueStarted) {
+         cursor = skip_whitespace(cursor, end);
+         if (cursor == end) {
+            break;
+         }
+         m_valueStarted = true;
+      }
+      char c = *cursor;
+      if (m_inScalar) {
+         if (is_json_space(c) || c == '"' || c == '[' || c == '{' || c == ']' || c == '}') {
+            boundary = static_cast<size_t>(cursor - begin);
+            return true;
+         }
+         ++cursor;
+         continue;
+      }
+      ++cursor;
+      switch (c) {
+      case '"':
+         m_inString = true;
+         break;
+      case '[':
+      case '{':
+         ++m_scanDepth;
+         break;
+      case ']':
+      case '}':
+         // a stray bracket closes the value, the parser reports it
+         if (m_scanDepth <= 1) {
+            boundary = static_cast<size_t>(cursor - begin);
+            return true;
+         }
+         --m_scanDepth;
+         break;
+      default:
+         if (m_scanDepth == 0) {
+            m_inScalar = true;
+         }
+         break;
+      }
+   }
+   m_scanned = static_cast<size_t>(cursor - begin);
+   return false;
+}
+
+JsonEncoder::JsonEncoder(uint32_t options, uint32_t maxDepth)
+   : m_options(options),
+     m_maxDepth(maxDepth),
+     m_error(Error::None),
+     m_serializableEntry(nullptr)
+{}
+
+bool JsonEncoder::encode(const Variant &value, smart_str &buffer)
+{
+   m_error = Error::None;
+   m_serializableEntry = static_cast<zend_class_entry *>(
+            zend_hash_str_find_ptr(CG(class_table), "jsonserializable", sizeof("jsonserializable") - 1));
+   size_t length = buffer.s ? ZSTR_LEN(buffer.s) : 0;
+   if (!encodeValue(&buffer, const_cast<zval *>(value.getZvalPtr()), 0)) {
+      if (buffer.s) {
+         ZSTR_LEN(buffer.s) = length;
+      }
+      return false;
+   }
+   return true;
+}
+
+bool JsonEncoder::encode(const Variant &value, std::string &json)
+{
+   smart_str buffer = {0};
+   bool status = encode(value, buffer);
+   if (status && buffer.s) {
+      json.assign(ZSTR_VAL(buffer.s), ZSTR_LEN(buffer.s));
+   } else if (status) {
+      json.clear();
+   }
+   smart_str_free(&buffer);
+   return status;
+}
+
+Variant JsonEncoder::encode(const Variant &value)
+{
+   smart_str buffer = {0};
+   if (!encode(value, buffer)) {
+      smart_str_free(&buffer);
+      return Variant(false);
+   }
+   smart_str_0(&buffer);
+   zval json;
+   if (buffer.s) {
+      ZVAL_NEW_STR(&json, buffer.s);
+   } else {
+      ZVAL_EMPTY_STRING(&json);
+   }
+   Variant result(&json);
+   zval_ptr_dtor(&json);
+   return result;
+}
+
+bool JsonEncoder::encodeValue(smart_str *buffer, zval *value, uint32_t depth)
+{
+   ZVAL_DEREF(value);
+   switch (Z_TYPE_P(value)) {
+   case IS_NULL:
+      smart_str_appendl(buffer, "null", 4);
+      return true;
+   case IS_TRUE:
+      smart_str_appendl(buffer, "true", 4);
+      return true;
+   case IS_FALSE:
+      smart_str_appendl(buffer, "false", 5);
+      return true;
+   case IS_LONG:
+      smart_str_append_long(buffer, Z_LVAL_P(value));
+      return true;
+   case IS_DOUBLE:
+      if (!zend_finite(Z_DVAL_P(value)) || zend_isnan(Z_DVAL_P(value))) {
+         return fail(Error::InfOrNan);
+      }
+      encodeDouble(buffer, Z_DVAL_P(value));
+      return true;
+   case IS_STRING:
+      return encodeString(buffer, Z_STRVAL_P(value), Z_STRLEN_P(value));
+   case IS_ARRAY: {
+      zend_array *array = Z_ARRVAL_P(value);
+      return encodeArray(buffer, array, !is_list(array), false, depth);
+   }
+   case IS_OBJECT:
+      if (Z_OBJ_APPLY_COUNT_P(value) > 0) {
+         return fail(Error::Recursion);
+      }
+      if (m_serializableEntry && instanceof_function(Z_OBJCE_P(value), m_serializableEntry)) {
+         return encodeSerializable(buffer, value, depth);
+      }
+      return encodeObject(buffer, value, depth);
+   default:
+      return fail(Error::UnsupportedType);
+   }
+}
+
+bool JsonEncoder::encodeObject(smart_str *buffer, zval *object, uint32_t depth)
+{
+   zend_array *properties = Z_OBJPROP_P(object);
+   if (!properties) {
+      smart_str_appendl(buffer, "{}", 2);
+      return true;
+   }
+   Z_OBJ_INC_APPLY_COUNT_P(object);
+   bool status = encodeArray(buffer, properties, true, true, depth);
+   Z_OBJ_DEC_APPLY_COUNT_P(object);
+   return status;
+}
+
+bool JsonEncoder::encodeSerializable(smart_str *buffer, zval *object, uint32_t depth)
+{
+   zval retval;
+   ZVAL_UNDEF(&retval);
+   Z_OBJ_INC_APPLY_COUNT_P(object);
+   zend_call_method_with_0_params(object, Z_OBJCE_P(object), nullptr, "jsonserialize", &retval);
+   Z_OBJ_DEC_APPLY_COUNT_P(object);
+   bool status;
+   if (EG(exception) || Z_ISUNDEF(retval)) {
+      status = fail(Error::SerializeFailed);
+   } else if (Z_TYPE(retval) == IS_OBJECT && Z_OBJ(retval) == Z_OBJ_P(object)) {
+      // return $this encodes the properties, the same as json_encode()
+      status = encodeObject(buffer, object, depth);
+   } else {
+      Z_OBJ_INC_APPLY_COUNT_P(object);
+      status = encodeValue(buffer, &retval, depth);
+      Z_OBJ_DEC_APPLY_COUNT_P(object);
+   }
+   zval_ptr_dtor(&retval);
+   return status;
+}
+
+bool JsonEncoder::encodeArray(smart_str *buffer, zend_array *array, bool asObject, bool publicOnly, uint32_t depth)
+{
+   if (zend_hash_num_elements(array) == 0) {
+      smart_str_appendl(buffer, asObject ? "{}" : "[]", 2);
+      return true;
+   }
+   if (++depth > m_maxDepth) {
+      return fail(Error::Depth);
+   }
+   // immutable arrays can't contain themselves
+   bool guarded = ZEND_HASH_APPLY_PROTECTION(array) && !(GC_FLAGS(array) & IS_ARRAY_IMMUTABLE);
+   if (guarded) {
+      if (ZEND_HASH_GET_APPLY_COUNT(array) > 0) {
+         return fail(Error::Recursion);
+      }
+      ZEND_HASH_INC_APPLY_COUNT(array);
+   }
+   bool pretty = m_options & PrettyPrint;
+   bool status = true;
+   bool first = true;
+   smart_str_appendc(buffer, asObject ? '{' : '[');
+   zend_ulong index;
+   zend_string *key;
+   zval *item;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(array, index, key, item) {
+      // the mangled names of protected and private properties
+      if (publicOnly && key && ZSTR_LEN(key) > 0 && ZSTR_VAL(key)[0] == '\0') {
+         continue;
+      }
+      if (!first) {
+         smart_str_appendc(buffer, ',');
+      }
+      first = false;
+      if (pretty) {
+         appendNewline(buffer, depth);
+      }
+      if (asObject) {
+         if (key) {
+            if (!encodeString(buffer, ZSTR_VAL(key), ZSTR_LEN(key))) {
+               status = false;
+               break;
+            }
+         } else {
+            smart_str_appendc(buffer, '"');
+            smart_str_append_long(buffer, static_cast<zend_long>(index));
+            smart_str_appendc(buffer, '"');
+         }
+         smart_str_appendc(buffer, ':');
+         if (pretty) {
+            smart_str_appendc(buffer, ' ');
+         }
+      }
+      if (!encodeValue(buffer, item, depth)) {
+         status = false;
+         break;
+      }
+   } ZEND_HASH_FOREACH_END();
+   if (guarded) {
+      ZEND_HASH_DEC_APPLY_COUNT(array);
+   }
+   if (!status) {
+      return false;
+   }
+   if (pretty && !first) {
+      appendNewline(buffer, depth - 1);
+   }
+   smart_str_appendc(buffer, asObject ? '}' : ']');
+   return true;
+}
+
+bool JsonEncoder::encodeString(smart_str *buffer, const char *str, size_t length)
+{
+   const char *cursor = str;
+   const char *end = str + length;
+   // '"' again when the slashes are not escaped, it changes nothing
+   char extra = (m_options & UnescapedSlashes) ? '"' : '/';
+   bool escapeUnicode = !(m_options & UnescapedUnicode);
+   smart_str_alloc(buffer, length + 2, 0);
+   smart_str_appendc(buffer, '"');
+   while (cursor < end) {
+      const char *run = cursor;
+      cursor = find_special(cursor, end, extra);
+      if (cursor != run) {
+         smart_str_appendl(buffer, run, static_cast<size_t>(cursor - run));
+      }
+      if (cursor == end) {
+         break;
+      }
+      unsigned char c = static_cast<unsigned char>(*cursor);
+      if (c < 0x80) {
+         ++cursor;
+         switch (c) {
+         case '"':
+            smart_str_appendl(buffer, "\\\"", 2);
+            break;
+         case '\\':
+            smart_str_appendl(buffer, "\\\\", 2);
+            break;
+         case '/':
+            smart_str_appendl(buffer, "\\/", 2);
+            break;
+         case '\b':
+            smart_str_appendl(buffer, "\\b", 2);
+            break;
+         case '\f':
+            smart_str_appendl(buffer, "\\f", 2);
+            break;
+         case '\n':
+            smart_str_appendl(buffer, "\\n", 2);
+            break;
+         case '\r':
+            smart_str_appendl(buffer, "\\r", 2);
+            break;
+         case '\t':
+            smart_str_appendl(buffer, "\\t", 2);
+            break;
+         default: {
+            char escape[6] = {'\\', 'u', '0', '0', json_hex_digits[c >> 4], json_hex_digits[c & 0x0F]};
+            smart_str_appendl(buffer, escape, sizeof(escape));
+            break;
+         }
+         }
+         continue;
+      }
+      uint32_t codePoint;
+      size_t sequence = decode_utf8(cursor, end, codePoint);
+      if (!sequence) {
+         return fail(Error::Utf8);
+      }
+      // U+2028 and U+2029 are line terminators for javascript
+      if (!escapeUnicode && codePoint != 0x2028 && codePoint != 0x2029) {
+         smart_str_appendl(buffer, cursor, sequence);
+      } else {
+         uint32_t units[2];
+         int count = 1;
+         if (codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            units[0] = 0xD800 | (codePoint >> 10);
+            units[1] = 0xDC00 | (codePoint & 0x3FF);
+            count = 2;
+         } else {
+            units[0] = codePoint;
+         }
+         for (int i = 0; i < count; ++i) {
+            char escape[6] = {'\\', 'u',
+                              json_hex_digits[(units[i] >> 12) & 0x0F], json_hex_digits[(units[i] >> 8) & 0x0F],
+                              json_hex_digits[(units[i] >> 4) & 0x0F], json_hex_digits[units[i] & 0x0F]};
+            smart_str_appendl(buffer, escape, sizeof(escape));
+         }
+      }
+      cursor += sequence;
+   }
+   smart_str_appendc(buffer, '"');
+   return true;
+}
+
+void JsonEncoder::encodeDouble(smart_str *buffer, double value)
+{
+   char number[NUM_BUF_SIZE];
+#if PHP_VERSION_ID >= 70100
+   php_gcvt(value, static_cast<int>(PG(serialize_precision)), '.', 'e', number);
+#else
+   php_gcvt(value, static_cast<int>(EG(precision)), '.', 'e', number);
+#endif
+   size_t length = std::strlen(number);
+   smart_str_appendl(buffer, number, length);
+   if ((m_options & PreserveZeroFraction) && !std::strchr(number, '.')) {
+      smart_str_appendl(buffer, ".0", 2);
+   }
+}
+
+void JsonEncoder::appendNewline(smart_str *buffer, uint32_t depth)
+{
+   smart_str_appendc(buffer, '\n');
+   for (uint32_t i = 0; i < depth; ++i) {
+      smart_str_appendl(buffer, "    ", 4);
+   }
+}
+
+} // ds
+} // zapi
@@ -14,9 +14,11 @@
 // Created by softboy on 2017/08/21.
 
 #include "zapi/lang/StdClass.h"
+#include "zapi/lang/ClassRef.h"
 #include "zapi/lang/internal/StdClassPrivate.h"
 #include "zapi/vm/internal/AbstractClassPrivate.h"
 #include "zapi/vm/ObjectBinder.h"
+#include "zapi/vm/InvokeBridge.h"
 #include "zapi/ds/ObjectVariant.h"
 #include "zapi/utils/CommonFuncs.h"
 #include "zapi/kernel/Exception.h"
@@ -24,10 +26,15 @@
 #include "zapi/kernel/FatalError.h"
 #include "php/Zend/zend_closures.h"
 #include <ostream>
+#include <cstring>
+#include <algorithm>
 
 using zapi::ds::Variant;
 using zapi::kernel::Exception;
 using zapi::kernel::OrigException;
+using zapi::lang::StdClass;
+using zapi::vm::ObjectBinder;
+using zapi::vm::DirectInvokeCallable;
 
 namespace
 {
@@ -58,6 +65,51 @@ Variant do_execute(const zval *object, zval *method, int argc, zval *argv)
       return result;
    }
 }
+
+// public native member methods are called through their InvokeBridge
+// without a VM frame, userland overrides, __call, by reference and type
+// hinted parameters are left to call_user_function_ex
+bool direct_execute(const zval *object, const char *name, int argc, Variant *argv, Variant &result)
+{
+   char lcName[64];
+   size_t length = std::strlen(name);
+   if (Z_TYPE_P(object) != IS_OBJECT || length >= sizeof(lcName) || EG(exception)) {
+      return false;
+   }
+   zend_str_tolower_copy(lcName, name, length);
+   zend_object *zobject = Z_OBJ_P(object);
+   zend_function *func = reinterpret_cast<zend_function *>(
+            zend_hash_str_find_ptr(&zobject->ce->function_table, lcName, length));
+   if (!func || func->type != ZEND_INTERNAL_FUNCTION ||
+       (func->common.fn_flags & (ZEND_ACC_PPP_MASK | ZEND_ACC_STATIC | ZEND_ACC_ABSTRACT |
+                                 ZEND_ACC_DEPRECATED | ZEND_ACC_HAS_TYPE_HINTS)) != ZEND_ACC_PUBLIC ||
+       static_cast<uint32_t>(argc) < func->common.required_num_args) {
+      return false;
+   }
+   DirectInvokeCallable direct = zapi::vm::find_direct_invoke(func->internal_function.handler);
+   if (!direct) {
+      return false;
+   }
+   uint32_t checkedArgs = std::min(static_cast<uint32_t>(argc), func->common.num_args);
+   for (uint32_t i = 0; i < checkedArgs; ++i) {
+      if (func->common.arg_info[i].pass_by_reference) {
+         return false;
+      }
+   }
+   StdClass *nativeObject = ObjectBinder::retrieveSelfPtr(zobject)->getNativeObject();
+   zval retval;
+   ZVAL_NULL(&retval);
+   if (!direct(nativeObject, func, argc, argv, &retval)) {
+      return false;
+   }
+   if (EG(exception)) {
+      zval_ptr_dtor(&retval);
+      throw OrigException(EG(exception));
+   }
+   result = Variant(&retval);
+   zval_ptr_dtor(&retval);
+   return true;
+}
 }
 
 namespace zapi
@@ -98,10 +150,13 @@ ObjectVariant::ObjectVariant(const std::string &className, std::shared_ptr<StdCl
 {
    zend_object *zobject = nativeObject->m_implPtr->m_zendObject;
    if (!zobject) {
-      // new construct
-      zend_string *clsName = zend_string_init(className.c_str(), className.length(), 0);
-      zend_class_entry *entry = zend_fetch_class(clsName, ZEND_FETCH_CLASS_SILENT);
-      zend_string_free(clsName);
+      // new construct, the autoloader only runs for the unknown names
+      zend_class_entry *entry = ClassRef::lookup(className.c_str(), className.length());
+      if (!entry) {
+         zend_string *clsName = zend_string_init(className.c_str(), className.length(), 0);
+         entry = zend_fetch_class(clsName, ZEND_FETCH_CLASS_SILENT);
+         zend_string_free(clsName);
+      }
       if (!entry) {
          throw zapi::kernel::FatalError(std::string("Unknown class name ") + className);
       }
@@ -129,6 +184,24 @@ ObjectVariant::ObjectVariant(zend_class_entry *entry, std::shared_ptr<StdClass>
    Z_ADDREF_P(self);
 }
 
+ObjectVariant::ObjectVariant(const ClassRef &classRef, std::shared_ptr<StdClass> nativeObject)
+{
+   zend_object *zobject = nativeObject->m_implPtr->m_zendObject;
+   if (!zobject) {
+      // new construct
+      zend_class_entry *entry = classRef.getEntry();
+      if (!entry) {
+         throw zapi::kernel::FatalError(std::string("Unknown class name ") + classRef.getName());
+      }
+      ObjectBinder *binder = new ObjectBinder(entry, nativeObject,
+                                              AbstractClassPrivate::getObjectHandlers(entry), 0);
+      zobject = binder->getZendObject();
+   }
+   zval *self = getUnDerefZvalPtr();
+   ZVAL_OBJ(self, zobject);
+   Z_ADDREF_P(self);
+}
+
 ObjectVariant::ObjectVariant(Variant &&other)
    : Variant(std::move(other))
 {
@@ -302,6 +375,10 @@ Variant ObjectVariant::call(const char *name)
 
 Variant ObjectVariant::call(const char *name) const
 {
+   Variant result;
+   if (direct_execute(getZvalPtr(), name, 0, nullptr, result)) {
+      return result;
+   }
    Variant method(name);
    return do_execute(getZvalPtr(), method.getZvalPtr(), 0, nullptr);
 }
@@ -312,9 +389,7 @@ bool ObjectVariant::instanceOf(const char *className, size_t size) const
    if (!thisClsEntry) {
       return false;
    }
-   GuardStrType clsName(zend_string_init(className, size, 0),
-                        zapi::utils::std_zend_string_force_deleter);
-   zend_class_entry *clsEntry = zend_lookup_class_ex(clsName.get(), nullptr, 0);
+   zend_class_entry *clsEntry = ClassRef::lookup(className, size);
    if (!clsEntry) {
       return false;
    }
@@ -344,15 +419,23 @@ bool ObjectVariant::instanceOf(const ObjectVariant &other) const
    return instanceof_function(thisClsEntry, clsEntry);
 }
 
+bool ObjectVariant::instanceOf(const ClassRef &classRef) const
+{
+   zend_class_entry *thisClsEntry = Z_OBJCE_P(getUnDerefZvalPtr());
+   zend_class_entry *clsEntry = classRef.getEntry();
+   if (!thisClsEntry || !clsEntry) {
+      return false;
+   }
+   return instanceof_function(thisClsEntry, clsEntry);
+}
+
 bool ObjectVariant::derivedFrom(const char *className, size_t size) const
 {
    zend_class_entry *thisClsEntry = Z_OBJCE_P(getUnDerefZvalPtr());
    if (!thisClsEntry) {
       return false;
    }
-   GuardStrType clsName(zend_string_init(className, size, 0),
-                        zapi::utils::std_zend_string_force_deleter);
-   zend_class_entry *clsEntry = zend_lookup_class_ex(clsName.get(), nullptr, 0);
+   zend_class_entry *clsEntry = ClassRef::lookup(className, size);
    if (!clsEntry) {
       return false;
    }
@@ -388,6 +471,19 @@ bool ObjectVariant::derivedFrom(const ObjectVariant &other) const
    return instanceof_function(thisClsEntry, clsEntry);
 }
 
+bool ObjectVariant::derivedFrom(const ClassRef &classRef) const
+{
+   zend_class_entry *thisClsEntry = Z_OBJCE_P(getUnDerefZvalPtr());
+   zend_class_entry *clsEntry = classRef.getEntry();
+   if (!thisClsEntry || !clsEntry) {
+      return false;
+   }
+   if (thisClsEntry == clsEntry) {
+      return false;
+   }
+   return instanceof_function(thisClsEntry, clsEntry);
+}
+
 ObjectVariant::ObjectVariant(StdClass *nativeObject)
 {
    zend_object *zobject = nativeObject->m_implPtr->m_zendObject;
@@ -403,6 +499,10 @@ Variant ObjectVariant::exec(const char *name, int argc, Variant *argv)
 
 Variant ObjectVariant::exec(const char *name, int argc, Variant *argv) const
 {
+   Variant result;
+   if (direct_execute(getZvalPtr(), name, argc, argv, result)) {
+      return result;
+   }
    Variant methodName(name);
    std::unique_ptr<zval[]> params(new zval[argc]);
    zval *curArgPtr = nullptr;
@@ -0,0 +1,203 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/ds/PersistentArray.h"
+#include "zapi/ds/ArrayVariant.h"
+#include "zapi/utils/InternalFuncs.h"
+#include <utility>
+
+namespace zapi
+{
+namespace ds
+{
+
+namespace
+{
+
+zend_array *persistent_array_copy(zend_array *source);
+
+zend_string *persistent_interned_string(zend_string *str)
+{
+#ifndef ZAPI_ZTS_NO_INTERNING
+   // interned strings that created at startup are permanent
+   if (ZSTR_IS_INTERNED(str)) {
+      return str;
+   }
+#endif
+   // without interning every string is a copy of our own, so the array
+   // can free them all
+   return zapi::internal::new_permanent_string(ZSTR_VAL(str), ZSTR_LEN(str));
+}
+
+void init_immutable_zval(zval *target, zend_array *array)
+{
+   ZVAL_ARR(target, array);
+#ifdef IS_TYPE_IMMUTABLE
+   Z_TYPE_FLAGS_P(target) = IS_TYPE_IMMUTABLE;
+#else
+   Z_TYPE_FLAGS_P(target) = IS_TYPE_COPYABLE;
+#endif
+}
+
+void persistent_value_copy(zval *target, zval *value)
+{
+   ZVAL_DEREF(value);
+   switch (Z_TYPE_P(value)) {
+   case IS_NULL:
+   case IS_FALSE:
+   case IS_TRUE:
+   case IS_LONG:
+   case IS_DOUBLE:
+      ZVAL_COPY_VALUE(target, value);
+      break;
+   case IS_STRING:
+      ZVAL_INTERNED_STR(target, persistent_interned_string(Z_STR_P(value)));
+      break;
+   case IS_ARRAY: {
+      zend_array *array = Z_ARRVAL_P(value);
+      if (ZEND_HASH_APPLY_PROTECTION(array) && ZEND_HASH_GET_APPLY_COUNT(array) > 0) {
+         zapi::warning << "Recursive array can't be stored in a persistent array, null is used" << std::endl;
+         ZVAL_NULL(target);
+         break;
+      }
+      if (ZEND_HASH_APPLY_PROTECTION(array)) {
+         ZEND_HASH_INC_APPLY_COUNT(array);
+      }
+      init_immutable_zval(target, persistent_array_copy(array));
+      if (ZEND_HASH_APPLY_PROTECTION(array)) {
+         ZEND_HASH_DEC_APPLY_COUNT(array);
+      }
+      break;
+   }
+   default:
+      zapi::warning << "Objects and resources can't be stored in a persistent array, null is used" << std::endl;
+      ZVAL_NULL(target);
+      break;
+   }
+}
+
+zend_array *persistent_array_copy(zend_array *source)
+{
+   uint32_t size = zend_hash_num_elements(source);
+   zend_array *target = static_cast<zend_array *>(pemalloc(sizeof(zend_array), 1));
+   zend_hash_init(target, size, nullptr, ZVAL_PTR_DTOR, 1);
+   zend_hash_real_init(target, (source->u.flags & HASH_FLAG_PACKED) != 0);
+   zapi_ulong index;
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_KEY_VAL_IND(source, index, key, value) {
+      zval item;
+      persistent_value_copy(&item, value);
+      if (key) {
+         zend_hash_add_new(target, persistent_interned_string(key), &item);
+      } else {
+         zend_hash_index_add_new(target, index, &item);
+      }
+   } ZEND_HASH_FOREACH_END();
+   // the same flags that opcache set on the arrays it stores, the refcount
+   // of 2 makes every write separate the array
+   GC_REFCOUNT(target) = 2;
+   GC_FLAGS(target) |= IS_ARRAY_IMMUTABLE;
+   target->u.flags |= HASH_FLAG_STATIC_KEYS;
+#ifdef HASH_FLAG_APPLY_PROTECTION
+   target->u.flags &= ~HASH_FLAG_APPLY_PROTECTION;
+#endif
+   return target;
+}
+
+void persistent_array_destroy(zend_array *array)
+{
+   zend_string *key;
+   zval *value;
+   ZEND_HASH_FOREACH_STR_KEY_VAL(array, key, value) {
+      if (key) {
+         zapi::internal::free_permanent_string(key);
+      }
+      if (Z_TYPE_P(value) == IS_ARRAY) {
+         persistent_array_destroy(Z_ARRVAL_P(value));
+      } else if (Z_TYPE_P(value) == IS_STRING) {
+         zapi::internal::free_permanent_string(Z_STR_P(value));
+      }
+   } ZEND_HASH_FOREACH_END();
+   // the values are not refcounted, the keys are static
+   array->pDestructor = nullptr;
+   zend_hash_destroy(array);
+   pefree(array, 1);
+}
+
+} // anonymous namespace
+
+PersistentArray::PersistentArray()
+   : m_array(nullptr)
+{}
+
+PersistentArray::PersistentArray(const ArrayVariant &source)
+   : m_array(nullptr)
+{
+   if (EG(active)) {
+      // the interned strings that created in a request are released at
+      // the request end
+      zapi::warning << "Persistent array can only be built at module startup" << std::endl;
+      return;
+   }
+   m_array = persistent_array_copy(Z_ARRVAL_P(source.getZvalPtr()));
+}
+
+PersistentArray::PersistentArray(PersistentArray &&other) ZAPI_DECL_NOEXCEPT
+   : m_array(other.m_array)
+{
+   other.m_array = nullptr;
+}
+
+PersistentArray &PersistentArray::operator =(PersistentArray &&other) ZAPI_DECL_NOEXCEPT
+{
+   assert(this != &other);
+   std::swap(m_array, other.m_array);
+   return *this;
+}
+
+PersistentArray::~PersistentArray()
+{
+   if (m_array) {
+      persistent_array_destroy(m_array);
+   }
+}
+
+void PersistentArray::copyTo(zval *target) const ZAPI_DECL_NOEXCEPT
+{
+   if (m_array) {
+      init_immutable_zval(target, m_array);
+   } else {
+      array_init(target);
+   }
+}
+
+ArrayVariant PersistentArray::toArray() const
+{
+   zval value;
+   copyTo(&value);
+   ArrayVariant array(&value);
+   // for an immutable array it is a no-op
+   zval_ptr_dtor(&value);
+   return array;
+}
+
+PersistentArray::operator ArrayVariant() const
+{
+   return toArray();
+}
+
+} // ds
+} // zapi
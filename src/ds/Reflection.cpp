@@ -0,0 +1,72 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/ds/Reflection.h"
+#include <cstring>
+
+namespace zapi
+{
+namespace ds
+{
+namespace internal
+{
+
+namespace
+{
+// the request keys built by the current thread
+ZAPI_THREAD_LOCAL std::vector<StructKeys *> request_struct_keys;
+} // anonymous namespace
+
+std::vector<ArrayKey> make_struct_keys(const char *const *names, size_t count)
+{
+   std::vector<ArrayKey> keys;
+   keys.reserve(count);
+   for (size_t i = 0; i < count; ++i) {
+      keys.emplace_back(names[i], std::strlen(names[i]));
+   }
+   return keys;
+}
+
+const std::vector<ArrayKey> &get_struct_keys(StructKeys &keys, StructKeys &threadKeys,
+                                             const char *const *names, size_t count)
+{
+   if (keys.permanent) {
+      return *keys.permanent;
+   }
+   if (!EG(active)) {
+      // the interned strings are gone before the static destructors run,
+      // so the permanent keys are never released
+      keys.permanent = new std::vector<ArrayKey>(make_struct_keys(names, count));
+      return *keys.permanent;
+   }
+   if (!threadKeys.request) {
+      threadKeys.request = new std::vector<ArrayKey>(make_struct_keys(names, count));
+      request_struct_keys.push_back(&threadKeys);
+   }
+   return *threadKeys.request;
+}
+
+void release_struct_keys()
+{
+   for (StructKeys *keys : request_struct_keys) {
+      delete keys->request;
+      keys->request = nullptr;
+   }
+   request_struct_keys.clear();
+}
+
+} // internal
+} // ds
+} // zapi
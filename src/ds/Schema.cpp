@@ -0,0 +1,444 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/ds/Schema.h"
+#include "zapi/ds/ArrayVariant.h"
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace zapi
+{
+namespace ds
+{
+
+namespace
+{
+
+using ValueType = Schema::ValueType;
+
+zval *find_option(zend_array *description, const char *name)
+{
+   zval *value = zend_hash_str_find(description, name, std::strlen(name));
+   if (value) {
+      ZVAL_DEREF(value);
+   }
+   return value;
+}
+
+ValueType parse_value_type(zval *type)
+{
+   if (!type) {
+      return ValueType::Any;
+   }
+   if (Z_TYPE_P(type) == IS_STRING) {
+      zend_string *name = Z_STR_P(type);
+      if (zend_string_equals_literal(name, "any")) {
+         return ValueType::Any;
+      } else if (zend_string_equals_literal(name, "null")) {
+         return ValueType::Null;
+      } else if (zend_string_equals_literal(name, "bool")) {
+         return ValueType::Bool;
+      } else if (zend_string_equals_literal(name, "int")) {
+         return ValueType::Long;
+      } else if (zend_string_equals_literal(name, "float")) {
+         return ValueType::Double;
+      } else if (zend_string_equals_literal(name, "number")) {
+         return ValueType::Number;
+      } else if (zend_string_equals_literal(name, "string")) {
+         return ValueType::String;
+      } else if (zend_string_equals_literal(name, "array")) {
+         return ValueType::Array;
+      } else if (zend_string_equals_literal(name, "list")) {
+         return ValueType::List;
+      }
+   }
+   zapi::warning << "Unknown schema type, any value is accepted" << std::endl;
+   return ValueType::Any;
+}
+
+bool is_option_true(zend_array *description, const char *name)
+{
+   zval *value = find_option(description, name);
+   return value && zend_is_true(value);
+}
+
+Schema::Node parse_node(zval *description)
+{
+   ZVAL_DEREF(description);
+   if (Z_TYPE_P(description) != IS_ARRAY) {
+      zapi::warning << "Schema description must be an array, any value is accepted" << std::endl;
+      return Schema::Node();
+   }
+   zend_array *options = Z_ARRVAL_P(description);
+   Schema::Node node(parse_value_type(find_option(options, "type")));
+   node.setNullable(is_option_true(options, "nullable"));
+   node.setStrict(is_option_true(options, "strict"));
+   zval *option;
+   if ((option = find_option(options, "min"))) {
+      node.setMin(zval_get_double(option));
+   }
+   if ((option = find_option(options, "max"))) {
+      node.setMax(zval_get_double(option));
+   }
+   if ((option = find_option(options, "minLength"))) {
+      node.setMinLength(static_cast<uint32_t>(zval_get_long(option)));
+   }
+   if ((option = find_option(options, "maxLength"))) {
+      node.setMaxLength(static_cast<uint32_t>(zval_get_long(option)));
+   }
+   if ((option = find_option(options, "items"))) {
+      node.setItems(parse_node(option));
+   }
+   option = find_option(options, "fields");
+   if (option && Z_TYPE_P(option) == IS_ARRAY) {
+      zend_ulong index;
+      zend_string *key;
+      zval *field;
+      ZEND_HASH_FOREACH_KEY_VAL_IND(Z_ARRVAL_P(option), index, key, field) {
+         std::string name = key ? std::string(ZSTR_VAL(key), ZSTR_LEN(key)) : std::to_string(index);
+         ZVAL_DEREF(field);
+         bool required = Z_TYPE_P(field) == IS_ARRAY && is_option_true(Z_ARRVAL_P(field), "required");
+         node.addField(name, parse_node(field), required);
+      } ZEND_HASH_FOREACH_END();
+   }
+   return node;
+}
+
+// the field names that look like integers are integer keys in the payload
+ArrayKey make_field_key(const std::string &name)
+{
+   zend_ulong index;
+   if (ZEND_HANDLE_NUMERIC_STR(name.c_str(), name.length(), index)) {
+      return ArrayKey(index);
+   }
+   if (!EG(active)) {
+      // compiled at MINIT, the key goes to the permanent interned table
+      return ArrayKey(name);
+   }
+   // a schema may be kept beyond the request that compiled it, but the
+   // strings interned during a request are freed at its end, so the key
+   // is a plain persistent string. It is only used for lookups.
+   zend_string *key = zend_string_init(name.c_str(), name.length(), 1);
+   ArrayKey result(key);
+   zend_string_release(key);
+   return result;
+}
+
+bool is_list(zend_array *array)
+{
+   if ((array->u.flags & HASH_FLAG_PACKED) && array->nNumUsed == array->nNumOfElements) {
+      return true;
+   }
+   zend_ulong expected = 0;
+   zend_ulong index;
+   zend_string *key;
+   ZEND_HASH_FOREACH_KEY(array, index, key) {
+      if (key || index != expected) {
+         return false;
+      }
+      ++expected;
+   } ZEND_HASH_FOREACH_END();
+   return true;
+}
+
+} // anonymous namespace
+
+Schema::Node::Node(ValueType type)
+   : m_type(type),
+     m_nullable(false),
+     m_strict(false),
+     m_hasMin(false),
+     m_hasMax(false),
+     m_min(0),
+     m_max(0),
+     m_minLength(0),
+     m_maxLength(std::numeric_limits<uint32_t>::max())
+{}
+
+Schema::Node &Schema::Node::setNullable(bool nullable)
+{
+   m_nullable = nullable;
+   return *this;
+}
+
+Schema::Node &Schema::Node::setStrict(bool strict)
+{
+   m_strict = strict;
+   return *this;
+}
+
+Schema::Node &Schema::Node::setMin(double min)
+{
+   m_hasMin = true;
+   m_min = min;
+   return *this;
+}
+
+Schema::Node &Schema::Node::setMax(double max)
+{
+   m_hasMax = true;
+   m_max = max;
+   return *this;
+}
+
+Schema::Node &Schema::Node::setMinLength(uint32_t length)
+{
+   m_minLength = length;
+   return *this;
+}
+
+Schema::Node &Schema::Node::setMaxLength(uint32_t length)
+{
+   m_maxLength = length;
+   return *this;
+}
+
+Schema::Node &Schema::Node::addField(const std::string &name, const Node &node, bool required)
+{
+   m_fields.push_back(Field{name, std::make_shared<Node>(node), required});
+   return *this;
+}
+
+Schema::Node &Schema::Node::setItems(const Node &node)
+{
+   m_items = std::make_shared<Node>(node);
+   return *this;
+}
+
+Schema::Schema()
+{}
+
+Schema::Schema(const Node &root)
+{
+   appendInstruction(root, ArrayKey(0), true);
+   compile(root, 0);
+}
+
+Schema::Schema(const ArrayVariant &description)
+   : Schema(parse_node(const_cast<zval *>(description.getZvalPtr())))
+{}
+
+bool Schema::isValid(const ArrayVariant &payload) const
+{
+   if (m_instructions.empty()) {
+      return true;
+   }
+   return check(const_cast<zval *>(payload.getZvalPtr()), 0, nullptr, nullptr);
+}
+
+bool Schema::validate(const ArrayVariant &payload, std::vector<Violation> &violations) const
+{
+   if (m_instructions.empty()) {
+      return true;
+   }
+   return check(const_cast<zval *>(payload.getZvalPtr()), 0, nullptr, &violations);
+}
+
+void Schema::appendInstruction(const Node &node, ArrayKey &&key, bool required)
+{
+   m_instructions.push_back(Instruction{
+                               std::move(key), node.m_type, node.m_nullable, node.m_strict,
+                               required, node.m_hasMin, node.m_hasMax, node.m_min, node.m_max,
+                               node.m_minLength, node.m_maxLength, 0, 0, 0
+                            });
+}
+
+void Schema::compile(const Node &node, uint32_t slot)
+{
+   // the fields of a node are contiguous, their own children follow them
+   uint32_t fieldStart = static_cast<uint32_t>(m_instructions.size());
+   uint32_t fieldCount = static_cast<uint32_t>(node.m_fields.size());
+   for (const Node::Field &field : node.m_fields) {
+      appendInstruction(*field.node, make_field_key(field.name), field.required);
+   }
+   m_instructions[slot].fieldStart = fieldStart;
+   m_instructions[slot].fieldCount = fieldCount;
+   for (uint32_t i = 0; i < fieldCount; ++i) {
+      compile(*node.m_fields[i].node, fieldStart + i);
+   }
+   if (node.m_items) {
+      uint32_t items = static_cast<uint32_t>(m_instructions.size());
+      appendInstruction(*node.m_items, ArrayKey(0), false);
+      m_instructions[slot].items = items;
+      compile(*node.m_items, items);
+   }
+}
+
+bool Schema::check(zval *value, uint32_t slot, const PathSegment *path,
+                   std::vector<Violation> *violations) const
+{
+   const Instruction &instruction = m_instructions[slot];
+   ZVAL_DEREF(value);
+   zend_uchar type = Z_TYPE_P(value);
+   if (type == IS_NULL && instruction.nullable) {
+      return true;
+   }
+   bool matched = false;
+   bool isNumber = false;
+   double number = 0;
+   switch (instruction.type) {
+   case ValueType::Any:
+      return true;
+   case ValueType::Null:
+      matched = type == IS_NULL;
+      break;
+   case ValueType::Bool:
+      matched = type == IS_TRUE || type == IS_FALSE;
+      break;
+   case ValueType::Long:
+   case ValueType::Double:
+   case ValueType::Number:
+      if (type == IS_LONG && instruction.type != ValueType::Double) {
+         matched = isNumber = true;
+         number = static_cast<double>(Z_LVAL_P(value));
+      } else if (type == IS_DOUBLE && instruction.type != ValueType::Long) {
+         matched = isNumber = true;
+         number = Z_DVAL_P(value);
+      }
+      break;
+   case ValueType::String:
+      if (type == IS_STRING) {
+         if (Z_STRLEN_P(value) < instruction.minLength || Z_STRLEN_P(value) > instruction.maxLength) {
+            report(violations, ViolationType::LengthOutOfRange, path);
+            return false;
+         }
+         return true;
+      }
+      break;
+   case ValueType::Array:
+   case ValueType::List:
+      if (type == IS_ARRAY && (instruction.type == ValueType::Array || is_list(Z_ARRVAL_P(value)))) {
+         return checkArray(Z_ARRVAL_P(value), instruction, path, violations);
+      }
+      break;
+   }
+   if (!matched) {
+      report(violations, ViolationType::TypeMismatch, path);
+      return false;
+   }
+   if (isNumber && ((instruction.hasMin && number < instruction.min) ||
+                    (instruction.hasMax && number > instruction.max))) {
+      report(violations, ViolationType::OutOfRange, path);
+      return false;
+   }
+   return true;
+}
+
+bool Schema::checkArray(zend_array *array, const Instruction &instruction, const PathSegment *path,
+                        std::vector<Violation> *violations) const
+{
+   bool valid = true;
+   uint32_t size = zend_hash_num_elements(array);
+   if (size < instruction.minLength || size > instruction.maxLength) {
+      report(violations, ViolationType::LengthOutOfRange, path);
+      if (!violations) {
+         return false;
+      }
+      valid = false;
+   }
+   uint32_t found = 0;
+   for (uint32_t slot = instruction.fieldStart; slot < instruction.fieldStart + instruction.fieldCount; ++slot) {
+      const Instruction &field = m_instructions[slot];
+      zval *value = field.key.isString()
+            ? zend_hash_find(array, field.key.getZendString())
+            : zend_hash_index_find(array, field.key.getIndex());
+      PathSegment segment{path, field.key.getZendString(), field.key.getIndex()};
+      if (!value) {
+         if (field.required) {
+            report(violations, ViolationType::MissingField, &segment);
+            if (!violations) {
+               return false;
+            }
+            valid = false;
+         }
+         continue;
+      }
+      ++found;
+      if (!check(value, slot, &segment, violations)) {
+         if (!violations) {
+            return false;
+         }
+         valid = false;
+      }
+   }
+   if (instruction.strict && found < size) {
+      // only reached when the payload is invalid, search the keys that
+      // are not declared
+      zend_ulong index;
+      zend_string *key;
+      ZEND_HASH_FOREACH_KEY(array, index, key) {
+         bool declared = false;
+         for (uint32_t slot = instruction.fieldStart; slot < instruction.fieldStart + instruction.fieldCount; ++slot) {
+            const ArrayKey &fieldKey = m_instructions[slot].key;
+            if (key ? fieldKey.isString() && zend_string_equals(key, fieldKey.getZendString())
+                    : fieldKey.isIndex() && index == fieldKey.getIndex()) {
+               declared = true;
+               break;
+            }
+         }
+         if (!declared) {
+            PathSegment segment{path, key, index};
+            report(violations, ViolationType::UnknownField, &segment);
+            if (!violations) {
+               return false;
+            }
+            valid = false;
+         }
+      } ZEND_HASH_FOREACH_END();
+   }
+   if (instruction.items) {
+      zend_ulong index;
+      zend_string *key;
+      zval *value;
+      ZEND_HASH_FOREACH_KEY_VAL_IND(array, index, key, value) {
+         PathSegment segment{path, key, index};
+         if (!check(value, instruction.items, &segment, violations)) {
+            if (!violations) {
+               return false;
+            }
+            valid = false;
+         }
+      } ZEND_HASH_FOREACH_END();
+   }
+   return valid;
+}
+
+void Schema::report(std::vector<Violation> *violations, ViolationType type, const PathSegment *path)
+{
+   if (!violations) {
+      return;
+   }
+   std::vector<const PathSegment *> segments;
+   for (; path; path = path->parent) {
+      segments.push_back(path);
+   }
+   std::string result;
+   for (auto iter = segments.rbegin(); iter != segments.rend(); ++iter) {
+      if (!result.empty()) {
+         result += '.';
+      }
+      const PathSegment *segment = *iter;
+      if (segment->key) {
+         result.append(ZSTR_VAL(segment->key), ZSTR_LEN(segment->key));
+      } else {
+         result += std::to_string(segment->index);
+      }
+   }
+   violations->push_back(Violation{type, std::move(result)});
+}
+
+} // ds
+} // zapi
@@ -78,8 +78,198 @@ void std_zval_deleter(VariantPrivate *ptr)
    }
    delete ptr;
 }
+
+// xxHash64 primitives, the fingerprint must be the same between processes
+// so the seeds are fixed
+const std::uint64_t fp_prime1 = UINT64_C(0x9E3779B185EBCA87);
+const std::uint64_t fp_prime2 = UINT64_C(0xC2B2AE3D27D4EB4F);
+const std::uint64_t fp_prime3 = UINT64_C(0x165667B19E3779F9);
+const std::uint64_t fp_prime4 = UINT64_C(0x85EBCA77C2B2AE63);
+const std::uint64_t fp_prime5 = UINT64_C(0x27D4EB2F165667C5);
+const std::uint64_t fp_recursion = UINT64_C(0x5245435552534956);
+
+inline std::uint64_t fp_rotl(std::uint64_t value, int bits)
+{
+   return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t fp_read64(const unsigned char *ptr)
+{
+   std::uint64_t value;
+   std::memcpy(&value, ptr, sizeof(value));
+   return value;
+}
+
+inline std::uint64_t fp_round(std::uint64_t acc, std::uint64_t input)
+{
+   acc += input * fp_prime2;
+   return fp_rotl(acc, 31) * fp_prime1;
+}
+
+inline std::uint64_t fp_merge_round(std::uint64_t acc, std::uint64_t value)
+{
+   acc ^= fp_round(0, value);
+   return acc * fp_prime1 + fp_prime4;
+}
+
+inline std::uint64_t fp_combine(std::uint64_t hash, std::uint64_t value)
+{
+   hash ^= fp_round(0, value);
+   return fp_rotl(hash, 27) * fp_prime1 + fp_prime4;
+}
+
+inline std::uint64_t fp_avalanche(std::uint64_t hash)
+{
+   hash ^= hash >> 33;
+   hash *= fp_prime2;
+   hash ^= hash >> 29;
+   hash *= fp_prime3;
+   hash ^= hash >> 32;
+   return hash;
+}
+
+std::uint64_t fp_hash_bytes(const char *data, size_t length, std::uint64_t seed)
+{
+   const unsigned char *ptr = reinterpret_cast<const unsigned char *>(data);
+   const unsigned char *end = ptr + length;
+   std::uint64_t hash;
+   if (length >= 32) {
+      const unsigned char *limit = end - 32;
+      std::uint64_t v1 = seed + fp_prime1 + fp_prime2;
+      std::uint64_t v2 = seed + fp_prime2;
+      std::uint64_t v3 = seed;
+      std::uint64_t v4 = seed - fp_prime1;
+      do {
+         v1 = fp_round(v1, fp_read64(ptr));
+         v2 = fp_round(v2, fp_read64(ptr + 8));
+         v3 = fp_round(v3, fp_read64(ptr + 16));
+         v4 = fp_round(v4, fp_read64(ptr + 24));
+         ptr += 32;
+      } while (ptr <= limit);
+      hash = fp_rotl(v1, 1) + fp_rotl(v2, 7) + fp_rotl(v3, 12) + fp_rotl(v4, 18);
+      hash = fp_merge_round(hash, v1);
+      hash = fp_merge_round(hash, v2);
+      hash = fp_merge_round(hash, v3);
+      hash = fp_merge_round(hash, v4);
+   } else {
+      hash = seed + fp_prime5;
+   }
+   hash += length;
+   for (; ptr + 8 <= end; ptr += 8) {
+      hash = fp_combine(hash, fp_read64(ptr));
+   }
+   if (ptr + 4 <= end) {
+      std::uint32_t value;
+      std::memcpy(&value, ptr, sizeof(value));
+      hash ^= static_cast<std::uint64_t>(value) * fp_prime1;
+      hash = fp_rotl(hash, 23) * fp_prime2 + fp_prime3;
+      ptr += 4;
+   }
+   for (; ptr < end; ++ptr) {
+      hash ^= (*ptr) * fp_prime5;
+      hash = fp_rotl(hash, 11) * fp_prime1;
+   }
+   return fp_avalanche(hash);
+}
+
+inline std::uint64_t fp_hash_scalar(zend_uchar type, std::uint64_t bits)
+{
+   return fp_avalanche(fp_combine(fp_prime5 + type, bits));
+}
+
+std::uint64_t fp_hash_value(zval *value, bool ordered);
+
+std::uint64_t fp_hash_table(zend_array *table, std::uint64_t hash, bool ordered)
+{
+   std::uint64_t sum = 0;
+   std::uint64_t mixed = 0;
+   zend_ulong index;
+   zend_string *key;
+   zval *value;
+   hash = fp_combine(hash, zend_hash_num_elements(table));
+   ZEND_HASH_FOREACH_KEY_VAL_IND(table, index, key, value) {
+      std::uint64_t keyHash = key
+            ? fp_hash_bytes(ZSTR_VAL(key), ZSTR_LEN(key), IS_STRING)
+            : fp_hash_scalar(IS_LONG, index);
+      std::uint64_t valueHash = fp_hash_value(value, ordered);
+      if (ordered) {
+         hash = fp_combine(fp_combine(hash, keyHash), valueHash);
+      } else {
+         // the sum and the xor don't depend on the order of the elements
+         std::uint64_t pairHash = fp_avalanche(fp_combine(fp_combine(fp_prime5, keyHash), valueHash));
+         sum += pairHash;
+         mixed ^= pairHash;
+      }
+   } ZEND_HASH_FOREACH_END();
+   if (!ordered) {
+      hash = fp_combine(fp_combine(hash, sum), mixed);
+   }
+   return fp_avalanche(hash);
+}
+
+std::uint64_t fp_hash_array(zend_array *array, bool ordered)
+{
+   // immutable arrays can't contain themselves
+   bool guarded = ZEND_HASH_APPLY_PROTECTION(array) && !(GC_FLAGS(array) & IS_ARRAY_IMMUTABLE);
+   if (guarded) {
+      if (ZEND_HASH_GET_APPLY_COUNT(array) > 0) {
+         return fp_recursion;
+      }
+      ZEND_HASH_INC_APPLY_COUNT(array);
+   }
+   std::uint64_t hash = fp_hash_table(array, fp_prime5 + IS_ARRAY, ordered);
+   if (guarded) {
+      ZEND_HASH_DEC_APPLY_COUNT(array);
+   }
+   return hash;
 }
 
+std::uint64_t fp_hash_object(zval *object, bool ordered)
+{
+   if (Z_OBJ_APPLY_COUNT_P(object) > 0) {
+      return fp_recursion;
+   }
+   zend_string *className = Z_OBJCE_P(object)->name;
+   std::uint64_t hash = fp_hash_bytes(ZSTR_VAL(className), ZSTR_LEN(className), IS_OBJECT);
+   zend_array *properties = Z_OBJ_HT_P(object)->get_properties
+         ? Z_OBJ_HT_P(object)->get_properties(object)
+         : nullptr;
+   if (!properties) {
+      return hash;
+   }
+   Z_OBJ_INC_APPLY_COUNT_P(object);
+   hash = fp_hash_table(properties, hash, ordered);
+   Z_OBJ_DEC_APPLY_COUNT_P(object);
+   return hash;
+}
+
+std::uint64_t fp_hash_value(zval *value, bool ordered)
+{
+   ZVAL_DEREF(value);
+   switch (Z_TYPE_P(value)) {
+   case IS_LONG:
+      return fp_hash_scalar(IS_LONG, static_cast<std::uint64_t>(Z_LVAL_P(value)));
+   case IS_DOUBLE: {
+      double number = Z_DVAL_P(value) == 0.0 ? 0.0 : Z_DVAL_P(value);
+      std::uint64_t bits;
+      std::memcpy(&bits, &number, sizeof(bits));
+      return fp_hash_scalar(IS_DOUBLE, bits);
+   }
+   case IS_STRING:
+      return fp_hash_bytes(Z_STRVAL_P(value), Z_STRLEN_P(value), IS_STRING);
+   case IS_ARRAY:
+      return fp_hash_array(Z_ARRVAL_P(value), ordered);
+   case IS_OBJECT:
+      return fp_hash_object(value, ordered);
+   case IS_RESOURCE:
+      return fp_hash_scalar(IS_RESOURCE, static_cast<std::uint64_t>(Z_RES_HANDLE_P(value)));
+   default:
+      return fp_hash_scalar(Z_TYPE_P(value), 0);
+   }
+}
+
+} // anonymous namespace
+
 /**
  * Implementation for the Value class, which wraps a PHP userspace
  * value (a 'zval' in Zend's terminology) into a C++ object
@@ -647,6 +837,11 @@ bool Variant::strictNotEqual(const Variant &other) const
    return fast_is_not_identical_function(const_cast<zval *>(getZvalPtr()), const_cast<zval *>(other.getZvalPtr()));
 }
 
+std::uint64_t Variant::fingerprint(bool ordered) const
+{
+   return fp_hash_value(const_cast<zval *>(getZvalPtr()), ordered);
+}
+
 void Variant::stdCopyZval(zval *dest, zval *source)
 {
    // make sure what we are copied is not a reference
@@ -663,10 +858,7 @@ void Variant::stdAssignZval(zval *dest, zval *source)
    if (Z_ISREF_P(dest)) {
       dest = Z_REFVAL_P(dest);
    }
-   if (Z_IMMUTABLE_P(dest)) {
-      // throw exception here ?
-      return;
-   }
+   // immutable arrays are not refcounted, they are just overwritten below
    // setup about dest zval *
    if (Z_REFCOUNTED_P(dest)) {
       // objects can have their own assignment handler
@@ -0,0 +1,232 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_DS_INTERNAL_ZVAL_HASH_SET_H
+#define ZAPI_DS_INTERNAL_ZVAL_HASH_SET_H
+
+#include "zapi/Global.h"
+#include <cstring>
+
+namespace zapi
+{
+namespace ds
+{
+namespace internal
+{
+
+/**
+ * Temporary open addressing set of zval pointers, used by the value based
+ * array operations. The set doesn't hold references, the values must
+ * stay alive and unchanged while the set is in use.
+ *
+ * In loose mode two values are equal when their string representations
+ * are equal, the same as array_diff() and array_unique(), in strict mode
+ * they are compared with ===.
+ */
+class ZvalHashSet
+{
+public:
+   ZvalHashSet(uint32_t expected, bool strict)
+      : m_size(0),
+        m_strict(strict)
+   {
+      uint32_t capacity = 8;
+      while (capacity < expected * 2) {
+         capacity <<= 1;
+      }
+      m_mask = capacity - 1;
+      m_entries = static_cast<Entry *>(ecalloc(capacity, sizeof(Entry)));
+   }
+
+   ZvalHashSet(const ZvalHashSet &other) = delete;
+   ZvalHashSet &operator =(const ZvalHashSet &other) = delete;
+
+   ~ZvalHashSet()
+   {
+      efree(m_entries);
+   }
+
+   /**
+    * Return false when the equal value is already in the set
+    */
+   bool insert(zval *value)
+   {
+      ZVAL_DEREF(value);
+      zend_ulong hash = hashValue(value, m_strict);
+      Entry *entry = probe(value, hash);
+      if (entry->value) {
+         return false;
+      }
+      entry->value = value;
+      entry->hash = hash;
+      if (++m_size * 2 > m_mask + 1) {
+         grow();
+      }
+      return true;
+   }
+
+   bool contains(zval *value) const
+   {
+      ZVAL_DEREF(value);
+      return nullptr != probe(value, hashValue(value, m_strict))->value;
+   }
+
+   uint32_t getSize() const ZAPI_DECL_NOEXCEPT
+   {
+      return m_size;
+   }
+
+   static zend_ulong hashValue(zval *value, bool strict)
+   {
+      if (Z_TYPE_P(value) == IS_STRING) {
+         return zend_string_hash_val(Z_STR_P(value));
+      }
+      if (!strict) {
+         LooseString str(value);
+         return zend_inline_hash_func(str.m_str, str.m_length);
+      }
+      switch (Z_TYPE_P(value)) {
+      case IS_LONG:
+         return mix(static_cast<uint64_t>(Z_LVAL_P(value)));
+      case IS_DOUBLE: {
+         // 0.0 === -0.0
+         double number = Z_DVAL_P(value) == 0.0 ? 0.0 : Z_DVAL_P(value);
+         uint64_t bits;
+         std::memcpy(&bits, &number, sizeof(bits));
+         return mix(bits) ^ IS_DOUBLE;
+      }
+      case IS_ARRAY:
+         return mix(zend_hash_num_elements(Z_ARRVAL_P(value))) ^ IS_ARRAY;
+      case IS_OBJECT:
+         return mix(Z_OBJ_HANDLE_P(value)) ^ IS_OBJECT;
+      case IS_RESOURCE:
+         return mix(static_cast<uint64_t>(Z_RES_HANDLE_P(value))) ^ IS_RESOURCE;
+      default:
+         return Z_TYPE_P(value);
+      }
+   }
+
+   static bool equalValue(zval *lhs, zval *rhs, bool strict)
+   {
+      if (strict) {
+         return fast_is_identical_function(lhs, rhs);
+      }
+      if (Z_TYPE_P(lhs) == IS_STRING && Z_TYPE_P(rhs) == IS_STRING) {
+         return zend_string_equals(Z_STR_P(lhs), Z_STR_P(rhs));
+      }
+      if (Z_TYPE_P(lhs) == IS_LONG && Z_TYPE_P(rhs) == IS_LONG) {
+         return Z_LVAL_P(lhs) == Z_LVAL_P(rhs);
+      }
+      LooseString lhsStr(lhs);
+      LooseString rhsStr(rhs);
+      return lhsStr.m_length == rhsStr.m_length &&
+            0 == std::memcmp(lhsStr.m_str, rhsStr.m_str, lhsStr.m_length);
+   }
+
+protected:
+   struct Entry
+   {
+      zval *value;
+      zend_ulong hash;
+   };
+
+   // string representation of a value, integers are formatted on the stack
+   // the other types are converted by the engine
+   class LooseString
+   {
+   public:
+      explicit LooseString(zval *value)
+         : m_owned(nullptr)
+      {
+         if (Z_TYPE_P(value) == IS_STRING) {
+            m_str = Z_STRVAL_P(value);
+            m_length = Z_STRLEN_P(value);
+         } else if (Z_TYPE_P(value) == IS_LONG) {
+            char *end = m_buffer + sizeof(m_buffer) - 1;
+            m_str = zend_print_long_to_buf(end, Z_LVAL_P(value));
+            m_length = end - m_str;
+         } else {
+            m_owned = zval_get_string(value);
+            m_str = ZSTR_VAL(m_owned);
+            m_length = ZSTR_LEN(m_owned);
+         }
+      }
+
+      LooseString(const LooseString &other) = delete;
+      LooseString &operator =(const LooseString &other) = delete;
+
+      ~LooseString()
+      {
+         if (m_owned) {
+            zend_string_release(m_owned);
+         }
+      }
+
+      const char *m_str;
+      size_t m_length;
+      zend_string *m_owned;
+      char m_buffer[MAX_LENGTH_OF_LONG + 1];
+   };
+
+   static zend_ulong mix(uint64_t value) ZAPI_DECL_NOEXCEPT
+   {
+      value ^= value >> 33;
+      value *= UINT64_C(0xff51afd7ed558ccd);
+      value ^= value >> 33;
+      return static_cast<zend_ulong>(value);
+   }
+
+   Entry *probe(zval *value, zend_ulong hash) const
+   {
+      uint32_t slot = static_cast<uint32_t>(hash) & m_mask;
+      while (true) {
+         Entry *entry = m_entries + slot;
+         if (!entry->value || (entry->hash == hash && equalValue(entry->value, value, m_strict))) {
+            return entry;
+         }
+         slot = (slot + 1) & m_mask;
+      }
+   }
+
+   void grow()
+   {
+      Entry *oldEntries = m_entries;
+      uint32_t oldCapacity = m_mask + 1;
+      m_mask = oldCapacity * 2 - 1;
+      m_entries = static_cast<Entry *>(ecalloc(oldCapacity * 2, sizeof(Entry)));
+      for (uint32_t i = 0; i < oldCapacity; ++i) {
+         if (oldEntries[i].value) {
+            uint32_t slot = static_cast<uint32_t>(oldEntries[i].hash) & m_mask;
+            while (m_entries[slot].value) {
+               slot = (slot + 1) & m_mask;
+            }
+            m_entries[slot] = oldEntries[i];
+         }
+      }
+      efree(oldEntries);
+   }
+
+protected:
+   Entry *m_entries;
+   uint32_t m_mask;
+   uint32_t m_size;
+   bool m_strict;
+};
+
+} // internal
+} // ds
+} // zapi
+
+#endif // ZAPI_DS_INTERNAL_ZVAL_HASH_SET_H
@@ -0,0 +1,114 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/lang/ClassRef.h"
+#include <atomic>
+
+namespace zapi
+{
+namespace lang
+{
+
+namespace
+{
+// hands out the epochs, no two requests share one whatever their thread
+std::atomic<uint64_t> epoch_source(1);
+// epoch of the request running on this thread, bumped when a request
+// starts and ends so the userland entries cached in an older request are
+// looked up again
+ZAPI_THREAD_LOCAL uint64_t request_epoch = 1;
+
+std::string make_class_key(const char *name, size_t length)
+{
+   if (length > 0 && name[0] == '\\') {
+      ++name;
+      --length;
+   }
+   std::string key(name, length);
+   zend_str_tolower(&key[0], length);
+   return key;
+}
+} // anonymous namespace
+
+ClassRef::ClassRef(const char *name)
+   : ClassRef(std::string(name))
+{}
+
+ClassRef::ClassRef(const std::string &name)
+   : m_name(name),
+     m_key(make_class_key(name.data(), name.length())),
+     m_entry(nullptr),
+     m_epoch(0),
+     m_persistent(false)
+{}
+
+ClassRef::ClassRef(zend_class_entry *entry)
+   : m_name(ZSTR_VAL(entry->name), ZSTR_LEN(entry->name)),
+     m_key(make_class_key(ZSTR_VAL(entry->name), ZSTR_LEN(entry->name))),
+     m_entry(entry),
+     m_epoch(request_epoch),
+     m_persistent(entry->type == ZEND_INTERNAL_CLASS)
+{}
+
+zend_class_entry *ClassRef::getEntry() const
+{
+   if (m_entry && (m_persistent || m_epoch == request_epoch)) {
+      return m_entry;
+   }
+   zend_class_entry *entry = reinterpret_cast<zend_class_entry *>(
+            zend_hash_str_find_ptr(EG(class_table), m_key.data(), m_key.length()));
+#ifdef ZTS
+   // a ClassRef kept in a static is shared by the threads, only the internal
+   // entries are the same for all of them
+   if (entry && entry->type != ZEND_INTERNAL_CLASS) {
+      return entry;
+   }
+#endif
+   // a missing class is looked up again next time, it may be declared later
+   if (entry) {
+      m_entry = entry;
+      m_epoch = request_epoch;
+      m_persistent = entry->type == ZEND_INTERNAL_CLASS;
+   }
+   return entry;
+}
+
+zend_class_entry *ClassRef::lookup(const char *name, size_t length)
+{
+   char buffer[64];
+   if (length > 0 && name[0] == '\\') {
+      ++name;
+      --length;
+   }
+   if (length >= sizeof(buffer)) {
+      std::string key = make_class_key(name, length);
+      return reinterpret_cast<zend_class_entry *>(zend_hash_str_find_ptr(EG(class_table), key.data(), key.length()));
+   }
+   zend_str_tolower_copy(buffer, name, length);
+   return reinterpret_cast<zend_class_entry *>(zend_hash_str_find_ptr(EG(class_table), buffer, length));
+}
+
+uint64_t ClassRef::getRequestEpoch() ZAPI_DECL_NOEXCEPT
+{
+   return request_epoch;
+}
+
+void ClassRef::nextRequest() ZAPI_DECL_NOEXCEPT
+{
+   request_epoch = ++epoch_source;
+}
+
+} // lang
+} // zapi
@@ -23,7 +23,10 @@
 #include "zapi/lang/Function.h"
 #include "zapi/lang/Constant.h"
 #include "zapi/lang/Namespace.h"
+#include "zapi/lang/ClassRef.h"
 #include "zapi/vm/Closure.h"
+#include "zapi/vm/ObjectPool.h"
+#include "zapi/ds/Reflection.h"
 #include "zapi/vm/internal/AbstractClassPrivate.h"
 #include "php/Zend/zend_constants.h"
 
@@ -92,6 +95,7 @@ using zapi::lang::Constant;
 using zapi::lang::internal::ExtensionPrivate;
 using zapi::lang::internal::NamespacePrivate;
 using zapi::vm::AbstractClassPrivate;
+using zapi::vm::ObjectPool;
 
 Extension::Extension(const char *name, const char *version, int apiVersion)
    : m_implPtr(new ExtensionPrivate(name, version, apiVersion, this))
@@ -445,6 +449,9 @@ int ExtensionPrivate::processMismatch(INIT_FUNC_ARGS)
 int ExtensionPrivate::processRequestStartup(INIT_FUNC_ARGS)
 {
    Extension *extension = find_module(module_number);
+   ObjectPool::activateAll();
+   // the first request of a thread must not share the epoch of another one
+   ClassRef::nextRequest();
    if (extension->m_implPtr->m_requestStartupHandler) {
       extension->m_implPtr->m_requestStartupHandler();
    }
@@ -459,6 +466,12 @@ int ExtensionPrivate::processRequestShutdown(SHUTDOWN_FUNC_ARGS)
    }
    // release call context
    AbstractClassPrivate::sm_contextPtrs.clear();
+   // the native object free lists live for one request
+   ObjectPool::drainAll();
+   // the userland class entries cached by ClassRef die with the request
+   ClassRef::nextRequest();
+   // so do the struct keys interned by the request
+   zapi::ds::internal::release_struct_keys();
    return BOOL2SUCCESS(true);
 }
 
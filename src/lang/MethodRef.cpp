@@ -0,0 +1,67 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/lang/MethodRef.h"
+#include "zapi/lang/ClassRef.h"
+
+namespace zapi
+{
+namespace lang
+{
+
+MethodRef::MethodRef(const char *name)
+   : m_name(name),
+     m_key(zend_string_init(name, m_name.length(), 1)),
+     m_scope(nullptr),
+     m_function(nullptr),
+     m_epoch(0),
+     m_persistent(false)
+{
+   zend_str_tolower(ZSTR_VAL(m_key), ZSTR_LEN(m_key));
+   zend_string_hash_val(m_key);
+}
+
+MethodRef::~MethodRef()
+{
+   zend_string_release(m_key);
+}
+
+zend_function *MethodRef::find(zend_class_entry *scope) const
+{
+   if (!scope) {
+      return reinterpret_cast<zend_function *>(zend_hash_find_ptr(EG(function_table), m_key));
+   }
+#ifdef ZTS
+   // a static MethodRef is shared by the threads and the cached scope and
+   // function can't be stored as one unit, so only the prehashed key helps
+   return reinterpret_cast<zend_function *>(zend_hash_find_ptr(&scope->function_table, m_key));
+#else
+   uint64_t epoch = ClassRef::getRequestEpoch();
+   if (scope == m_scope && (m_persistent || m_epoch == epoch)) {
+      return m_function;
+   }
+   zend_function *func = reinterpret_cast<zend_function *>(zend_hash_find_ptr(&scope->function_table, m_key));
+   if (func) {
+      m_scope = scope;
+      m_function = func;
+      m_epoch = epoch;
+      m_persistent = scope->type == ZEND_INTERNAL_CLASS;
+   }
+   return func;
+#endif
+}
+
+} // lang
+} // zapi
@@ -36,6 +36,15 @@ Parameters::Parameters(zval *thisPtr, uint32_t argc)
    }
 }
 
+Parameters::Parameters(StdClass *object, zval *arguments, uint32_t argc)
+   : Parameters(object)
+{
+   m_data.reserve(argc);
+   for (uint32_t i = 0; i < argc; i++) {
+      m_data.emplace_back(&arguments[i]);
+   }
+}
+
 Parameters::Reference Parameters::at(SizeType pos)
 {
    return m_data.at(pos);
@@ -0,0 +1,48 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/lang/PropertySlot.h"
+
+namespace zapi
+{
+namespace lang
+{
+
+Variant PropertyRef::getValue() const
+{
+   zval *value = m_value;
+   if (!value) {
+      return nullptr;
+   }
+   ZVAL_DEREF(value);
+   if (Z_TYPE_P(value) == IS_UNDEF) {
+      return nullptr;
+   }
+   return Variant(value);
+}
+
+void PropertyRef::assign(zval *value)
+{
+   zval *target = m_value;
+   ZVAL_DEREF(target);
+   // the old value may run a destructor that reads the property
+   zval garbage;
+   ZVAL_COPY_VALUE(&garbage, target);
+   ZVAL_COPY_VALUE(target, value);
+   zval_ptr_dtor(&garbage);
+}
+
+} // lang
+} // zapi
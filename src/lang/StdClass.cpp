@@ -20,6 +20,10 @@
 #include "zapi/ds/ArrayVariant.h"
 #include "zapi/lang/StdClass.h"
 #include "zapi/lang/internal/StdClassPrivate.h"
+#include "zapi/vm/AbstractClass.h"
+#include "zapi/vm/internal/AbstractClassPrivate.h"
+#include "zapi/lang/ClassRef.h"
+#include "zapi/lang/MethodRef.h"
 #include "zapi/kernel/NotImplemented.h"
 #include "zapi/utils/CommonFuncs.h"
 
@@ -38,6 +42,146 @@ StdClassPrivate::StdClassPrivate()
 
 using zapi::kernel::NotImplemented;
 using zapi::lang::internal::StdClassPrivate;
+using zapi::vm::internal::AbstractClassPrivate;
+
+namespace
+{
+void release_property_slot(zval *slot)
+{
+   // an unset slot sends the executor back to the property handlers
+   zval garbage;
+   ZVAL_COPY_VALUE(&garbage, slot);
+   ZVAL_UNDEF(slot);
+   zval_ptr_dtor(&garbage);
+}
+
+bool slot_matches(zend_object *object, const PropertySlot &slot)
+{
+   if (!object) {
+      zapi::warning << "Property slot used on an unbinded nativeObject" << std::endl;
+      return false;
+   }
+   if (!slot.isResolved()) {
+      zapi::warning << "Unresolved property slot used on an object of class "
+                    << ZSTR_VAL(object->ce->name) << std::endl;
+      return false;
+   }
+   if (!instanceof_function(object->ce, slot.getScope())) {
+      zapi::warning << "Property slot of class " << ZSTR_VAL(slot.getScope()->name)
+                    << " used on an object of class " << ZSTR_VAL(object->ce->name) << std::endl;
+      return false;
+   }
+   return true;
+}
+
+// direct mapped cache of the parent methods called by name, one per
+// thread. The name pointer only picks the entry, since it is almost always
+// a literal, a hit is keyed on the scope and the name itself
+struct ParentMethodCacheEntry
+{
+   zend_class_entry *scope;
+   zend_function *function;
+   uint64_t epoch;
+   bool persistent;
+   uint8_t length;
+   char name[39];
+};
+
+ZAPI_THREAD_LOCAL ParentMethodCacheEntry parent_method_cache[64];
+
+zend_function *find_parent_method(zend_class_entry *scope, const char *name, size_t length)
+{
+   HashTable *funcTable = scope ? &scope->function_table : EG(function_table);
+   uintptr_t hash = reinterpret_cast<uintptr_t>(scope) ^ (reinterpret_cast<uintptr_t>(name) >> 3);
+   ParentMethodCacheEntry &entry = parent_method_cache[(hash ^ (hash >> 7)) % 64];
+   uint64_t epoch = ClassRef::getRequestEpoch();
+   bool cacheable = scope && length <= sizeof(entry.name);
+   if (cacheable && entry.scope == scope && entry.function && entry.length == length &&
+       (entry.persistent || entry.epoch == epoch) &&
+       0 == zend_binary_strcasecmp(entry.name, length, name, length)) {
+      return entry.function;
+   }
+   char buffer[64];
+   zend_function *func;
+   if (length < sizeof(buffer)) {
+      zend_str_tolower_copy(buffer, name, length);
+      func = reinterpret_cast<zend_function *>(zend_hash_str_find_ptr(funcTable, buffer, length));
+   } else {
+      std::string lcName(name, length);
+      zapi::utils::str_tolower(&lcName[0], length);
+      func = reinterpret_cast<zend_function *>(zend_hash_str_find_ptr(funcTable, lcName.data(), length));
+   }
+   if (cacheable && func) {
+      entry.scope = scope;
+      entry.function = func;
+      entry.epoch = epoch;
+      entry.persistent = scope->type == ZEND_INTERNAL_CLASS;
+      entry.length = static_cast<uint8_t>(length);
+      std::memcpy(entry.name, buffer, length);
+   }
+   return func;
+}
+
+zval *call_parent_method(zend_object *object, zend_function *func, const char *name,
+                         const int argc, Variant *argv, zval *retvalPtr)
+{
+   zend_class_entry *parentClassType = object->ce->parent;
+   if (!func) {
+      /* error at c-level */
+      zend_error(E_CORE_ERROR, "Couldn't find implementation for method %s%s%s",
+                 parentClassType ? ZSTR_VAL(parentClassType->name) : "", parentClassType ? "::" : "", name);
+      return nullptr;
+   }
+   // the small arities are passed on the stack
+   zval stackParams[8];
+   std::unique_ptr<zval[]> heapParams;
+   zval *params = stackParams;
+   if (argc > 8) {
+      heapParams.reset(new zval[argc]);
+      params = heapParams.get();
+   }
+   for (int i = 0; i < argc; i++) {
+      params[i] = *argv[i].getUnDerefZvalPtr();
+      if (Z_TYPE(params[i]) == IS_REFERENCE && Z_REFCOUNTED_P(Z_REFVAL(params[i]))) {
+         Z_TRY_ADDREF(params[i]); // _call_user_function_ex free call stack will decrease 1
+      }
+   }
+   zval retval;
+   ZVAL_UNDEF(&retval);
+   zend_fcall_info fci;
+   std::memset(&fci, 0, sizeof(fci));
+   fci.size = sizeof(fci);
+   fci.object = object;
+   // the cache below is used, the name is only kept for the messages
+   ZVAL_STR(&fci.function_name, func->common.function_name);
+   fci.retval = retvalPtr ? retvalPtr : &retval;
+   fci.param_count = argc;
+   fci.params = params;
+   fci.no_separation = 1;
+   // setup cache
+   zend_fcall_info_cache fcic;
+   fcic.initialized = 1;
+   fcic.function_handler = func;
+   fcic.calling_scope = parentClassType;
+   fcic.called_scope = object->ce;
+   fcic.object = object;
+   if (zend_call_function(&fci, &fcic) == ZAPI_FAILURE) {
+      /* error at c-level */
+      if (!parentClassType) {
+         parentClassType = object->ce;
+      }
+      if (!EG(exception)) {
+         zend_error(E_CORE_ERROR, "Couldn't execute method %s%s%s", parentClassType
+                    ? ZSTR_VAL(parentClassType->name) : "", parentClassType ? "::" : "", name);
+      }
+   }
+   if (!retvalPtr) {
+      zval_ptr_dtor(&retval);
+      return nullptr;
+   }
+   return retvalPtr;
+}
+} // anonymous namespace
 
 StdClass::StdClass()
    : m_implPtr(new StdClassPrivate)
@@ -216,6 +360,47 @@ ArrayVariant StdClass::__debugInfo() const
    throw NotImplemented();
 }
 
+void StdClass::gcVisit(GcVisitor &visitor) const
+{}
+
+PropertyRef StdClass::slot(const PropertySlot &slot) const
+{
+   zend_object *object = m_implPtr->m_zendObject;
+   if (!slot_matches(object, slot)) {
+      return PropertyRef();
+   }
+   return PropertyRef(OBJ_PROP(object, slot.getOffset()));
+}
+
+void StdClass::invalidateProperty(const std::string &name)
+{
+   zend_object *object = m_implPtr->m_zendObject;
+   if (!object) {
+      zapi::warning << "invalidateProperty used on an unbinded nativeObject" << std::endl;
+      return;
+   }
+   if (!AbstractClassPrivate::isLazyProperty(object->ce, name)) {
+      zapi::warning << "Property " << ZSTR_VAL(object->ce->name) << "::$" << name
+                    << " is not a lazy property" << std::endl;
+      return;
+   }
+   zend_property_info *info = reinterpret_cast<zend_property_info *>(
+            zend_hash_str_find_ptr(&object->ce->properties_info, name.c_str(), name.length()));
+   if (!info || (info->flags & ZEND_ACC_STATIC)) {
+      return;
+   }
+   release_property_slot(OBJ_PROP(object, info->offset));
+}
+
+void StdClass::invalidateProperty(const PropertySlot &slot)
+{
+   zend_object *object = m_implPtr->m_zendObject;
+   if (!slot_matches(object, slot)) {
+      return;
+   }
+   release_property_slot(OBJ_PROP(object, slot.getOffset()));
+}
+
 ObjectVariant *StdClass::getObjectZvalPtr() const
 {
    if (!m_implPtr->m_objVariant) {
@@ -235,76 +420,22 @@ zval *StdClass::doCallParent(const char *name, const int argc, Variant *argv, zv
    zend_object *object = m_implPtr->m_zendObject;
    if (!object) {
       zapi::error << "invoke StdClass::doCallParent on unbinded nativeObject" << std::endl;
+      return nullptr;
    }
-   int result;
-   zend_fcall_info fci;
-   std::memset(&fci, 0, sizeof(fci));
-   zval retval;
-   HashTable *funcTable;
-   std::unique_ptr<zval[]> params(new zval[argc]);
-   zval *curArgPtr = nullptr;
-   for (int i = 0; i < argc; i++) {
-      params[i] = *argv[i].getUnDerefZvalPtr();
-      curArgPtr = &params[i];
-      if (Z_TYPE_P(curArgPtr) == IS_REFERENCE && Z_REFCOUNTED_P(Z_REFVAL_P(curArgPtr))) {
-          Z_TRY_ADDREF_P(&params[i]); // _call_user_function_ex free call stack will decrease 1
-      }
-   }
-   fci.size = sizeof(fci);
-   fci.object = object;
-   ZVAL_STRINGL(&fci.function_name, name, std::strlen(name));
-   zapi::utils::str_tolower(Z_STRVAL(fci.function_name), Z_STRLEN(fci.function_name));
-   fci.retval = retvalPtr ? retvalPtr : &retval;
-   fci.param_count = argc;
-   fci.params = params.get();
-   fci.no_separation = 1;
-   
-   // setup cache
-   zend_fcall_info_cache fcic;
-   fcic.initialized = 1;
    zend_class_entry *parentClassType = object->ce->parent;
-   if (parentClassType) {
-      funcTable = &parentClassType->function_table;
-   } else {
-      funcTable = EG(function_table);
-   }
-   if ((fcic.function_handler = reinterpret_cast<zend_function *>(zend_hash_find_ptr(funcTable, Z_STR(fci.function_name)))) == nullptr) {
-      /* error at c-level */
-      zend_error(E_CORE_ERROR, "Couldn't find implementation for method %s%s%s", 
-                 parentClassType ? ZSTR_VAL(parentClassType->name) : "", parentClassType ? "::" : "", name);
-   }
-   fcic.calling_scope = parentClassType;
-   if (object) {
-      fcic.called_scope = object->ce;
-   } else {
-      zend_class_entry *calledScope = zend_get_called_scope(EG(current_execute_data));
-      
-      if (parentClassType &&
-          (!calledScope ||
-           !instanceof_function(calledScope, parentClassType))) {
-         fcic.called_scope = parentClassType;
-      } else {
-         fcic.called_scope = calledScope;
-      }
-   }
-   fcic.object = object ? object : nullptr;
-   result = zend_call_function(&fci, &fcic);
-   zval_ptr_dtor(&fci.function_name);
-   if (result == ZAPI_FAILURE) {
-      /* error at c-level */
-      if (!parentClassType) {
-         parentClassType = object ? object->ce : nullptr;
-      }
-      if (!EG(exception)) {
-         zend_error(E_CORE_ERROR, "Couldn't execute method %s%s%s", parentClassType 
-                    ? ZSTR_VAL(parentClassType->name) : "", parentClassType ? "::" : "", name);
-      }
-   }
-   if (!retvalPtr) {
-      zval_ptr_dtor(&retval);
+   zend_function *func = find_parent_method(parentClassType, name, std::strlen(name));
+   return call_parent_method(object, func, name, argc, argv, retvalPtr);
+}
+
+zval *StdClass::doCallParent(const MethodRef &method, const int argc, Variant *argv, zval *retvalPtr) const
+{
+   zend_object *object = m_implPtr->m_zendObject;
+   if (!object) {
+      zapi::error << "invoke StdClass::doCallParent on unbinded nativeObject" << std::endl;
       return nullptr;
    }
-   return retvalPtr;
+   zend_function *func = method.find(object->ce->parent);
+   return call_parent_method(object, func, method.getName().c_str(), argc, argv, retvalPtr);
 }
 
 } // lang
@@ -0,0 +1,49 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/protocol/FastIterator.h"
+
+namespace zapi
+{
+namespace protocol
+{
+
+FastIterator::FastIterator(StdClass *nativeObject)
+   : AbstractIterator(nativeObject)
+{}
+
+Variant FastIterator::current()
+{
+   zval *value = currentValue();
+   if (!value) {
+      return nullptr;
+   }
+   return Variant(value);
+}
+
+Variant FastIterator::key()
+{
+   zval temp;
+   currentKey(&temp);
+   Variant result(&temp);
+   zval_ptr_dtor(&temp);
+   return result;
+}
+
+FastIterator::~FastIterator()
+{}
+
+} // protocol
+} // zapi
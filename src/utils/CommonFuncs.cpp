@@ -15,6 +15,7 @@
 
 #include "zapi/utils/CommonFuncs.h"
 #include "zapi/ds/Variant.h"
+#include "zapi/ds/ZvalHashSet.h"
 #include "zapi/lang/Type.h"
 #include <string>
 #include <cstring>
@@ -140,29 +141,121 @@ bool zval_type_is_valid(const zval *valuePtr) ZAPI_DECL_NOEXCEPT
    }
 }
 
+namespace
+{
+
+// a variant seen as an array key, key is nullptr for integer keys
+struct KeyView
+{
+   zend_string *key;
+   zend_long index;
+};
+
+// return false for the types that are not valid array keys
+bool resolve_array_key(const zval *value, KeyView &view)
+{
+   ZVAL_DEREF(value);
+   view.key = nullptr;
+   view.index = 0;
+   switch (Z_TYPE_P(value)) {
+   case IS_LONG:
+      view.index = Z_LVAL_P(value);
+      return true;
+   case IS_STRING: {
+      zend_ulong index;
+      if (ZEND_HANDLE_NUMERIC_STR(Z_STRVAL_P(value), Z_STRLEN_P(value), index)) {
+         view.index = static_cast<zend_long>(index);
+      } else {
+         view.key = Z_STR_P(value);
+      }
+      return true;
+   }
+   case IS_NULL:
+      view.key = ZSTR_EMPTY_ALLOC();
+      return true;
+   case IS_FALSE:
+      return true;
+   case IS_TRUE:
+      view.index = 1;
+      return true;
+   case IS_DOUBLE:
+      view.index = zend_dval_to_lval(Z_DVAL_P(value));
+      return true;
+   case IS_RESOURCE:
+      view.index = Z_RES_HANDLE_P(value);
+      return true;
+   default:
+      return false;
+   }
+}
+
+int compare_invalid_key(const zval *lhs, const zval *rhs)
+{
+   ZVAL_DEREF(lhs);
+   ZVAL_DEREF(rhs);
+   if (Z_TYPE_P(lhs) != Z_TYPE_P(rhs)) {
+      return Z_TYPE_P(lhs) < Z_TYPE_P(rhs) ? -1 : 1;
+   }
+   if (Z_REFCOUNTED_P(lhs) && Z_COUNTED_P(lhs) != Z_COUNTED_P(rhs)) {
+      return Z_COUNTED_P(lhs) < Z_COUNTED_P(rhs) ? -1 : 1;
+   }
+   return 0;
+}
+
+} // anonymous namespace
+
 bool VariantKeyLess::operator ()(const zapi::ds::Variant &lhs, const zapi::ds::Variant &rhs) const
 {
-   Type ltype = lhs.getType();
-   Type rtype = rhs.getType();
-   bool result;
-   if (ltype == Type::String && rtype == Type::String) {
-      result = std::strcmp(Z_STRVAL_P(lhs.getZvalPtr()), Z_STRVAL_P(rhs.getZvalPtr())) < 0;
-   } else if (ltype == Type::String && rtype == Type::Long) {
-      zval temp;
-      ZVAL_COPY_VALUE(&temp, rhs.getZvalPtr());
-      convert_to_string(&temp);
-      result = std::strcmp(Z_STRVAL_P(lhs.getZvalPtr()), Z_STRVAL_P(&temp)) < 0;
-      zval_dtor(&temp);
-   } else if (ltype == Type::Long && rtype == Type::String) {
-      zval temp;
-      ZVAL_COPY_VALUE(&temp, lhs.getZvalPtr());
-      convert_to_string(&temp);
-      result = std::strcmp(Z_STRVAL_P(&temp), Z_STRVAL_P(rhs.getZvalPtr())) < 0;
-      zval_dtor(&temp);
-   } else {
-      result = Z_LVAL_P(lhs.getZvalPtr()) < Z_LVAL_P(rhs.getZvalPtr());
+   KeyView lkey;
+   KeyView rkey;
+   bool lvalid = resolve_array_key(lhs.getZvalPtr(), lkey);
+   bool rvalid = resolve_array_key(rhs.getZvalPtr(), rkey);
+   if (!lvalid || !rvalid) {
+      // the invalid keys are ordered after the valid ones
+      if (lvalid != rvalid) {
+         return lvalid;
+      }
+      return compare_invalid_key(lhs.getZvalPtr(), rhs.getZvalPtr()) < 0;
+   }
+   if (!lkey.key || !rkey.key) {
+      if (lkey.key || rkey.key) {
+         // integer keys first
+         return !lkey.key;
+      }
+      return lkey.index < rkey.index;
+   }
+   return zend_binary_strcmp(ZSTR_VAL(lkey.key), ZSTR_LEN(lkey.key),
+                             ZSTR_VAL(rkey.key), ZSTR_LEN(rkey.key)) < 0;
+}
+
+size_t VariantKeyHash::operator ()(const zapi::ds::Variant &value) const
+{
+   KeyView key;
+   if (!resolve_array_key(value.getZvalPtr(), key)) {
+      return static_cast<size_t>(zapi::ds::internal::ZvalHashSet::hashValue(
+                                    const_cast<zval *>(value.getZvalPtr()), true));
+   }
+   if (key.key) {
+      return static_cast<size_t>(zend_string_hash_val(key.key));
+   }
+   return static_cast<size_t>(key.index);
+}
+
+bool VariantKeyEqual::operator ()(const zapi::ds::Variant &lhs, const zapi::ds::Variant &rhs) const
+{
+   KeyView lkey;
+   KeyView rkey;
+   bool lvalid = resolve_array_key(lhs.getZvalPtr(), lkey);
+   bool rvalid = resolve_array_key(rhs.getZvalPtr(), rkey);
+   if (!lvalid || !rvalid) {
+      return lvalid == rvalid &&
+            fast_is_identical_function(const_cast<zval *>(lhs.getZvalPtr()),
+                                       const_cast<zval *>(rhs.getZvalPtr()));
+   }
+   if (!lkey.key || !rkey.key) {
+      return !lkey.key && !rkey.key && lkey.index == rkey.index;
    }
-   return result;
+   return zend_string_equals(lkey.key, rkey.key);
 }
 
 } // utils
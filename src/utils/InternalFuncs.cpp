@@ -56,5 +56,26 @@ bool parse_namespaces(const std::string &ns, std::list<std::string> &parts)
    return true;
 }
 
+zend_string *new_permanent_string(const char *str, size_t length)
+{
+   zend_string *result = zend_new_interned_string(zend_string_init(str, length, 1));
+#ifdef ZAPI_ZTS_NO_INTERNING
+   // the engine skips the refcount of the interned strings, so no thread
+   // ever writes to this one once the hash is computed
+   zend_string_hash_val(result);
+   GC_FLAGS(result) |= IS_STR_INTERNED | IS_STR_PERMANENT;
+#endif
+   return result;
+}
+
+void free_permanent_string(zend_string *str)
+{
+#ifdef ZAPI_ZTS_NO_INTERNING
+   pefree(str, 1);
+#else
+   (void) str;
+#endif
+}
+
 }
 }
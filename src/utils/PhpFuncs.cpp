@@ -34,14 +34,13 @@ bool array_unset(ArrayItemProxy &&arrayItem)
    }
    // everything is ok
    // here we use the pointer to remove
-   ArrayItemProxy::KeyType requestKey = arrayItem.m_implPtr->m_requestKey;
+   const zapi::ds::ArrayKey &requestKey = arrayItem.m_implPtr->m_requestKey;
    zval *array = arrayItem.m_implPtr->m_array;
    int ret;
-   if (requestKey.second) {
-      std::string *key = requestKey.second.get();
-      ret = zend_hash_str_del(Z_ARRVAL_P(array), key->c_str(), key->length());
+   if (requestKey.isString()) {
+      ret = zend_hash_del(Z_ARRVAL_P(array), requestKey.getZendString());
    } else {
-      ret = zend_hash_index_del(Z_ARRVAL_P(array), requestKey.first);
+      ret = zend_hash_index_del(Z_ARRVAL_P(array), requestKey.getIndex());
    }
    return ret == ZAPI_SUCCESS;
 }
@@ -15,8 +15,11 @@
 
 #include <iostream>
 #include <cstring>
+#include <algorithm>
 #include "php/Zend/zend_inheritance.h"
 #include "php/Zend/zend.h"
+#include "php/Zend/zend_exceptions.h"
+#include "php/ext/standard/php_smart_string.h"
 #include "zapi/vm/IteratorBridge.h"
 #include "zapi/vm/AbstractClass.h"
 #include "zapi/vm/internal/AbstractClassPrivate.h"
@@ -28,6 +31,8 @@
 #include "zapi/vm/NumericMember.h"
 #include "zapi/vm/NullMember.h"
 #include "zapi/vm/Property.h"
+#include "zapi/vm/FieldBinding.h"
+#include "zapi/vm/GcVisitor.h"
 #include "zapi/ds/Variant.h"
 #include "zapi/ds/StringVariant.h"
 #include "zapi/ds/NumericVariant.h"
@@ -36,6 +41,7 @@
 #include "zapi/ds/ArrayVariant.h"
 #include "zapi/lang/Method.h"
 #include "zapi/lang/StdClass.h"
+#include "zapi/lang/PropertySlot.h"
 #include "zapi/lang/Constant.h"
 #include "zapi/lang/Method.h"
 #include "zapi/lang/Interface.h"
@@ -43,9 +49,9 @@
 #include "zapi/kernel/NotImplemented.h"
 #include "zapi/kernel/OrigException.h"
 #include "zapi/protocol/AbstractIterator.h"
+#include "zapi/protocol/FastIterator.h"
 #include "zapi/protocol/ArrayAccess.h"
 #include "zapi/protocol/Countable.h"
-#include "zapi/protocol/Serializable.h"
 #include "zapi/protocol/Traversable.h"
 #include "zapi/utils/PhpFuncs.h"
 #include "zapi/utils/CommonFuncs.h"
@@ -66,14 +72,19 @@ using zapi::lang::Method;
 using zapi::lang::Interface;
 using zapi::lang::Parameters;
 using zapi::lang::StdClass;
+using zapi::lang::PropertySlot;
+using zapi::lang::internal::PropertySlotData;
 using zapi::vm::Property;
+using zapi::vm::AbstractFieldBinding;
+using zapi::vm::GcVisitor;
 using zapi::vm::ObjectBinder;
 using zapi::vm::IteratorBridge;
+using zapi::vm::FastIteratorBridge;
 using zapi::protocol::Countable;
 using zapi::protocol::Traversable;
-using zapi::protocol::Serializable;
 using zapi::protocol::ArrayAccess;
 using zapi::protocol::AbstractIterator;
+using zapi::protocol::FastIterator;
 using zapi::kernel::NotImplemented;
 using zapi::kernel::Exception;
 using zapi::kernel::process_exception;
@@ -222,6 +233,39 @@ zend_class_entry *AbstractClassPrivate::initialize(AbstractClass *cls, const std
    for (std::shared_ptr<AbstractMember> &member : m_members) {
       member->initialize(m_classEntry);
    }
+   // resolve the field bindings to the slots of the declared properties
+   if (m_parent) {
+      m_slotBindings = m_parent->m_implPtr->m_slotBindings;
+      m_lazyProperties.insert(m_parent->m_implPtr->m_lazyProperties.begin(),
+                              m_parent->m_implPtr->m_lazyProperties.end());
+   }
+   for (auto &item : m_fieldBindings) {
+      zend_property_info *info = reinterpret_cast<zend_property_info *>(
+               zend_hash_str_find_ptr(&m_classEntry->properties_info, item.first.c_str(), item.first.size()));
+      if (!info || (info->flags & ZEND_ACC_STATIC)) {
+         continue;
+      }
+      size_t slot = OBJ_PROP_TO_NUM(info->offset);
+      if (slot >= m_slotBindings.size()) {
+         m_slotBindings.resize(slot + 1, nullptr);
+      }
+      m_slotBindings[slot] = item.second.get();
+   }
+   for (auto &item : m_propertySlots) {
+      resolvePropertySlot(item.first, *item.second);
+   }
+   // the lazy properties start unset, they are computed by the read
+   // handler on the first read after each invalidation
+   for (auto &item : m_lazyProperties) {
+      zend_property_info *info = reinterpret_cast<zend_property_info *>(
+               zend_hash_str_find_ptr(&m_classEntry->properties_info, item.first.c_str(), item.first.size()));
+      if (!info || (info->flags & ZEND_ACC_STATIC)) {
+         continue;
+      }
+      zval *value = &m_classEntry->default_properties_table[OBJ_PROP_TO_NUM(info->offset)];
+      zval_ptr_dtor(value);
+      ZVAL_UNDEF(value);
+   }
    // save AbstractClassPrivate instance pointer into the info.user.doc_comment of zend_class_entry
    // we need save the address of this pointer
    AbstractClassPrivate *selfPtr = this;
@@ -240,12 +284,19 @@ std::unique_ptr<zend_function_entry[]>& AbstractClassPrivate::getMethodEntries()
    if (m_methodEntries) {
       return m_methodEntries;
    }
-   m_methodEntries.reset(new zend_function_entry[m_methods.size() + 1]);
+   m_methodEntries.reset(new zend_function_entry[m_methods.size() + 3]);
    size_t i = 0;
    for (std::shared_ptr<Method> &method : m_methods) {
       zend_function_entry *entry = &m_methodEntries[i++];
       method->initialize(entry, m_name.c_str());
    }
+#if PHP_VERSION_ID >= 70400
+   // the array based serialization takes precedence over the handlers
+   if (m_apiPtr->serializable()) {
+      m_methodEntries[i++] = {"__serialize", &AbstractClassPrivate::serializeMethod, nullptr, 0, ZEND_ACC_PUBLIC};
+      m_methodEntries[i++] = {"__unserialize", &AbstractClassPrivate::unserializeMethod, nullptr, 0, ZEND_ACC_PUBLIC};
+   }
+#endif
    // the last item must be set to 0
    // let zend engine know where to stop
    zend_function_entry *last = &m_methodEntries[i];
@@ -276,6 +327,14 @@ zend_object_handlers *AbstractClassPrivate::getObjectHandlers()
    m_handlers.read_property = &AbstractClassPrivate::readProperty;
    m_handlers.has_property = &AbstractClassPrivate::hasProperty;
    m_handlers.unset_property = &AbstractClassPrivate::unsetProperty;
+   m_handlers.get_property_ptr_ptr = &AbstractClassPrivate::getPropertyPtrPtr;
+   m_handlers.get_properties = &AbstractClassPrivate::getProperties;
+   // the cycle collector never needs the rebuilt property table
+   if (m_apiPtr->gcVisitable()) {
+      m_handlers.get_gc = &AbstractClassPrivate::getGc;
+   } else {
+      m_handlers.get_gc = &AbstractClassPrivate::getPropertiesGc;
+   }
    
    // functions for method is called
    m_handlers.get_method = &AbstractClassPrivate::getMethod;
@@ -310,7 +369,13 @@ zend_object *AbstractClassPrivate::createObject(zend_class_entry *entry)
    // instantiate native c++ class associated with the meta class
    AbstractClassPrivate *abstractClsPrivatePtr = retrieve_acp_ptr_from_cls_entry(entry);
    // note: here we use StdClass type to store Derived class
-   std::shared_ptr<StdClass> nativeObject(abstractClsPrivatePtr->m_apiPtr->construct());
+   AbstractClass *meta = abstractClsPrivatePtr->m_apiPtr;
+   // the class releases the object, it may recycle the storage
+   std::shared_ptr<StdClass> nativeObject(meta->construct(), [meta](StdClass *object) {
+      if (object) {
+         meta->destroy(object);
+      }
+   });
    if (!nativeObject) {
       // report error on failure, because this function is called directly from the
       // Zend engine, we can call zend_error() here (which does a longjmp() back to
@@ -338,7 +403,11 @@ zend_object *AbstractClassPrivate::cloneObject(zval *object)
    AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(entry);
    AbstractClass *meta = selfPtr->m_apiPtr;
    StdClass *origObject = objectBinder->getNativeObject();
-   std::unique_ptr<StdClass> newNativeObject(meta->clone(origObject));
+   std::shared_ptr<StdClass> newNativeObject(meta->clone(origObject), [meta](StdClass *nativeObject) {
+      if (nativeObject) {
+         meta->destroy(nativeObject);
+      }
+   });
    // report error on failure (this does not occur because the cloneObject()
    // method is only installed as handler when we have seen that there is indeed
    // a copy constructor). Because this function is directly called from the
@@ -347,7 +416,7 @@ zend_object *AbstractClassPrivate::cloneObject(zval *object)
    if (!newNativeObject) {
       zend_error(E_ERROR, "Unable to clone %s", entry->name);
    }
-   ObjectBinder *newObjectBinder = new ObjectBinder(entry, std::move(newNativeObject), selfPtr->getObjectHandlers(), 1);
+   ObjectBinder *newObjectBinder = new ObjectBinder(entry, newNativeObject, selfPtr->getObjectHandlers(), 1);
    zend_objects_clone_members(newObjectBinder->getZendObject(), objectBinder->getZendObject());
    if (!entry->clone) {
       meta->callClone(newNativeObject.get());
@@ -482,6 +551,10 @@ zend_object_iterator *AbstractClassPrivate::getIterator(zend_class_entry *entry,
    try {
       AbstractIterator *iterator = traversable->getIterator();
       ZAPI_ASSERT_X(iterator,  "AbstractClassPrivate::getIterator", "iterator can't be nullptr");
+      FastIterator *fastIterator = dynamic_cast<FastIterator *>(iterator);
+      if (fastIterator) {
+         return FastIteratorBridge::create(object, fastIterator);
+      }
       // @mark native memory alloc
       // we are going to allocate an extended iterator (because php nowadays destructs
       // the iteraters itself, we can no longer let c++ allocate the buffer + object
@@ -497,16 +570,23 @@ zend_object_iterator *AbstractClassPrivate::getIterator(zend_class_entry *entry,
 
 int AbstractClassPrivate::serialize(zval *object, unsigned char **buffer, size_t *bufLength, zend_serialize_data *data)
 {
-   Serializable *serializable = dynamic_cast<Serializable *>(ObjectBinder::retrieveSelfPtr(object)->getNativeObject());
+   AbstractClass *meta = retrieve_acp_ptr_from_cls_entry(Z_OBJCE_P(object))->m_apiPtr;
+   // the engine takes the emalloc'ed buffer of the smart_string over
+   smart_string output = {0};
    // user may throw an exception in the serialize() function
    try {
-      std::string value = serializable->serialize();
-      *buffer = reinterpret_cast<unsigned char *>(estrndup(value.c_str(), value.length()));
-      *bufLength = value.length();
+      meta->callSerialize(ObjectBinder::retrieveSelfPtr(object)->getNativeObject(), output);
    } catch (Exception &exception) {
+      smart_string_free(&output);
       process_exception(exception);
       return ZAPI_FAILURE; // unreachable, prevent some compiler warning
    }
+   smart_string_0(&output);
+   if (!output.c) {
+      output.c = estrndup("", 0);
+   }
+   *buffer = reinterpret_cast<unsigned char *>(output.c);
+   *bufLength = output.len;
    return ZAPI_SUCCESS;
 }
 
@@ -514,18 +594,73 @@ int AbstractClassPrivate::unserialize(zval *object, zend_class_entry *entry, con
                                       size_t bufLength, zend_unserialize_data *data)
 {
    object_init_ex(object, entry);
-   Serializable *serializable = dynamic_cast<Serializable *>(ObjectBinder::retrieveSelfPtr(object)->getNativeObject());
+   AbstractClass *meta = retrieve_acp_ptr_from_cls_entry(entry)->m_apiPtr;
    // user may throw an exception in the unserialize() function
    try {
-      serializable->unserialize(reinterpret_cast<const char *>(buffer), bufLength);
+      if (meta->callUnserialize(ObjectBinder::retrieveSelfPtr(object)->getNativeObject(),
+                                reinterpret_cast<const char *>(buffer), bufLength)) {
+         return ZAPI_SUCCESS;
+      }
    } catch (Exception &exception) {
       // user threw an exception in its method
       // implementation, send it to user space
-      php_error_docref(NULL, E_NOTICE, "Error while unserializing");
-      return ZAPI_FAILURE;
    }
-   return ZAPI_SUCCESS;
+   php_error_docref(NULL, E_NOTICE, "Error while unserializing");
+   return ZAPI_FAILURE;
+}
+
+#if PHP_VERSION_ID >= 70400
+void AbstractClassPrivate::serializeMethod(zend_execute_data *execute_data, zval *return_value)
+{
+   if (zend_parse_parameters_none() == FAILURE) {
+      return;
+   }
+   zval *object = getThis();
+   AbstractClass *meta = retrieve_acp_ptr_from_cls_entry(Z_OBJCE_P(object))->m_apiPtr;
+   smart_string output = {0};
+   try {
+      meta->callSerialize(ObjectBinder::retrieveSelfPtr(object)->getNativeObject(), output);
+   } catch (Exception &exception) {
+      smart_string_free(&output);
+      process_exception(exception);
+      return;
+   }
+   zval payload;
+   ZVAL_STRINGL(&payload, output.c ? output.c : "", output.len);
+   smart_string_free(&output);
+   array_init_size(return_value, 1);
+   zend_hash_next_index_insert_new(Z_ARRVAL_P(return_value), &payload);
+}
+
+void AbstractClassPrivate::unserializeMethod(zend_execute_data *execute_data, zval *return_value)
+{
+   zval *data;
+   if (zend_parse_parameters(ZEND_NUM_ARGS(), "a", &data) == FAILURE) {
+      return;
+   }
+   zval *object = getThis();
+   zval *payload = zend_hash_index_find(Z_ARRVAL_P(data), 0);
+   if (payload) {
+      ZVAL_DEREF(payload);
+   }
+   if (!payload || Z_TYPE_P(payload) != IS_STRING) {
+      zend_throw_exception(nullptr, "Incomplete or ill-formed serialization data", 0);
+      return;
+   }
+   AbstractClass *meta = retrieve_acp_ptr_from_cls_entry(Z_OBJCE_P(object))->m_apiPtr;
+   // the payload is read in place
+   try {
+      if (meta->callUnserialize(ObjectBinder::retrieveSelfPtr(object)->getNativeObject(),
+                                Z_STRVAL_P(payload), Z_STRLEN_P(payload))) {
+         return;
+      }
+   } catch (Exception &exception) {
+      process_exception(exception);
+      return;
+   }
+   zend_throw_exception(nullptr, "Error while unserializing", 0);
 }
+#endif
 
 HashTable *AbstractClassPrivate::debugInfo(zval *object, int *isTemp)
 {
@@ -574,6 +709,15 @@ zval *AbstractClassPrivate::readProperty(zval *object, zval *name, int type, voi
       AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(Z_OBJCE_P(object));
       AbstractClass *meta = selfPtr->m_apiPtr;
       StdClass *nativeObject = objectBinder->getNativeObject();
+      AbstractFieldBinding *binding = selfPtr->findFieldBinding(Z_OBJCE_P(object), name, cacheSlot);
+      if (binding) {
+         binding->read(nativeObject, rv);
+         return rv;
+      }
+      zval *lazySlot = selfPtr->findLazyProperty(object, name, cacheSlot);
+      if (lazySlot) {
+         return lazySlot;
+      }
       std::string key(Z_STRVAL_P(name), Z_STRLEN_P(name));
       auto iter = selfPtr->m_properties.find(key);
       if (iter != selfPtr->m_properties.end()) {
@@ -602,6 +746,19 @@ void AbstractClassPrivate::writeProperty(zval *object, zval *name, zval *value,
       AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(Z_OBJCE_P(object));
       AbstractClass *meta = selfPtr->m_apiPtr;
       StdClass *nativeObject = objectBinder->getNativeObject();
+      AbstractFieldBinding *binding = selfPtr->findFieldBinding(Z_OBJCE_P(object), name, cacheSlot);
+      if (binding) {
+         if (!binding->write(nativeObject, value)) {
+            zend_throw_error(zend_ce_type_error, "Cannot assign %s to property %s::$%s",
+                             zend_zval_type_name(value), ZSTR_VAL(Z_OBJCE_P(object)->name), Z_STRVAL_P(name));
+         }
+         return;
+      }
+      if (selfPtr->isLazyProperty(name)) {
+         zend_throw_error(nullptr, "Cannot modify read-only property %s::$%s",
+                          ZSTR_VAL(Z_OBJCE_P(object)->name), Z_STRVAL_P(name));
+         return;
+      }
       std::string key(Z_STRVAL_P(name), Z_STRLEN_P(name));
       auto iter = selfPtr->m_properties.find(key);
       if (iter != selfPtr->m_properties.end()) {
@@ -629,6 +786,24 @@ int AbstractClassPrivate::hasProperty(zval *object, zval *name, int hasSetExists
       AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(Z_OBJCE_P(object));
       AbstractClass *meta = selfPtr->m_apiPtr;
       StdClass *nativeObject = objectBinder->getNativeObject();
+      AbstractFieldBinding *binding = selfPtr->findFieldBinding(Z_OBJCE_P(object), name, cacheSlot);
+      if (binding) {
+         if (2 == hasSetExists) {
+            return true;
+         }
+         zval value;
+         binding->read(nativeObject, &value);
+         int result = 0 == hasSetExists ? Z_TYPE(value) != IS_NULL : zend_is_true(&value);
+         zval_ptr_dtor(&value);
+         return result;
+      }
+      if (2 == hasSetExists && selfPtr->isLazyProperty(name)) {
+         return true;
+      }
+      zval *lazySlot = selfPtr->findLazyProperty(object, name, cacheSlot);
+      if (lazySlot) {
+         return 0 == hasSetExists ? Z_TYPE_P(lazySlot) != IS_NULL : zend_is_true(lazySlot);
+      }
       std::string key(Z_STRVAL_P(name), Z_STRLEN_P(name));
       // here we need check the hasSetExists
       if (selfPtr->m_properties.find(key) != selfPtr->m_properties.end()) {
@@ -665,7 +840,9 @@ void AbstractClassPrivate::unsetProperty(zval *object, zval *name, void **cacheS
       AbstractClass *meta = selfPtr->m_apiPtr;
       StdClass *nativeObject = objectBinder->getNativeObject();
       std::string key(Z_STRVAL_P(name), Z_STRLEN_P(name));
-      if (selfPtr->m_properties.find(key) == selfPtr->m_properties.end()) {
+      if (selfPtr->m_properties.find(key) == selfPtr->m_properties.end() &&
+          !selfPtr->findFieldBinding(Z_OBJCE_P(object), name, cacheSlot) &&
+          !selfPtr->isLazyProperty(name)) {
          meta->callUnset(nativeObject, key);
          return;
       }
@@ -680,6 +857,217 @@ void AbstractClassPrivate::unsetProperty(zval *object, zval *name, void **cacheS
    }
 }
 
+zval *AbstractClassPrivate::getPropertyPtrPtr(zval *object, zval *name, int type, void **cacheSlot)
+{
+   // the bound properties live in the native object, the engine falls back
+   // to read_property and write_property when no pointer is returned
+   AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(Z_OBJCE_P(object));
+   if (selfPtr->findFieldBinding(Z_OBJCE_P(object), name, cacheSlot)) {
+      return nullptr;
+   }
+   // the lazy ones are read-only, the fallback read would hand out their
+   // slot and let a reference or an indirect write through
+   if (selfPtr->isLazyProperty(name)) {
+      zend_throw_error(nullptr, "Cannot modify read-only property %s::$%s",
+                       ZSTR_VAL(Z_OBJCE_P(object)->name), Z_STRVAL_P(name));
+      return &EG(error_zval);
+   }
+   return zend_std_get_property_ptr_ptr(object, name, type, cacheSlot);
+}
+
+HashTable *AbstractClassPrivate::getProperties(zval *object)
+{
+   // copy the bound members into their slots so foreach, var_dump and
+   // the array cast see the current values
+   AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(Z_OBJCE_P(object));
+   if (!selfPtr->m_slotBindings.empty()) {
+      syncBoundSlots(ObjectBinder::retrieveSelfPtr(object), true);
+   }
+   return zend_std_get_properties(object);
+}
+
+void AbstractClassPrivate::syncBoundSlots(ObjectBinder *binder, bool publish)
+{
+   zend_object *zobject = binder->getZendObject();
+   AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(zobject->ce);
+   StdClass *nativeObject = binder->m_nativeObject.get();
+   if (!binder->m_boundShadow) {
+      // the table is handed out for the first time, unserialize(), the
+      // binary reader and foreach by reference write the slots through it
+      binder->m_boundShadowCount = static_cast<uint32_t>(
+               std::min(selfPtr->m_slotBindings.size(), static_cast<size_t>(zobject->ce->default_properties_count)));
+      binder->m_boundShadow = static_cast<zval *>(ecalloc(binder->m_boundShadowCount, sizeof(zval)));
+   }
+   for (uint32_t slot = 0; slot < binder->m_boundShadowCount; ++slot) {
+      AbstractFieldBinding *binding = selfPtr->m_slotBindings[slot];
+      if (!binding) {
+         continue;
+      }
+      zval *target = OBJ_PROP_NUM(zobject, slot);
+      // keep the reference that foreach by reference made on the slot
+      ZVAL_DEREF(target);
+      zval *shadow = binder->m_boundShadow + slot;
+      bool changed = Z_TYPE_P(shadow) != IS_UNDEF && !fast_is_identical_function(target, shadow);
+      if (!changed && !publish) {
+         continue;
+      }
+      // a value the member can't take is replaced by the member value
+      if (changed) {
+         binding->write(nativeObject, target);
+      }
+      zval value;
+      binding->read(nativeObject, &value);
+      zval_ptr_dtor(shadow);
+      ZVAL_COPY(shadow, &value);
+      zval garbage;
+      ZVAL_COPY_VALUE(&garbage, target);
+      ZVAL_COPY_VALUE(target, &value);
+      zval_ptr_dtor(&garbage);
+   }
+}
+
+bool AbstractClassPrivate::isLazyProperty(zval *name) const
+{
+   return !m_lazyProperties.empty() && Z_TYPE_P(name) == IS_STRING &&
+         m_lazyProperties.find(std::string(Z_STRVAL_P(name), Z_STRLEN_P(name))) != m_lazyProperties.end();
+}
+
+bool AbstractClassPrivate::isLazyProperty(zend_class_entry *entry, const std::string &name)
+{
+   AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(entry);
+   return selfPtr->m_lazyProperties.find(name) != selfPtr->m_lazyProperties.end();
+}
+
+zval *AbstractClassPrivate::findLazyProperty(zval *object, zval *name, void **cacheSlot)
+{
+   if (m_lazyProperties.empty() || Z_TYPE_P(name) != IS_STRING) {
+      return nullptr;
+   }
+   zend_object *zobject = Z_OBJ_P(object);
+   // cached under the tagged entry pointer like the bound properties, the
+   // executor would otherwise read and write the slot directly
+   void *tag = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(zobject->ce) | 1);
+   uintptr_t offset;
+   Property *compute = nullptr;
+   if (cacheSlot && CACHED_PTR_EX(cacheSlot) == tag) {
+      offset = reinterpret_cast<uintptr_t>(CACHED_PTR_EX(cacheSlot + 1));
+   } else {
+      auto lazy = m_lazyProperties.find(std::string(Z_STRVAL_P(name), Z_STRLEN_P(name)));
+      if (lazy == m_lazyProperties.end()) {
+         return nullptr;
+      }
+      zend_property_info *info = reinterpret_cast<zend_property_info *>(
+               zend_hash_find_ptr(&zobject->ce->properties_info, Z_STR_P(name)));
+      if (!info || (info->flags & ZEND_ACC_STATIC)) {
+         return nullptr;
+      }
+      offset = info->offset;
+      compute = lazy->second.get();
+      if (cacheSlot) {
+         CACHE_POLYMORPHIC_PTR_EX(cacheSlot, tag, reinterpret_cast<void *>(offset));
+      }
+   }
+   zval *slot = OBJ_PROP(zobject, offset);
+   if (Z_TYPE_P(slot) != IS_UNDEF) {
+      return slot;
+   }
+   if (!compute) {
+      compute = m_lazyProperties[std::string(Z_STRVAL_P(name), Z_STRLEN_P(name))].get();
+   }
+   zval value = compute->get(ObjectBinder::retrieveSelfPtr(object)->getNativeObject()).detach(true);
+   // the computation may have run code that filled the slot meanwhile
+   zval garbage;
+   ZVAL_COPY_VALUE(&garbage, slot);
+   ZVAL_COPY_VALUE(slot, &value);
+   zval_ptr_dtor(&garbage);
+   return slot;
+}
+
+HashTable *AbstractClassPrivate::getGc(zval *object, zval **table, int *count)
+{
+   zend_object *zobject = Z_OBJ_P(object);
+   ObjectBinder *binder = ObjectBinder::retrieveSelfPtr(zobject);
+   AbstractClassPrivate *selfPtr = retrieve_acp_ptr_from_cls_entry(zobject->ce);
+   GcVisitor visitor(binder->m_gcBuffer, binder->m_gcCapacity);
+   // the declared slots are reached through the property table once it exists
+   if (!zobject->properties) {
+      zval *slot = zobject->properties_table;
+      zval *end = slot + zobject->ce->default_properties_count;
+      for (; slot != end; ++slot) {
+         visitor.visit(slot);
+      }
+   }
+   // no sync of the bound slots while the collector runs
+   selfPtr->m_apiPtr->callGcVisit(binder->m_nativeObject.get(), visitor);
+   *table = binder->m_gcBuffer;
+   *count = static_cast<int>(visitor.getCount());
+   return zobject->properties;
+}
+
+HashTable *AbstractClassPrivate::getPropertiesGc(zval *object, zval **table, int *count)
+{
+   zend_object *zobject = Z_OBJ_P(object);
+   if (zobject->properties) {
+      *table = nullptr;
+      *count = 0;
+      return zobject->properties;
+   }
+   *table = zobject->properties_table;
+   *count = zobject->ce->default_properties_count;
+   return nullptr;
+}
+
+void AbstractClassPrivate::resolvePropertySlot(const std::string &name, PropertySlotData &slot)
+{
+   zend_property_info *info = reinterpret_cast<zend_property_info *>(
+            zend_hash_str_find_ptr(&m_classEntry->properties_info, name.c_str(), name.size()));
+   if (!info || (info->flags & ZEND_ACC_STATIC)) {
+      std::cerr << "Property slot " << m_name << "::$" << name
+                << " is not a declared instance property: slot is ignored" << std::endl;
+      return;
+   }
+   slot.m_offset = info->offset;
+   slot.m_scope = m_classEntry;
+}
+
+AbstractFieldBinding *AbstractClassPrivate::findFieldBinding(zend_class_entry *entry, zval *name, void **cacheSlot)
+{
+   if (m_slotBindings.empty() || Z_TYPE_P(name) != IS_STRING) {
+      return nullptr;
+   }
+   uintptr_t offset;
+   // the executor reads a declared slot directly when the cache slot holds
+   // the class entry, so the bound properties are cached under the entry
+   // pointer tagged with the low bit, the offset is in the same place as
+   // the one the standard handlers cache for the other properties
+   void *tag = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(entry) | 1);
+   void *cached = cacheSlot ? CACHED_PTR_EX(cacheSlot) : nullptr;
+   if (cached == tag) {
+      // the lazy properties are cached under the same tag
+      size_t slot = OBJ_PROP_TO_NUM(reinterpret_cast<uintptr_t>(CACHED_PTR_EX(cacheSlot + 1)));
+      return slot < m_slotBindings.size() ? m_slotBindings[slot] : nullptr;
+   }
+   if (cached == entry) {
+      offset = reinterpret_cast<uintptr_t>(CACHED_PTR_EX(cacheSlot + 1));
+   } else {
+      zend_property_info *info = reinterpret_cast<zend_property_info *>(
+               zend_hash_find_ptr(&entry->properties_info, Z_STR_P(name)));
+      if (!info || (info->flags & ZEND_ACC_STATIC)) {
+         return nullptr;
+      }
+      offset = info->offset;
+   }
+   if (offset < OBJ_PROP_TO_OFFSET(0) || offset >= OBJ_PROP_TO_OFFSET(entry->default_properties_count)) {
+      return nullptr;
+   }
+   size_t slot = OBJ_PROP_TO_NUM(offset);
+   AbstractFieldBinding *binding = slot < m_slotBindings.size() ? m_slotBindings[slot] : nullptr;
+   if (binding && cacheSlot) {
+      CACHE_POLYMORPHIC_PTR_EX(cacheSlot, tag, reinterpret_cast<void *>(offset));
+   }
+   return binding;
+}
+
 zend_function *AbstractClassPrivate::getMethod(zend_object **object, zend_string *methodName, const zval *key)
 {
    zend_function *defaultFuncInfo = std_object_handlers.get_method(object, methodName, key);
@@ -1128,6 +1516,42 @@ void AbstractClass::registerProperty(const char *name, const zapi::GetterMethodC
    implPtr->m_properties[name] = std::make_shared<Property>(getter, setter);
 }
 
+void AbstractClass::registerFieldBinding(const char *name, std::shared_ptr<AbstractFieldBinding> binding)
+{
+   ZAPI_D(AbstractClass);
+   // the declared property gives the binding a slot the engine resolves and caches
+   implPtr->m_members.push_back(std::make_shared<NullMember>(name, Modifier::Public));
+   implPtr->m_fieldBindings[name] = std::move(binding);
+}
+
+PropertySlot AbstractClass::getPropertySlot(const char *name)
+{
+   ZAPI_D(AbstractClass);
+   std::shared_ptr<PropertySlotData> &slot = implPtr->m_propertySlots[name];
+   if (!slot) {
+      slot = std::make_shared<PropertySlotData>();
+      // the slots asked for before MINIT are resolved by initialize()
+      if (implPtr->m_classEntry) {
+         implPtr->resolvePropertySlot(name, *slot);
+      }
+   }
+   return PropertySlot(slot);
+}
+
+void AbstractClass::registerLazyProperty(const char *name, const zapi::GetterMethodCallable0 &compute)
+{
+   ZAPI_D(AbstractClass);
+   implPtr->m_members.push_back(std::make_shared<NullMember>(name, Modifier::Public));
+   implPtr->m_lazyProperties[name] = std::make_shared<Property>(compute);
+}
+
+void AbstractClass::registerLazyProperty(const char *name, const zapi::GetterMethodCallable1 &compute)
+{
+   ZAPI_D(AbstractClass);
+   implPtr->m_members.push_back(std::make_shared<NullMember>(name, Modifier::Public));
+   implPtr->m_lazyProperties[name] = std::make_shared<Property>(compute);
+}
+
 void AbstractClass::registerConstant(const Constant &constant)
 {
    const zend_constant &zendConst = constant.getZendConstant();
@@ -1185,6 +1609,11 @@ StdClass *AbstractClass::clone(StdClass *orig) const
    return nullptr;
 }
 
+void AbstractClass::destroy(StdClass *nativeObject) const
+{
+   delete nativeObject;
+}
+
 int AbstractClass::callCompare(StdClass *left, StdClass *right) const
 {
    return 1;
@@ -1216,6 +1645,17 @@ ArrayVariant AbstractClass::callDebugInfo(StdClass *nativeObject) const
    return nullptr;
 }
 
+void AbstractClass::callSerialize(StdClass *nativeObject, smart_string &buffer) const
+{}
+
+bool AbstractClass::callUnserialize(StdClass *nativeObject, const char *input, size_t length) const
+{
+   return false;
+}
+
+void AbstractClass::callGcVisit(StdClass *nativeObject, GcVisitor &visitor) const
+{}
+
 Variant AbstractClass::callGet(StdClass *nativeObject, const std::string &name) const
 {
    return nullptr;
@@ -1268,6 +1708,11 @@ bool AbstractClass::traversable() const
    return false;
 }
 
+bool AbstractClass::gcVisitable() const
+{
+   return false;
+}
+
 zend_class_entry *AbstractClass::initialize(const std::string &prefix, int moduleNumber)
 {
    return getImplPtr()->initialize(this, prefix, moduleNumber);
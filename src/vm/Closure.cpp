@@ -15,7 +15,12 @@
 
 #include "zapi/vm/Closure.h"
 #include "zapi/vm/AbstractClass.h"
+#include "zapi/vm/ObjectBinder.h"
+#include "zapi/vm/internal/AbstractClassPrivate.h"
 #include "zapi/lang/Class.h"
+#include "zapi/lang/Parameters.h"
+#include "zapi/kernel/OrigException.h"
+#include <cstring>
 
 namespace zapi
 {
@@ -24,18 +29,81 @@ namespace vm
 
 using zapi::lang::Class;
 using zapi::lang::ClassType;
+using zapi::vm::internal::AbstractClassPrivate;
+using zapi::kernel::Exception;
+using zapi::kernel::OrigException;
 
 zend_class_entry *Closure::m_entry = nullptr;
+zend_internal_function Closure::sm_invokeFunc;
 
 Closure::Closure(const ClosureCallableType &callable)
    : m_callable(callable)
 {}
 
+Closure::Closure(ClosureCallableType &&callable)
+   : m_callable(std::move(callable))
+{}
+
 Variant Closure::__invoke(Parameters &params) const
 {
    return m_callable(params);
 }
 
+void Closure::create(zval *target, ClosureCallableType callable)
+{
+   ZAPI_ASSERT_X(m_entry, "Closure::create", "the closure class is registered at MINIT");
+   ObjectBinder *binder = new ObjectBinder(m_entry, std::make_shared<Closure>(std::move(callable)),
+                                           AbstractClassPrivate::getObjectHandlers(m_entry), 1);
+   ZVAL_OBJ(target, binder->getZendObject());
+}
+
+bool Closure::isClosure(const zval *value)
+{
+   ZVAL_DEREF(value);
+   return Z_TYPE_P(value) == IS_OBJECT && m_entry && Z_OBJCE_P(value) == m_entry;
+}
+
+Variant Closure::call(zval *object, zval *arguments, uint32_t argc)
+{
+   Closure *closure = static_cast<Closure *>(ObjectBinder::retrieveSelfPtr(object)->getNativeObject());
+   Parameters params(closure, arguments, argc);
+   // converted the way a call through the engine is, the caller only ever
+   // sees an OrigException
+   zend_object *oldException = EG(exception);
+   Variant result;
+   try {
+      result = closure->m_callable(params);
+   } catch (Exception &exception) {
+      zapi::kernel::process_exception(exception);
+   }
+   if (oldException != EG(exception) && EG(exception)) {
+      throw OrigException(EG(exception));
+   }
+   return result;
+}
+
+void Closure::invoke(INTERNAL_FUNCTION_PARAMETERS)
+{
+   Closure *closure = static_cast<Closure *>(ObjectBinder::retrieveSelfPtr(getThis())->getNativeObject());
+   try {
+      // the arguments of an internal call are contiguous in the frame
+      Parameters params(closure, ZEND_CALL_ARG(execute_data, 1), ZEND_NUM_ARGS());
+      zval temp = closure->m_callable(params).detach(false);
+      ZVAL_COPY(return_value, &temp);
+   } catch (Exception &exception) {
+      zapi::kernel::process_exception(exception);
+   }
+}
+
+int Closure::getClosure(zval *object, zend_class_entry **entry, zend_function **retFunc,
+                        zend_object **objectPtr)
+{
+   *entry = m_entry;
+   *retFunc = reinterpret_cast<zend_function *>(&sm_invokeFunc);
+   *objectPtr = Z_OBJ_P(object);
+   return ZAPI_SUCCESS;
+}
+
 void Closure::registerToZendNg(int moduleNumber)
 {
    // here we register ourself to zend engine
@@ -45,6 +113,16 @@ void Closure::registerToZendNg(int moduleNumber)
    // @mark we save meta class as local static is really ok ?
    static std::unique_ptr<AbstractClass> closureWrapper(new Class<Closure>("ZapiClosure", ClassType::Final));
    m_entry = closureWrapper->initialize(moduleNumber);
+   // every closure object is called through the same internal function,
+   // it is never freed by the engine since it is not a trampoline
+   std::memset(&sm_invokeFunc, 0, sizeof(sm_invokeFunc));
+   sm_invokeFunc.type = ZEND_INTERNAL_FUNCTION;
+   sm_invokeFunc.fn_flags = ZEND_ACC_PUBLIC;
+   sm_invokeFunc.function_name = zend_new_interned_string(
+            zend_string_init(ZEND_INVOKE_FUNC_NAME, sizeof(ZEND_INVOKE_FUNC_NAME) - 1, 1));
+   sm_invokeFunc.scope = m_entry;
+   sm_invokeFunc.handler = &Closure::invoke;
+   AbstractClassPrivate::getObjectHandlers(m_entry)->get_closure = &Closure::getClosure;
 }
 
 void Closure::unregisterFromZendNg()
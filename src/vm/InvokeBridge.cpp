@@ -17,12 +17,41 @@
 #include "zapi/vm/InvokeBridge.h"
 #include "zapi/kernel/OrigException.h"
 #include "zapi/vm/ObjectBinder.h"
+#include <unordered_map>
+
+namespace
+{
+
+using zapi::vm::DirectInvokeCallable;
+
+// filled while the classes are registered, read only afterwards
+std::unordered_map<zapi::ZendCallable, DirectInvokeCallable> &direct_invoke_registry()
+{
+   static std::unordered_map<zapi::ZendCallable, DirectInvokeCallable> registry;
+   return registry;
+}
+
+} // anonymous namespace
 
 namespace zapi
 {
 namespace vm
 {
 
+void register_direct_invoke(ZendCallable handler, DirectInvokeCallable direct)
+{
+   if (handler && direct) {
+      direct_invoke_registry()[handler] = direct;
+   }
+}
+
+DirectInvokeCallable find_direct_invoke(ZendCallable handler)
+{
+   auto &registry = direct_invoke_registry();
+   auto iter = registry.find(handler);
+   return iter != registry.end() ? iter->second : nullptr;
+}
+
 } // vm
 } // zapi
 
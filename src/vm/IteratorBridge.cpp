@@ -15,6 +15,8 @@
 
 #include "zapi/vm/IteratorBridge.h"
 #include "zapi/protocol/AbstractIterator.h"
+#include "zapi/protocol/FastIterator.h"
+#include "zapi/kernel/OrigException.h"
 
 namespace zapi
 {
@@ -131,5 +133,92 @@ void IteratorBridge::invalidate(zend_object_iterator *iterator)
    getSelfPtr(iterator)->invalidate();
 }
 
+zend_object_iterator *FastIteratorBridge::create(zval *object, FastIterator *iterator)
+{
+   FastIteratorBridge *bridge = static_cast<FastIteratorBridge *>(emalloc(sizeof(FastIteratorBridge)));
+   zend_iterator_init(&bridge->m_iterator);
+   ZVAL_COPY(&bridge->m_iterator.data, object);
+   bridge->m_iterator.funcs = getIteratorFuncs();
+   bridge->m_nativeIterator = iterator;
+   return &bridge->m_iterator;
+}
+
+zend_object_iterator_funcs *FastIteratorBridge::getIteratorFuncs()
+{
+   static zend_object_iterator_funcs funcs;
+   static bool initialized = false;
+   if (initialized) {
+      return &funcs;
+   }
+   funcs.dtor = &FastIteratorBridge::destructor;
+   funcs.valid = &FastIteratorBridge::valid;
+   funcs.get_current_data = &FastIteratorBridge::current;
+   funcs.get_current_key = &FastIteratorBridge::key;
+   funcs.move_forward = &FastIteratorBridge::next;
+   funcs.rewind = &FastIteratorBridge::rewind;
+   // nothing is cached between the steps, there is nothing to invalidate
+   funcs.invalidate_current = nullptr;
+   initialized = true;
+   return &funcs;
+}
+
+FastIterator *FastIteratorBridge::getNativeIterator(zend_object_iterator *iterator)
+{
+   return reinterpret_cast<FastIteratorBridge *>(iterator)->m_nativeIterator;
+}
+
+void FastIteratorBridge::destructor(zend_object_iterator *iterator)
+{
+   zval_ptr_dtor(&iterator->data);
+}
+
+int FastIteratorBridge::valid(zend_object_iterator *iterator)
+{
+   try {
+      return getNativeIterator(iterator)->valid() ? ZAPI_SUCCESS : ZAPI_FAILURE;
+   } catch (zapi::kernel::Exception &exception) {
+      zapi::kernel::process_exception(exception);
+   }
+   return ZAPI_FAILURE;
+}
+
+zval *FastIteratorBridge::current(zend_object_iterator *iterator)
+{
+   try {
+      return getNativeIterator(iterator)->currentValue();
+   } catch (zapi::kernel::Exception &exception) {
+      zapi::kernel::process_exception(exception);
+   }
+   return nullptr;
+}
+
+void FastIteratorBridge::key(zend_object_iterator *iterator, zval *data)
+{
+   try {
+      getNativeIterator(iterator)->currentKey(data);
+   } catch (zapi::kernel::Exception &exception) {
+      ZVAL_NULL(data);
+      zapi::kernel::process_exception(exception);
+   }
+}
+
+void FastIteratorBridge::next(zend_object_iterator *iterator)
+{
+   try {
+      getNativeIterator(iterator)->next();
+   } catch (zapi::kernel::Exception &exception) {
+      zapi::kernel::process_exception(exception);
+   }
+}
+
+void FastIteratorBridge::rewind(zend_object_iterator *iterator)
+{
+   try {
+      getNativeIterator(iterator)->rewind();
+   } catch (zapi::kernel::Exception &exception) {
+      zapi::kernel::process_exception(exception);
+   }
+}
+
 } // vm
 } // zapi
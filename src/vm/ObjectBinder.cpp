@@ -16,6 +16,8 @@
 #include "zapi/vm/ObjectBinder.h"
 #include "zapi/lang/StdClass.h"
 #include "zapi/lang/internal/StdClassPrivate.h"
+#include "zapi/vm/AbstractClass.h"
+#include "zapi/vm/internal/AbstractClassPrivate.h"
 #include <cstring>
 namespace zapi
 {
@@ -24,6 +26,7 @@ namespace vm
 
 using zapi::lang::StdClass;
 using zapi::lang::internal::StdClassPrivate;
+using zapi::vm::internal::AbstractClassPrivate;
 
 ObjectBinder::ObjectBinder(zend_class_entry *entry, std::shared_ptr<StdClass> nativeObject,
                            const zend_object_handlers *objectHandlers, uint32_t refCount)
@@ -51,6 +54,15 @@ zend_object *ObjectBinder::getZendObject() const
 ObjectBinder::~ObjectBinder()
 {
    zend_object_std_dtor(&m_container->m_zendObject);
+   if (m_gcBuffer) {
+      efree(m_gcBuffer);
+   }
+   if (m_boundShadow) {
+      for (uint32_t i = 0; i < m_boundShadowCount; ++i) {
+         zval_ptr_dtor(&m_boundShadow[i]);
+      }
+      efree(m_boundShadow);
+   }
 }
 
 void ObjectBinder::destroy()
@@ -60,6 +72,10 @@ void ObjectBinder::destroy()
 
 StdClass *ObjectBinder::getNativeObject() const
 {
+   if (m_boundShadow) {
+      // the members catch up with the writes made through the property table
+      AbstractClassPrivate::syncBoundSlots(const_cast<ObjectBinder *>(this), false);
+   }
    return m_nativeObject.get();
 }
 
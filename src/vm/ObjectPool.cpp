@@ -0,0 +1,130 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "zapi/vm/ObjectPool.h"
+#include <vector>
+#include <algorithm>
+
+namespace zapi
+{
+namespace vm
+{
+
+namespace
+{
+std::vector<ObjectPool *> &pool_registry()
+{
+   static std::vector<ObjectPool *> pools;
+   return pools;
+}
+} // anonymous namespace
+
+ObjectPool::ObjectPool(size_t objectSize)
+   : m_objectSize(std::max(objectSize, sizeof(FreeBlock))),
+     m_capacity(0),
+     // the pools created in the middle of a request start recycling at once
+     m_active(PG(modules_activated) != 0),
+     m_routingFixed(false),
+     m_routed(false),
+     m_freeList(nullptr)
+{
+#ifndef ZTS
+   pool_registry().push_back(this);
+#endif
+}
+
+ObjectPool::~ObjectPool()
+{
+#ifndef ZTS
+   std::vector<ObjectPool *> &pools = pool_registry();
+   pools.erase(std::remove(pools.begin(), pools.end(), this), pools.end());
+#endif
+}
+
+void ObjectPool::setCapacity(size_t capacity) ZAPI_DECL_NOEXCEPT
+{
+#ifdef ZTS
+   // the free list and the statistics would be shared by the threads while
+   // the blocks belong to the request memory of one of them
+   (void) capacity;
+#else
+   m_capacity = capacity;
+#endif
+}
+
+void *ObjectPool::allocate()
+{
+   ++m_stats.live;
+   m_stats.highWater = std::max(m_stats.highWater, m_stats.live);
+   if (m_freeList) {
+      FreeBlock *block = m_freeList;
+      m_freeList = block->next;
+      --m_stats.pooled;
+      ++m_stats.hits;
+      return block;
+   }
+   ++m_stats.misses;
+   return emalloc(m_objectSize);
+}
+
+void ObjectPool::release(void *storage)
+{
+   --m_stats.live;
+   if (!m_active || m_stats.pooled >= m_capacity) {
+      efree(storage);
+      return;
+   }
+   FreeBlock *block = static_cast<FreeBlock *>(storage);
+   block->next = m_freeList;
+   m_freeList = block;
+   ++m_stats.pooled;
+}
+
+void ObjectPool::drain()
+{
+   while (m_freeList) {
+      FreeBlock *block = m_freeList;
+      m_freeList = block->next;
+      efree(block);
+   }
+   m_stats.pooled = 0;
+}
+
+void ObjectPool::resetStats() ZAPI_DECL_NOEXCEPT
+{
+   m_stats.hits = 0;
+   m_stats.misses = 0;
+   m_stats.highWater = m_stats.live;
+}
+
+void ObjectPool::activateAll()
+{
+   for (ObjectPool *pool : pool_registry()) {
+      pool->m_active = true;
+   }
+}
+
+void ObjectPool::drainAll()
+{
+   // the objects freed by the executor shutdown come after RSHUTDOWN,
+   // they must not be left on a list that outlives the request memory
+   for (ObjectPool *pool : pool_registry()) {
+      pool->drain();
+      pool->m_active = false;
+   }
+}
+
+} // vm
+} // zapi
@@ -0,0 +1,47 @@
+<?php
+ob_start();
+if (function_exists("binary_round_trip")) {
+   $point = new BinaryPoint();
+   $point->moveTo(3, -7);
+   $shared = new stdClass();
+   $shared->name = "shared";
+   $shared->self = $shared;
+   $data = [
+      "points" => [$point, $point],
+      "shared" => [$shared, $shared],
+      "list" => [1, 2, 3, 4, 5, 1.5, 2.5, 3.5, 4.5, "tail"],
+      "flags" => [true, false, null],
+   ];
+   $copy = binary_round_trip($data);
+   echo get_class($copy["points"][0]) . "\n";
+   echo $copy["points"][0]->getX() . "," . $copy["points"][0]->getY() . "\n";
+   if ($copy["points"][0] === $copy["points"][1] && $copy["points"][0] !== $point) {
+      echo "same point\n";
+   }
+   if ($copy["shared"][0] === $copy["shared"][1] && $copy["shared"][0]->self === $copy["shared"][0]) {
+      echo "same object\n";
+   }
+   echo $copy["shared"][0]->name . "\n";
+   if ($copy["list"] === $data["list"] && $copy["flags"] === $data["flags"]) {
+      echo "lists equal\n";
+   }
+   var_dump(binary_round_trip(function () {}));
+   var_dump(binary_round_trip(new ArrayObject([1, 2])));
+   var_dump(binary_round_trip([new DateTime("2017-01-01")]));
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+BinaryPoint
+3,-7
+same point
+same object
+shared
+lists equal
+NULL
+NULL
+NULL
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,33 @@
+<?php
+ob_start();
+if (function_exists("get_persistent_table")) {
+   // the request copies add and drop keys, under ZTS the shared keys and
+   // strings must come out of it untouched
+   for ($i = 0; $i < 50; $i++) {
+      $table = get_persistent_table();
+      $table["extra" . $i] = $table["version"];
+      $table["codes"]["FR"] = "France";
+      unset($table["codes"]["CN"]);
+      $codes = array_flip($table["codes"]);
+      $table[0] = array_merge($table[0], array_keys($codes));
+      unset($table, $codes);
+   }
+   $origin = get_persistent_table();
+   echo count($origin) . " " . $origin["version"] . "\n";
+   foreach ($origin["codes"] as $code => $name) {
+      echo $code . "=" . $name . "\n";
+   }
+   echo implode(",", $origin[0]) . "\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+5 3
+CN=China
+DE=Germany
+US=United States
+1,2,3
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,38 @@
+<?php
+ob_start();
+if (function_exists("get_persistent_table")) {
+   $table = get_persistent_table();
+   if ($table === get_persistent_table()) {
+      echo "success\n";
+   }
+   echo $table["codes"]["CN"] . "\n";
+   echo $table["version"] . "\n";
+   echo implode(",", $table[0]) . "\n";
+   // writes separate a request local copy
+   $table["codes"]["FR"] = "France";
+   $table[0][] = 4;
+   echo count($table["codes"]) . "\n";
+   $origin = get_persistent_table();
+   echo count($origin["codes"]) . "\n";
+   echo count($origin[0]) . "\n";
+   foreach ($origin["codes"] as $code => $name) {
+      echo $code . "=" . $name . "\n";
+   }
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+success
+China
+3
+1,2,3
+4
+3
+3
+CN=China
+DE=Germany
+US=United States
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
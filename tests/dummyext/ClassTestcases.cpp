@@ -164,6 +164,7 @@ void register_inherit_test_classes(Extension &extension)
    c.registerMethod<decltype(&C::printInfo), &C::printInfo>("printInfo");
    c.registerMethod<decltype(&C::testCallParentPassRefArg), &C::testCallParentPassRefArg>("testCallParentPassRefArg");
    c.registerMethod<decltype(&C::testCallParentWithReturn), &C::testCallParentWithReturn>("testCallParentWithReturn");
+   c.registerMethod<decltype(&C::testCallParentCached), &C::testCallParentCached>("testCallParentCached");
    c.registerMethod<decltype(&C::testGetObjectVaraintPtr), &C::testGetObjectVaraintPtr>("testGetObjectVaraintPtr");
    c.registerMethod<decltype(&C::privateCMethod), &C::privateCMethod>("privateCMethod", Modifier::Private);
    c.registerMethod<decltype(&C::protectedCMethod), &C::protectedCMethod>("protectedCMethod", Modifier::Protected);
@@ -183,6 +184,10 @@ void register_iterator_test_classes(Extension &extension)
 {
    zapi::lang::Class<IterateTestClass> iterateTestClass("IterateTestClass");
    extension.registerClass(iterateTestClass);
+   
+   zapi::lang::Class<FastIterateTestClass> fastIterateTestClass("FastIterateTestClass");
+   fastIterateTestClass.registerMethod<decltype(&FastIterateTestClass::sumByVariant), &FastIterateTestClass::sumByVariant>("sumByVariant");
+   extension.registerClass(fastIterateTestClass);
 }
 
 void register_closure_test_classes(Extension &extension)
@@ -191,6 +196,14 @@ void register_closure_test_classes(Extension &extension)
    closureTestClass.registerMethod<decltype(&ClosureTestClass::testClosureCallable), &ClosureTestClass::testClosureCallable>("testClosureCallable");
    closureTestClass.registerMethod<decltype(&ClosureTestClass::getNoArgAndReturnCallable), &ClosureTestClass::getNoArgAndReturnCallable>("getNoArgAndReturnCallable");
    closureTestClass.registerMethod<decltype(&ClosureTestClass::getArgAndReturnCallable), &ClosureTestClass::getArgAndReturnCallable>("getArgAndReturnCallable");
+   closureTestClass.registerMethod<decltype(&ClosureTestClass::getAdderCallable), &ClosureTestClass::getAdderCallable>
+         ("getAdderCallable", {
+             ValueArgument("step")
+          });
+   closureTestClass.registerMethod<decltype(&ClosureTestClass::getCompareCallable), &ClosureTestClass::getCompareCallable>("getCompareCallable");
+   closureTestClass.registerMethod<decltype(&ClosureTestClass::testDirectInvoke), &ClosureTestClass::testDirectInvoke>("testDirectInvoke");
+   closureTestClass.registerMethod<decltype(&ClosureTestClass::testDirectInvokeThrow), &ClosureTestClass::testDirectInvokeThrow>("testDirectInvokeThrow");
+   closureTestClass.registerMethod<decltype(&ClosureTestClass::testReferenceInvoke), &ClosureTestClass::testReferenceInvoke>("testReferenceInvoke");
    extension.registerClass(closureTestClass);
 }
 
@@ -216,8 +229,15 @@ void register_magic_method_test_classes(Extension &extension)
 {
    zapi::lang::Class<NonMagicMethodClass> nonMagicMethodClass("NonMagicMethodClass");
    zapi::lang::Class<MagicMethodClass> magicMethodClass("MagicMethodClass");
+   zapi::lang::Class<BufferSerializeClass> bufferSerializeClass("BufferSerializeClass");
+   bufferSerializeClass.registerMethod<decltype(&BufferSerializeClass::setPayload), &BufferSerializeClass::setPayload>
+         ("setPayload", {
+             ValueArgument("payload", zapi::lang::Type::String)
+          });
+   bufferSerializeClass.registerMethod<decltype(&BufferSerializeClass::getPayload), &BufferSerializeClass::getPayload>("getPayload");
    extension.registerClass(nonMagicMethodClass);
    extension.registerClass(magicMethodClass);
+   extension.registerClass(bufferSerializeClass);
 }
 
 void register_props_test_classes(Extension &extension)
@@ -245,6 +265,72 @@ void register_props_test_classes(Extension &extension)
    propsTestClass.registerProperty("age", &PropsTestClass::getAge, &PropsTestClass::setAge);
    
    extension.registerClass(propsTestClass);
+   
+   zapi::lang::Class<OrderClass> orderClass("OrderClass");
+   orderClass.registerProperty("qty", &OrderClass::qty);
+   orderClass.registerProperty("price", &OrderClass::price);
+   orderClass.registerProperty("paid", &OrderClass::paid);
+   orderClass.registerProperty("sku", &OrderClass::sku);
+   orderClass.registerMethod<decltype(&OrderClass::getTotal), &OrderClass::getTotal>("getTotal");
+   extension.registerClass(orderClass);
+   
+   zapi::lang::Class<SlotCounterClass> slotCounterClass("SlotCounterClass");
+   slotCounterClass.registerProperty("hits", 0);
+   slotCounterClass.registerProperty("label", "slot");
+   SlotCounterClass::sm_hitsSlot = slotCounterClass.getPropertySlot("hits");
+   SlotCounterClass::sm_labelSlot = slotCounterClass.getPropertySlot("label");
+   slotCounterClass.registerMethod<decltype(&SlotCounterClass::touch), &SlotCounterClass::touch>("touch");
+   slotCounterClass.registerMethod<decltype(&SlotCounterClass::probeUnresolved), &SlotCounterClass::probeUnresolved>("probeUnresolved");
+   extension.registerClass(slotCounterClass);
+   
+   zapi::lang::Class<PooledObjectClass> pooledObjectClass("PooledObjectClass");
+   pooledObjectClass.enableObjectPool(8);
+   pooledObjectClass.registerProperty("value", &PooledObjectClass::value);
+   pooledObjectClass.registerMethod<decltype(&PooledObjectClass::getPoolStats), &PooledObjectClass::getPoolStats>("getPoolStats");
+   extension.registerClass(pooledObjectClass);
+   
+   zapi::lang::Class<GcNodeClass> gcNodeClass("GcNodeClass");
+   gcNodeClass.registerMethod<decltype(&GcNodeClass::link), &GcNodeClass::link>
+         ("link", {
+             ValueArgument("value")
+          });
+   gcNodeClass.registerMethod<decltype(&GcNodeClass::getLink), &GcNodeClass::getLink>("getLink");
+   gcNodeClass.registerMethod<decltype(&GcNodeClass::getDestroyedCount), &GcNodeClass::getDestroyedCount>("getDestroyedCount");
+   extension.registerClass(gcNodeClass);
+   
+   zapi::lang::Class<LazyHeaderClass> lazyHeaderClass("LazyHeaderClass");
+   lazyHeaderClass.registerLazyProperty("headers", &LazyHeaderClass::parseHeaders);
+   lazyHeaderClass.registerMethod<decltype(&LazyHeaderClass::setRaw), &LazyHeaderClass::setRaw>
+         ("setRaw", {
+             ValueArgument("raw", zapi::lang::Type::String)
+          });
+   lazyHeaderClass.registerMethod<decltype(&LazyHeaderClass::invalidate), &LazyHeaderClass::invalidate>
+         ("invalidate", {
+             ValueArgument("name", zapi::lang::Type::String)
+          });
+   lazyHeaderClass.registerMethod<decltype(&LazyHeaderClass::getComputeCount), &LazyHeaderClass::getComputeCount>("getComputeCount");
+   extension.registerClass(lazyHeaderClass);
+   
+   zapi::lang::Class<DirectCallClass> directCallClass("DirectCallClass");
+   directCallClass.registerMethod<decltype(&DirectCallClass::add), &DirectCallClass::add>
+         ("add", {
+             ValueArgument("lhs"),
+             ValueArgument("rhs")
+          });
+   directCallClass.registerMethod<decltype(&DirectCallClass::describe), &DirectCallClass::describe>("describe");
+   directCallClass.registerMethod<decltype(&DirectCallClass::fail), &DirectCallClass::fail>("fail");
+   directCallClass.registerMethod<decltype(&DirectCallClass::runOn), &DirectCallClass::runOn>
+         ("runOn", {
+             ValueArgument("target"),
+             ValueArgument("times")
+          });
+   directCallClass.registerMethod<decltype(&DirectCallClass::failOn), &DirectCallClass::failOn>
+         ("failOn", {
+             ValueArgument("target")
+          });
+   directCallClass.registerMethod<decltype(&DirectCallClass::getAddCount), &DirectCallClass::getAddCount>("getAddCount");
+   directCallClass.registerMethod<decltype(&DirectCallClass::getDirectAddCount), &DirectCallClass::getDirectAddCount>("getDirectAddCount");
+   extension.registerClass(directCallClass);
 }
 
 void register_object_variant_test_classes(Extension &extension)
@@ -14,6 +14,7 @@
 // Created by softboy on 2017/11/01.
 
 #include "CycleHandlerTestcases.h"
+#include "DsTestcases.h"
 #include <vector>
 #include <string>
 
@@ -37,11 +38,13 @@ void register_cyclehandler_testcases(Extension &extension)
 void startup_handler()
 {
    add_mhandler_info("module startup handler called");
+   build_persistent_tables();
 }
 
 void shutdown_handler()
 {
    add_mhandler_info("module shutdown handler called");
+   release_persistent_tables();
    //   assert(infos.size() == 5);
    //   assert(infos[2] == "module info handler called");
    //   assert(infos[3] == "request shutdown handler called");
@@ -0,0 +1,121 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "DsTestcases.h"
+
+namespace dummyext
+{
+
+using zapi::ds::ArrayVariant;
+using zapi::ds::PersistentArray;
+using zapi::ds::BinaryWriter;
+using zapi::ds::BinaryReader;
+using zapi::lang::ValueArgument;
+
+static PersistentArray persistent_table;
+
+void register_ds_testcases(Extension &extension)
+{
+   extension.registerFunction<decltype(&dummyext::get_persistent_table), &dummyext::get_persistent_table>("get_persistent_table");
+   extension.registerFunction<decltype(&dummyext::binary_round_trip), &dummyext::binary_round_trip>
+         ("binary_round_trip", {
+             ValueArgument("value")
+          });
+   zapi::lang::Class<BinaryPoint> binaryPointClass("BinaryPoint");
+   binaryPointClass.registerMethod<decltype(&BinaryPoint::moveTo), &BinaryPoint::moveTo>
+         ("moveTo", {
+             ValueArgument("x", zapi::lang::Type::Long),
+             ValueArgument("y", zapi::lang::Type::Long)
+          });
+   binaryPointClass.registerMethod<decltype(&BinaryPoint::getX), &BinaryPoint::getX>("getX");
+   binaryPointClass.registerMethod<decltype(&BinaryPoint::getY), &BinaryPoint::getY>("getY");
+   extension.registerClass(binaryPointClass);
+}
+
+void BinaryPoint::moveTo(const NumericVariant &x, const NumericVariant &y)
+{
+   m_x = x.toLong();
+   m_y = y.toLong();
+}
+
+Variant BinaryPoint::getX()
+{
+   return m_x;
+}
+
+Variant BinaryPoint::getY()
+{
+   return m_y;
+}
+
+void BinaryPoint::writeBinary(BinaryWriter &writer) const
+{
+   writer.writeValue(m_x);
+   writer.writeValue(m_y);
+}
+
+bool BinaryPoint::readBinary(BinaryReader &reader)
+{
+   Variant x;
+   Variant y;
+   if (!reader.readValue(x) || !reader.readValue(y) || !x.isLong() || !y.isLong()) {
+      return false;
+   }
+   m_x = NumericVariant(x).toLong();
+   m_y = NumericVariant(y).toLong();
+   return true;
+}
+
+// null when the value can't be written or read back
+Variant binary_round_trip(Variant &value)
+{
+   BinaryWriter writer;
+   if (!writer.write(value)) {
+      return nullptr;
+   }
+   BinaryReader reader(writer.getData(), writer.getSize());
+   Variant result;
+   if (!reader.read(result) || !reader.atEnd()) {
+      return nullptr;
+   }
+   return result;
+}
+
+void build_persistent_tables()
+{
+   ArrayVariant codes;
+   codes.insert("CN", "China");
+   codes.insert("DE", "Germany");
+   codes.insert("US", "United States");
+   ArrayVariant table;
+   table.insert("codes", codes);
+   table.insert("version", 3);
+   table.insert("ratio", 0.5);
+   table.insert("enabled", true);
+   table.append(ArrayVariant{1, 2, 3});
+   persistent_table = PersistentArray(table);
+}
+
+void release_persistent_tables()
+{
+   persistent_table = PersistentArray();
+}
+
+Variant get_persistent_table()
+{
+   return persistent_table.toArray();
+}
+
+} // dummyext
@@ -0,0 +1,51 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#ifndef ZAPI_TEST_DUMMYEXT_DS_TESTCASES_H
+#define ZAPI_TEST_DUMMYEXT_DS_TESTCASES_H
+
+#include "zapi/ZendApi.h"
+
+namespace dummyext
+{
+
+using zapi::lang::Extension;
+using zapi::lang::Variant;
+using zapi::ds::NumericVariant;
+
+// native object with its own binary payload
+class BinaryPoint : public zapi::lang::StdClass, public zapi::protocol::BinarySerializable
+{
+public:
+   void moveTo(const NumericVariant &x, const NumericVariant &y);
+   Variant getX();
+   Variant getY();
+   void writeBinary(zapi::ds::BinaryWriter &writer) const override;
+   bool readBinary(zapi::ds::BinaryReader &reader) override;
+private:
+   zapi_long m_x = 0;
+   zapi_long m_y = 0;
+};
+
+ZAPI_DECL_EXPORT void register_ds_testcases(Extension &extension);
+
+void build_persistent_tables();
+void release_persistent_tables();
+Variant get_persistent_table();
+Variant binary_round_trip(Variant &value);
+
+} // dummyext
+
+#endif // ZAPI_TEST_DUMMYEXT_DS_TESTCASES_H
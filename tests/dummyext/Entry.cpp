@@ -21,6 +21,7 @@
 #include "ClassTestcases.h"
 #include "InterfaceTestcases.h"
 #include "ConstantTestcases.h"
+#include "DsTestcases.h"
 
 using zapi::lang::Extension;
 
@@ -36,6 +37,7 @@ ZAPI_DECL_EXPORT void *get_module()
    dummyext::register_interface_testcases(extension);
    dummyext::register_function_testcases(extension);
    dummyext::register_class_testcases(extension);
+   dummyext::register_ds_testcases(extension);
    return extension;
 }
 
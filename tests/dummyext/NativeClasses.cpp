@@ -15,6 +15,7 @@
 
 #include "NativeClasses.h"
 #include "NativeFunctions.h"
+#include <cstring>
 
 namespace dummyext 
 {
@@ -223,6 +224,25 @@ void C::testCallParentWithReturn()
    zapi::out << "after call addTwoNumber get : " << ret << std::endl;
 }
 
+void C::testCallParentCached()
+{
+   zapi::out << "C::testCallParentCached been called" << std::endl;
+   // the second round is served by the parent method cache
+   for (int i = 0; i < 2; ++i) {
+      Variant ret = callParent("addTwoNumber", 20 + i, 2);
+      zapi::out << "after call addTwoNumber get : " << ret << std::endl;
+   }
+   // same name in another case and from another buffer
+   std::string name("ADDTWONUMBER");
+   Variant ret = callParent(name.c_str(), 30, 2);
+   zapi::out << "after call ADDTWONUMBER get : " << ret << std::endl;
+   static const zapi::lang::MethodRef addTwoNumber("addTwoNumber");
+   for (int i = 0; i < 2; ++i) {
+      ret = callParent(addTwoNumber, 40 + i, 2);
+      zapi::out << "after call addTwoNumber by MethodRef get : " << ret << std::endl;
+   }
+}
+
 void C::testGetObjectVaraintPtr()
 {
    zapi::out << "C::testGetObjectVaraintPtr been called" << std::endl;
@@ -405,6 +425,62 @@ void IterateTestClass::offsetUnset(Variant offset)
 IterateTestClass::~IterateTestClass()
 {}
 
+FastIterateTestClass::FastIterateTestClass()
+   : FastIterator(this)
+{
+   m_items.push_back(std::make_pair<std::string, zapi_long>("one", 1));
+   m_items.push_back(std::make_pair<std::string, zapi_long>("two", 2));
+   m_items.push_back(std::make_pair<std::string, zapi_long>("three", 3));
+   ZVAL_UNDEF(&m_current);
+}
+
+AbstractIterator *FastIterateTestClass::getIterator()
+{
+   return this;
+}
+
+bool FastIterateTestClass::valid()
+{
+   return m_position < m_items.size();
+}
+
+zval *FastIterateTestClass::currentValue()
+{
+   ZVAL_LONG(&m_current, m_items[m_position].second);
+   return &m_current;
+}
+
+void FastIterateTestClass::currentKey(zval *key)
+{
+   const std::string &name = m_items[m_position].first;
+   ZVAL_STRINGL(key, name.data(), name.size());
+}
+
+void FastIterateTestClass::next()
+{
+   ++m_position;
+}
+
+void FastIterateTestClass::rewind()
+{
+   m_position = 0;
+}
+
+Variant FastIterateTestClass::sumByVariant()
+{
+   // the Variant based accessors still work for C++ callers
+   std::string keys;
+   zapi_long sum = 0;
+   for (rewind(); valid(); next()) {
+      keys += StringVariant(key()).toString();
+      sum += zapi::ds::NumericVariant(current()).toLong();
+   }
+   return keys + "=" + std::to_string(sum);
+}
+
+FastIterateTestClass::~FastIterateTestClass()
+{}
+
 // for test closure class test
 
 void ClosureTestClass::testClosureCallable()
@@ -423,6 +499,59 @@ Variant ClosureTestClass::getArgAndReturnCallable()
    return CallableVariant(have_ret_and_have_arg);
 }
 
+Variant ClosureTestClass::getAdderCallable(int64_t step)
+{
+   return CallableVariant([step](Parameters &args) -> Variant {
+      return static_cast<int64_t>(zapi::ds::NumericVariant(args.at(0)).toLong() + step);
+   });
+}
+
+Variant ClosureTestClass::getCompareCallable()
+{
+   return CallableVariant([](Parameters &args) -> Variant {
+      zapi_long lhs = zapi::ds::NumericVariant(args.at(0)).toLong();
+      zapi_long rhs = zapi::ds::NumericVariant(args.at(1)).toLong();
+      return static_cast<int32_t>(lhs < rhs ? 1 : (lhs > rhs ? -1 : 0));
+   });
+}
+
+Variant ClosureTestClass::testDirectInvoke()
+{
+   int64_t calls = 0;
+   CallableVariant counter([&calls](Parameters &args) -> Variant {
+      ++calls;
+      return static_cast<int64_t>(args.size());
+   });
+   zapi::ds::NumericVariant argc(counter(1, "two", 3.0));
+   counter();
+   return std::to_string(calls) + " calls, first argc " + std::to_string(argc.toLong());
+}
+
+Variant ClosureTestClass::testDirectInvokeThrow()
+{
+   CallableVariant failing([](Parameters &args) -> Variant {
+      throw zapi::kernel::Exception("native closure failed");
+   });
+   try {
+      failing(1);
+   } catch (zapi::kernel::OrigException &exception) {
+      return "OrigException " + exception.getMessage();
+   }
+   return "not reached";
+}
+
+Variant ClosureTestClass::testReferenceInvoke()
+{
+   Variant closure(CallableVariant([](Parameters &args) -> Variant {
+      return static_cast<int64_t>(args.size());
+   }));
+   Variant reference(closure, true);
+   CallableVariant callable(std::move(reference));
+   zapi::ds::NumericVariant argc(callable(1, 2));
+   zapi::ds::NumericVariant noArgc(callable());
+   return "reference argc " + std::to_string(argc.toLong()) + " " + std::to_string(noArgc.toLong());
+}
+
 ClosureTestClass::~ClosureTestClass()
 {}
 
@@ -604,6 +733,31 @@ void MagicMethodClass::unserialize(const char *input, size_t size)
 MagicMethodClass::~MagicMethodClass() ZAPI_DECL_NOEXCEPT
 {}
 
+void BufferSerializeClass::setPayload(const StringVariant &payload)
+{
+   m_payload = payload.toString();
+}
+
+Variant BufferSerializeClass::getPayload()
+{
+   return m_payload;
+}
+
+void BufferSerializeClass::serializeTo(smart_string &buffer)
+{
+   smart_string_appendl(&buffer, "v1:", 3);
+   smart_string_appendl(&buffer, m_payload.c_str(), m_payload.length());
+}
+
+bool BufferSerializeClass::unserializeFrom(const char *input, size_t length)
+{
+   if (length < 3 || std::strncmp(input, "v1:", 3) != 0) {
+      return false;
+   }
+   m_payload.assign(input + 3, length - 3);
+   return true;
+}
+
 // for properties test
 void PropsTestClass::setAge(const Variant &value)
 {
@@ -629,6 +783,156 @@ Variant PropsTestClass::getName()
    return m_name;
 }
 
+Variant OrderClass::getTotal()
+{
+   return sku + ": " + std::to_string(qty) + " x " + std::to_string(price) + (paid ? " paid" : " open");
+}
+
+zapi::lang::PropertySlot SlotCounterClass::sm_hitsSlot;
+zapi::lang::PropertySlot SlotCounterClass::sm_labelSlot;
+zapi::lang::PropertySlot SlotCounterClass::sm_unresolvedSlot;
+
+void SlotCounterClass::touch()
+{
+   zapi::lang::PropertyRef hits = slot(sm_hitsSlot);
+   hits.set(hits.get<int64_t>() + 1);
+   zapi::lang::PropertyRef label = slot(sm_labelSlot);
+   label.set(label.get<std::string>() + "!");
+}
+
+Variant SlotCounterClass::probeUnresolved()
+{
+   zapi::lang::PropertyRef missing = slot(sm_unresolvedSlot);
+   missing.set(1);
+   invalidateProperty(sm_unresolvedSlot);
+   return missing.isNull() && missing.getValue().isNull();
+}
+
+Variant PooledObjectClass::getPoolStats()
+{
+   const zapi::vm::ObjectPool::Stats &stats = zapi::lang::Class<PooledObjectClass>::getObjectPool().getStats();
+   ArrayVariant result;
+   result.insert("hits", static_cast<int64_t>(stats.hits));
+   result.insert("misses", static_cast<int64_t>(stats.misses));
+   result.insert("live", static_cast<int64_t>(stats.live));
+   result.insert("highWater", static_cast<int64_t>(stats.highWater));
+   result.insert("pooled", static_cast<int64_t>(stats.pooled));
+   return result;
+}
+
+int64_t GcNodeClass::sm_destroyed = 0;
+
+GcNodeClass::~GcNodeClass()
+{
+   ++sm_destroyed;
+}
+
+void GcNodeClass::link(const Variant &value)
+{
+   m_link = value;
+}
+
+Variant GcNodeClass::getLink()
+{
+   return m_link;
+}
+
+void GcNodeClass::gcVisit(zapi::vm::GcVisitor &visitor) const
+{
+   visitor.visit(m_link);
+}
+
+Variant GcNodeClass::getDestroyedCount()
+{
+   return sm_destroyed;
+}
+
+void LazyHeaderClass::setRaw(const StringVariant &raw)
+{
+   m_raw = raw.toString();
+   invalidateProperty("headers");
+}
+
+void LazyHeaderClass::invalidate(const StringVariant &name)
+{
+   invalidateProperty(name.toString());
+}
+
+Variant LazyHeaderClass::parseHeaders() const
+{
+   ++m_computeCount;
+   ArrayVariant headers;
+   size_t start = 0;
+   while (start < m_raw.length()) {
+      size_t end = m_raw.find('\n', start);
+      if (end == std::string::npos) {
+         end = m_raw.length();
+      }
+      std::string line = m_raw.substr(start, end - start);
+      size_t colon = line.find(':');
+      if (colon != std::string::npos) {
+         size_t valueStart = line.find_first_not_of(' ', colon + 1);
+         headers.insert(line.substr(0, colon),
+                        valueStart == std::string::npos ? std::string() : line.substr(valueStart));
+      }
+      start = end + 1;
+   }
+   return headers;
+}
+
+Variant LazyHeaderClass::getComputeCount()
+{
+   return m_computeCount;
+}
+
+int64_t DirectCallClass::add(int64_t lhs, int64_t rhs)
+{
+   ++m_addCount;
+   // the engine pushes a frame for add(), a direct call leaves the frame
+   // of the caller on top
+   zend_execute_data *frame = EG(current_execute_data);
+   if (!frame || !frame->func || !frame->func->common.function_name ||
+       !zend_string_equals_literal_ci(frame->func->common.function_name, "add")) {
+      ++m_directAddCount;
+   }
+   return lhs + rhs;
+}
+
+std::string DirectCallClass::describe()
+{
+   return "native";
+}
+
+void DirectCallClass::fail()
+{
+   throw zapi::kernel::Exception("DirectCallClass::fail");
+}
+
+Variant DirectCallClass::runOn(ObjectVariant target, int64_t times)
+{
+   int64_t total = 0;
+   for (int64_t i = 0; i < times; ++i) {
+      total = NumericVariant(target.call("add", total, 2)).toLong();
+   }
+   return StringVariant(target.call("describe")).toString() + " " + std::to_string(total);
+}
+
+Variant DirectCallClass::failOn(ObjectVariant target)
+{
+   target.call("fail");
+   return "not reached";
+}
+
+Variant DirectCallClass::getAddCount()
+{
+   return m_addCount;
+}
+
+Variant DirectCallClass::getDirectAddCount()
+{
+   return m_directAddCount;
+}
+
 Variant ObjectVariantClass::__invoke(Parameters &params) const
 {
    zapi::out << "ObjectVariantClass::__invoke invoked" << std::endl;
@@ -107,6 +107,7 @@ public:
    void printInfo();
    void testCallParentPassRefArg();
    void testCallParentWithReturn();
+   void testCallParentCached();
    void testGetObjectVaraintPtr();
    void privateCMethod();
    void protectedCMethod();
@@ -145,12 +146,38 @@ protected:
    std::vector<std::pair<std::string, std::string>> m_items;
 };
 
+class FastIterateTestClass :
+      public StdClass,
+      public zapi::protocol::Traversable,
+      public zapi::protocol::FastIterator
+{
+public:
+   FastIterateTestClass();
+   virtual AbstractIterator *getIterator();
+   virtual bool valid();
+   virtual zval *currentValue();
+   virtual void currentKey(zval *key);
+   virtual void next();
+   virtual void rewind();
+   Variant sumByVariant();
+   virtual ~FastIterateTestClass();
+protected:
+   std::vector<std::pair<std::string, zapi_long>> m_items;
+   size_t m_position = 0;
+   zval m_current;
+};
+
 class ClosureTestClass : public StdClass
 {
 public:
    void testClosureCallable();
    Variant getNoArgAndReturnCallable();
    Variant getArgAndReturnCallable();
+   Variant getAdderCallable(int64_t step);
+   Variant getCompareCallable();
+   Variant testDirectInvoke();
+   Variant testDirectInvokeThrow();
+   Variant testReferenceInvoke();
    ~ClosureTestClass();
 };
 
@@ -211,6 +238,17 @@ private:
    std::string m_address;
 };
 
+class BufferSerializeClass : public StdClass, public zapi::protocol::BufferSerializable
+{
+public:
+   void setPayload(const StringVariant &payload);
+   Variant getPayload();
+   virtual void serializeTo(smart_string &buffer) override;
+   virtual bool unserializeFrom(const char *input, size_t length) override;
+private:
+   std::string m_payload;
+};
+
 // for class properties test
 class PropsTestClass : public StdClass
 {
@@ -224,6 +262,84 @@ public:
    Variant getName();
 };
 
+// for the properties bound to members
+class OrderClass : public StdClass
+{
+public:
+   Variant getTotal();
+public:
+   int64_t qty = 1;
+   double price = 2.5;
+   bool paid = false;
+   std::string sku = "A-100";
+};
+
+// for the typed property slots
+class SlotCounterClass : public StdClass
+{
+public:
+   void touch();
+   Variant probeUnresolved();
+public:
+   static zapi::lang::PropertySlot sm_hitsSlot;
+   static zapi::lang::PropertySlot sm_labelSlot;
+   // never taken from getPropertySlot()
+   static zapi::lang::PropertySlot sm_unresolvedSlot;
+};
+
+// for the native object pool
+class PooledObjectClass : public StdClass
+{
+public:
+   static Variant getPoolStats();
+public:
+   int64_t value = 0;
+};
+
+// for the cycle collector integration
+class GcNodeClass : public StdClass
+{
+public:
+   ~GcNodeClass();
+   void link(const Variant &value);
+   Variant getLink();
+   void gcVisit(zapi::vm::GcVisitor &visitor) const;
+   static Variant getDestroyedCount();
+private:
+   Variant m_link;
+   static int64_t sm_destroyed;
+};
+
+// for the lazy properties
+class LazyHeaderClass : public StdClass
+{
+public:
+   void setRaw(const StringVariant &raw);
+   void invalidate(const StringVariant &name);
+   Variant parseHeaders() const;
+   Variant getComputeCount();
+private:
+   std::string m_raw = "Host: zapi\nAccept: */*";
+   mutable int64_t m_computeCount = 0;
+};
+
+// for the direct native method calls
+class DirectCallClass : public StdClass
+{
+public:
+   int64_t add(int64_t lhs, int64_t rhs);
+   std::string describe();
+   void fail();
+   Variant runOn(zapi::ds::ObjectVariant target, int64_t times);
+   Variant failOn(zapi::ds::ObjectVariant target);
+   Variant getAddCount();
+   // the add() calls that ran without a frame of their own
+   Variant getDirectAddCount();
+private:
+   int64_t m_addCount = 0;
+   int64_t m_directAddCount = 0;
+};
+
 class ObjectVariantClass : public StdClass
 {
 public:
@@ -0,0 +1,21 @@
+<?php
+ob_start();
+if (class_exists("\BufferSerializeClass")) {
+    $object = new \BufferSerializeClass();
+    $object->setPayload("queue message");
+    $str = serialize($object);
+    echo $str."\n";
+    $copy = unserialize($str);
+    echo $copy->getPayload()."\n";
+    var_dump(@unserialize('C:20:"BufferSerializeClass":3:{xyz}'));
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+C:20:"BufferSerializeClass":16:{v1:queue message}
+queue message
+bool(false)
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
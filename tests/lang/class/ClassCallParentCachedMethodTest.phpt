@@ -0,0 +1,38 @@
+<?php
+ob_start();
+if (class_exists("A") && class_exists("B") && class_exists("C")) {
+    echo "class A and class B and class C exist\n";
+    $obj = new C();
+    $obj->testCallParentCached();
+    $obj->testCallParentCached();
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+class A and class B and class C exist
+C::testCallParentCached been called
+B::addTwoNumber been called
+after call addTwoNumber get : 22
+B::addTwoNumber been called
+after call addTwoNumber get : 23
+B::addTwoNumber been called
+after call ADDTWONUMBER get : 32
+B::addTwoNumber been called
+after call addTwoNumber by MethodRef get : 42
+B::addTwoNumber been called
+after call addTwoNumber by MethodRef get : 43
+C::testCallParentCached been called
+B::addTwoNumber been called
+after call addTwoNumber get : 22
+B::addTwoNumber been called
+after call addTwoNumber get : 23
+B::addTwoNumber been called
+after call ADDTWONUMBER get : 32
+B::addTwoNumber been called
+after call addTwoNumber by MethodRef get : 42
+B::addTwoNumber been called
+after call addTwoNumber by MethodRef get : 43
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,36 @@
+<?php
+ob_start();
+if (class_exists("\DirectCallClass")) {
+    class UserAddCall extends \DirectCallClass
+    {
+        public function add($lhs, $rhs)
+        {
+            return parent::add($lhs, $rhs);
+        }
+    }
+    $runner = new \DirectCallClass();
+    $native = new \DirectCallClass();
+    // native to native goes straight through the InvokeBridge
+    echo $runner->runOn($native, 4), "\n";
+    echo $native->getAddCount(), " ", $native->getDirectAddCount(), "\n";
+    // the calls from PHP keep their frame
+    echo $native->add(1, 2), "\n";
+    echo $native->getAddCount(), " ", $native->getDirectAddCount(), "\n";
+    // a userland override is called through the engine
+    $user = new UserAddCall();
+    echo $runner->runOn($user, 3), "\n";
+    echo $user->getAddCount(), " ", $user->getDirectAddCount(), "\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+native 8
+4 4
+3
+5 4
+native 6
+3 0
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
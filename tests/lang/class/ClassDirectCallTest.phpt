@@ -0,0 +1,37 @@
+<?php
+ob_start();
+if (class_exists("\DirectCallClass")) {
+    class UserDirectCall extends \DirectCallClass
+    {
+        public function describe()
+        {
+            return "userland";
+        }
+    }
+    $runner = new \DirectCallClass();
+    $native = new \DirectCallClass();
+    echo $runner->runOn($native, 5), "\n";
+    echo $native->getAddCount(), "\n";
+    $user = new UserDirectCall();
+    echo $runner->runOn($user, 3), "\n";
+    echo $user->getAddCount(), "\n";
+    try {
+        $runner->failOn($native);
+    } catch (\Exception $e) {
+        echo get_class($e), " ", $e->getMessage(), "\n";
+    }
+    echo $runner->getAddCount(), "\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+native 10
+5
+userland 6
+3
+Exception DirectCallClass::fail
+0
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
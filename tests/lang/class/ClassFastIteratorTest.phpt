@@ -0,0 +1,37 @@
+<?php
+ob_start();
+if (class_exists("\FastIterateTestClass")) {
+    $obj = new \FastIterateTestClass();
+    foreach ($obj as $key => $value) {
+        echo "$key => $value\n";
+    }
+    foreach ($obj as $key => $value) {
+        if ($value == 2) {
+            echo "break at $key\n";
+            break;
+        }
+    }
+    var_dump(iterator_to_array($obj));
+    echo $obj->sumByVariant() . "\n";
+}
+
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+one => 1
+two => 2
+three => 3
+break at two
+array(3) {
+  ["one"]=>
+  int(1)
+  ["two"]=>
+  int(2)
+  ["three"]=>
+  int(3)
+}
+onetwothree=6
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,31 @@
+<?php
+ob_start();
+if (class_exists("\OrderClass")) {
+    $orders = [new \OrderClass(), new \OrderClass()];
+    $sum = 0;
+    // every opline runs again once its cache slot is filled
+    for ($i = 0; $i < 6; $i++) {
+        $order = $orders[$i % 2];
+        $order->qty += 2;
+        $order->qty = $order->qty + 1;
+        $order->price = $order->price * 2;
+        $order->sku = $order->sku . $i;
+        $sum += $order->qty;
+    }
+    echo $sum."\n";
+    echo $orders[0]->getTotal()."\n";
+    echo $orders[1]->getTotal()."\n";
+    var_dump($orders[0]->qty, $orders[1]->price);
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+42
+A-100024: 10 x 20.000000 open
+A-100135: 10 x 20.000000 open
+int(10)
+float(20)
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,61 @@
+<?php
+ob_start();
+if (class_exists("\OrderClass")) {
+    $order = new \OrderClass();
+    echo $order->getTotal()."\n";
+    $order->qty = "3";
+    $order->price = 4;
+    $order->paid = 1;
+    $order->sku = "B-200";
+    for ($i = 0; $i < 3; $i++) {
+        $order->qty++;
+    }
+    $order->sku .= "-X";
+    echo $order->getTotal()."\n";
+    var_dump($order->qty, $order->price, $order->paid, isset($order->sku), empty($order->paid));
+    foreach (get_object_vars($order) as $key => $value) {
+        echo "$key=$value\n";
+    }
+    try {
+        $order->qty = [];
+    } catch (\TypeError $e) {
+        echo $e->getMessage()."\n";
+    }
+    echo $order->qty."\n";
+    // the writes through the property table reach the members
+    $copy = unserialize(serialize($order));
+    echo $copy->getTotal()."\n";
+    var_dump($copy->qty);
+    foreach ($order as $key => &$value) {
+        if ($key == "qty") {
+            $value = "9";
+        }
+    }
+    unset($value);
+    var_dump($order->qty);
+    echo $order->getTotal()."\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+A-100: 1 x 2.500000 open
+B-200-X: 6 x 4.000000 paid
+int(6)
+float(4)
+bool(true)
+bool(true)
+bool(false)
+qty=6
+price=4
+paid=1
+sku=B-200-X
+Cannot assign array to property OrderClass::$qty
+6
+B-200-X: 6 x 4.000000 paid
+int(6)
+int(9)
+B-200-X: 9 x 4.000000 paid
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,30 @@
+<?php
+ob_start();
+if (class_exists("\GcNodeClass")) {
+    gc_enable();
+    $before = \GcNodeClass::getDestroyedCount();
+    // cycle through the native member
+    $node = new \GcNodeClass();
+    $node->link($node);
+    // cycle through an array held by the native member
+    $other = new \GcNodeClass();
+    $other->link([1, $other]);
+    // not a cycle, kept alive
+    $kept = new \GcNodeClass();
+    $kept->link("value");
+    unset($node, $other);
+    echo \GcNodeClass::getDestroyedCount() - $before, "\n";
+    gc_collect_cycles();
+    echo \GcNodeClass::getDestroyedCount() - $before, "\n";
+    echo $kept->getLink(), "\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+0
+2
+value
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
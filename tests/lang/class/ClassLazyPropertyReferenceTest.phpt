@@ -0,0 +1,42 @@
+<?php
+ob_start();
+if (class_exists("\LazyHeaderClass")) {
+    $request = new \LazyHeaderClass();
+    echo $request->headers["Host"], "\n";
+    try {
+        $r = &$request->headers;
+        $r = 1;
+    } catch (\Error $e) {
+        echo $e->getMessage(), "\n";
+    }
+    try {
+        $request->headers["Host"] = "evil";
+    } catch (\Error $e) {
+        echo $e->getMessage(), "\n";
+    }
+    // the same opline once the read has cached the slot
+    for ($i = 0; $i < 2; $i++) {
+        echo $request->headers["Host"], "\n";
+        try {
+            $r = &$request->headers;
+        } catch (\Error $e) {
+            echo $e->getMessage(), "\n";
+        }
+    }
+    echo $request->getComputeCount(), "\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+zapi
+Cannot modify read-only property LazyHeaderClass::$headers
+Cannot modify read-only property LazyHeaderClass::$headers
+zapi
+Cannot modify read-only property LazyHeaderClass::$headers
+zapi
+Cannot modify read-only property LazyHeaderClass::$headers
+1
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,37 @@
+<?php
+ob_start();
+if (class_exists("\LazyHeaderClass")) {
+    $request = new \LazyHeaderClass();
+    echo $request->getComputeCount(), "\n";
+    for ($i = 0; $i < 3; $i++) {
+        echo $request->headers["Host"], "\n";
+    }
+    var_dump(isset($request->headers), isset($request->headers["Accept"]));
+    echo $request->getComputeCount(), "\n";
+    $request->setRaw("Host: php.net\nX-Trace: 7");
+    echo $request->getComputeCount(), "\n";
+    echo $request->headers["Host"], " ", $request->headers["X-Trace"], "\n";
+    echo count($request->headers), "\n";
+    echo $request->getComputeCount(), "\n";
+    $copy = clone $request;
+    echo $copy->headers["Host"], " ", $copy->getComputeCount(), "\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+0
+zapi
+zapi
+zapi
+bool(true)
+bool(true)
+1
+1
+php.net 7
+2
+2
+php.net 2
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,50 @@
+<?php
+ob_start();
+if (class_exists("\LazyHeaderClass")) {
+    class LazyHeaderChild extends \LazyHeaderClass
+    {
+        public function overwrite()
+        {
+            $host = $this->headers["Host"];
+            try {
+                $this->headers = ["Host" => "evil"];
+            } catch (\Error $e) {
+                return $host . " " . $e->getMessage();
+            }
+            return "written";
+        }
+    }
+    $request = new \LazyHeaderClass();
+    try {
+        $request->headers = [];
+    } catch (\Error $e) {
+        echo $e->getMessage(), "\n";
+    }
+    echo $request->headers["Host"], "\n";
+    // the read and the write of $this->headers may share a cache slot
+    $child = new LazyHeaderChild();
+    for ($i = 0; $i < 2; $i++) {
+        echo $child->overwrite(), "\n";
+    }
+    echo $child->headers["Host"], " ", $child->getComputeCount(), "\n";
+    $child->invalidate("headers");
+    echo $child->headers["Host"], " ", $child->getComputeCount(), "\n";
+    @$child->invalidate("missing");
+    echo error_get_last()["message"], "\n";
+    echo $child->headers["Host"], " ", $child->getComputeCount(), "\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+Cannot modify read-only property LazyHeaderClass::$headers
+zapi
+zapi Cannot modify read-only property LazyHeaderChild::$headers
+zapi Cannot modify read-only property LazyHeaderChild::$headers
+zapi 1
+zapi 2
+Property LazyHeaderChild::$missing is not a lazy property
+zapi 2
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
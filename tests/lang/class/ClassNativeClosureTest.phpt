@@ -0,0 +1,34 @@
+<?php
+ob_start();
+if (class_exists("\ClosureTestClass")) {
+    $obj = new \ClosureTestClass();
+    $addTen = $obj->getAdderCallable(10);
+    if ($addTen instanceof \ZapiClosure) {
+        echo "lambda closure is a ZapiClosure\n";
+    }
+    echo implode(",", array_map($addTen, [1, 2, 3])) . "\n";
+    echo $obj->getAdderCallable(-1)(5) . "\n";
+    $values = [3, 11, 7, 1];
+    usort($values, $obj->getCompareCallable());
+    echo implode(",", $values) . "\n";
+    echo call_user_func_array($addTen, [32]) . "\n";
+    echo $obj->testDirectInvoke() . "\n";
+    echo $obj->testDirectInvokeThrow() . "\n";
+    echo $obj->testReferenceInvoke() . "\n";
+}
+
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+lambda closure is a ZapiClosure
+11,12,13
+4
+11,7,3,1
+42
+2 calls, first argc 3
+OrigException native closure failed
+reference argc 2 0
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,38 @@
+<?php
+if (PHP_ZTS) {
+    // the object pool is disabled under ZTS
+    exit(0);
+}
+ob_start();
+if (class_exists("\PooledObjectClass")) {
+    $objects = [];
+    for ($i = 0; $i < 4; $i++) {
+        $object = new \PooledObjectClass();
+        $object->value = $i;
+        $objects[] = $object;
+    }
+    unset($object);
+    $objects = [];
+    for ($i = 0; $i < 100; $i++) {
+        $object = new \PooledObjectClass();
+        $object->value = $i;
+    }
+    $copy = clone $object;
+    echo $copy->value."\n";
+    foreach (\PooledObjectClass::getPoolStats() as $key => $value) {
+        echo "$key=$value\n";
+    }
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+99
+hits=101
+misses=4
+live=2
+highWater=4
+pooled=2
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
@@ -0,0 +1,32 @@
+<?php
+ob_start();
+if (class_exists("\SlotCounterClass")) {
+    $counter = new \SlotCounterClass();
+    $counter->touch();
+    echo $counter->hits." ".$counter->label."\n";
+    $counter->hits = "41";
+    $hits = &$counter->hits;
+    $counter->touch();
+    var_dump($hits);
+    echo $counter->label."\n";
+    $other = new \SlotCounterClass();
+    $other->touch();
+    echo $other->hits." ".$counter->hits."\n";
+    var_dump(@$counter->probeUnresolved());
+    echo error_get_last()["message"]."\n";
+    echo $counter->hits."\n";
+}
+$ret = trim(ob_get_clean());
+$expect = <<<'EOF'
+1 slot!
+int(42)
+slot!!
+1 42
+bool(true)
+Unresolved property slot used on an object of class SlotCounterClass
+42
+EOF;
+
+if ($ret != $expect) {
+    exit(1);
+}
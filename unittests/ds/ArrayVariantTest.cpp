@@ -16,6 +16,7 @@
 #include "php/sapi/embed/php_embed.h"
 #include "gtest/gtest.h"
 #include "zapi/ds/ArrayVariant.h"
+#include "zapi/ds/ArrayBuilder.h"
 #include "zapi/ds/ArrayItemProxy.h"
 #include "zapi/ds/NumericVariant.h"
 #include "zapi/ds/DoubleVariant.h"
@@ -23,8 +24,13 @@
 #include "zapi/ds/BoolVariant.h"
 #include "zapi/utils/PhpFuncs.h"
 #include <list>
+#include <cstring>
+#include <random>
+#include <vector>
 
 using zapi::ds::ArrayVariant;
+using zapi::ds::ArrayKey;
+using zapi::ds::ArrayBuilder;
 using zapi::ds::Variant;
 using zapi::ds::NumericVariant;
 using zapi::ds::StringVariant;
@@ -782,6 +788,464 @@ TEST(ArrayVariantTest, testFind)
    ASSERT_EQ(NumericVariant(citer.getValue()).toLong(), 123);
 }
 
+TEST(ArrayVariantTest, testArrayKey)
+{
+   ArrayKey nameKey("name");
+   ArrayKey ageKey("age");
+   ArrayKey indexKey(0);
+   ArrayKey notExistKey("notExist");
+   ASSERT_TRUE(nameKey.isString());
+   ASSERT_TRUE(indexKey.isIndex());
+   ASSERT_EQ(nameKey, ArrayKey(std::string("name")));
+   ASSERT_NE(nameKey, ageKey);
+   ASSERT_EQ(nameKey.toString(), "name");
+   ASSERT_EQ(indexKey.toString(), "0");
+   ArrayVariant array;
+   array.insert(nameKey, "zapi");
+   array.insert(ageKey, 123);
+   array.insert(indexKey, "beijing");
+   ASSERT_EQ(array.getSize(), 3);
+   ASSERT_TRUE(array.contains(nameKey));
+   ASSERT_TRUE(array.contains("name"));
+   ASSERT_TRUE(array.contains(indexKey));
+   ASSERT_TRUE(array.contains(0));
+   ASSERT_FALSE(array.contains(notExistKey));
+   ASSERT_STREQ(StringVariant(array.getValue(nameKey)).getCStr(), "zapi");
+   ASSERT_EQ(NumericVariant(array.getValue(ageKey)).toLong(), 123);
+   ASSERT_STREQ(StringVariant(array.getValue(indexKey)).getCStr(), "beijing");
+   // keys inserted by std::string can be found by pre-hashed key
+   array.insert("address", "haidian");
+   ASSERT_TRUE(array.contains(ArrayKey("address")));
+   ArrayVariant::Iterator iter = array.find(notExistKey);
+   ASSERT_TRUE(iter == array.end());
+   iter = array.find(ageKey);
+   ASSERT_EQ(NumericVariant(iter.getValue()).toLong(), 123);
+   const ArrayVariant &carray = array;
+   ArrayVariant::ConstIterator citer = carray.find(nameKey);
+   ASSERT_STREQ(StringVariant(citer.getValue()).getCStr(), "zapi");
+   array[ageKey] = 456;
+   NumericVariant newAge = array[ageKey];
+   ASSERT_EQ(newAge.toLong(), 456);
+   array["info"][ArrayKey("city")] = "beijing";
+   StringVariant city = array["info"]["city"];
+   ASSERT_STREQ(city.getCStr(), "beijing");
+   Variant age = array.take(ageKey);
+   ASSERT_EQ(age.getType(), zapi::lang::Type::Long);
+   ASSERT_FALSE(array.contains(ageKey));
+   ASSERT_TRUE(array.remove(nameKey));
+   ASSERT_FALSE(array.remove(nameKey));
+   ASSERT_TRUE(array.remove(indexKey));
+   ASSERT_EQ(array.getSize(), 2);
+}
+
+TEST(ArrayVariantTest, testSort)
+{
+   {
+      ArrayVariant array{3, 1, 2, "10", 9};
+      array.sort();
+      ASSERT_EQ(array.getSize(), 5);
+      std::vector<zapi_long> expected{1, 2, 3, 9, 10};
+      zapi_long index = 0;
+      for (zapi_long value : expected) {
+         ASSERT_EQ(zval_get_long(array.getValue(index++).getZvalPtr()), value);
+      }
+   }
+   {
+      // without renumber the keys go with the values
+      ArrayVariant array;
+      array.insert("c", 3);
+      array.insert("a", 1);
+      array.insert("b", 2);
+      array.sort(false);
+      std::list<KeyType> keys = array.getKeys();
+      std::vector<std::string> expectedKeys{"a", "b", "c"};
+      ASSERT_EQ(keys.size(), expectedKeys.size());
+      auto iter = keys.begin();
+      for (const std::string &key : expectedKeys) {
+         ASSERT_EQ(*iter->second, key);
+         ++iter;
+      }
+   }
+   {
+      // sort with native comparator, descending
+      ArrayVariant array{1, 5, 3};
+      array.sort([](const zval &lhs, const zval &rhs) -> bool {
+         return Z_LVAL(lhs) > Z_LVAL(rhs);
+      });
+      ASSERT_EQ(NumericVariant(array.getValue(0)).toLong(), 5);
+      ASSERT_EQ(NumericVariant(array.getValue(1)).toLong(), 3);
+      ASSERT_EQ(NumericVariant(array.getValue(2)).toLong(), 1);
+   }
+   {
+      // big homogeneous lists take the radix path
+      std::mt19937 generator(2017);
+      std::uniform_int_distribution<zapi_long> distribution(-1000000, 1000000);
+      ArrayVariant longs;
+      ArrayVariant doubles;
+      for (int i = 0; i < 1000; ++i) {
+         zapi_long value = distribution(generator);
+         longs.append(value);
+         doubles.append(static_cast<double>(value) / 7);
+      }
+      longs.remove(10);
+      longs.sort();
+      doubles.sort();
+      ASSERT_EQ(longs.getSize(), 999);
+      ASSERT_EQ(doubles.getSize(), 1000);
+      for (zapi_ulong i = 1; i < longs.getSize(); ++i) {
+         ASSERT_LE(NumericVariant(longs.getValue(i - 1)).toLong(), NumericVariant(longs.getValue(i)).toLong());
+      }
+      for (zapi_ulong i = 1; i < doubles.getSize(); ++i) {
+         ASSERT_LE(DoubleVariant(doubles.getValue(i - 1)).toDouble(), DoubleVariant(doubles.getValue(i)).toDouble());
+      }
+   }
+}
+
+TEST(ArrayVariantTest, testSortByKey)
+{
+   ArrayVariant array;
+   array.insert("name", "zapi");
+   array.insert(2, "b");
+   array.insert("age", 12);
+   array.insert(1, "a");
+   array.sortByKey([](const Bucket &lhs, const Bucket &rhs) -> bool {
+      if (!lhs.key || !rhs.key) {
+         return !lhs.key && (rhs.key || lhs.h < rhs.h);
+      }
+      return std::strcmp(ZSTR_VAL(lhs.key), ZSTR_VAL(rhs.key)) < 0;
+   });
+   std::list<KeyType> keys = array.getKeys();
+   ASSERT_EQ(keys.size(), 4);
+   auto iter = keys.begin();
+   ASSERT_EQ(iter->first, 1);
+   ++iter;
+   ASSERT_EQ(iter->first, 2);
+   ++iter;
+   ASSERT_EQ(*iter->second, "age");
+   ++iter;
+   ASSERT_EQ(*iter->second, "name");
+   ASSERT_TRUE(array.contains("age"));
+   ASSERT_TRUE(array.contains(1));
+   ArrayVariant numbers;
+   numbers.insert(10, "c");
+   numbers.insert(3, "a");
+   numbers.insert(7, "b");
+   numbers.sortByKey();
+   keys = numbers.getKeys();
+   iter = keys.begin();
+   ASSERT_EQ(iter->first, 3);
+   ASSERT_EQ(keys.back().first, 10);
+}
+
+TEST(ArrayVariantTest, testStableSortAndSortByColumn)
+{
+   ArrayVariant rows;
+   rows.append(ArrayVariant{std::make_pair(Variant("id"), Variant(3)), std::make_pair(Variant("group"), Variant(2))});
+   rows.append(ArrayVariant{std::make_pair(Variant("id"), Variant(1)), std::make_pair(Variant("group"), Variant(1))});
+   rows.append(ArrayVariant{std::make_pair(Variant("id"), Variant(2)), std::make_pair(Variant("group"), Variant(2))});
+   rows.append(ArrayVariant{std::make_pair(Variant("id"), Variant(4)), std::make_pair(Variant("group"), Variant(1))});
+   ArrayVariant byGroup(rows);
+   byGroup.sortByColumn(ArrayKey("group"));
+   std::vector<zapi_long> expectedIds{1, 4, 3, 2};
+   zapi_ulong index = 0;
+   for (zapi_long id : expectedIds) {
+      ArrayVariant row = byGroup.getValue(index++);
+      ASSERT_EQ(NumericVariant(row.getValue("id")).toLong(), id);
+   }
+   // copy on write, the source array is untouched
+   ASSERT_EQ(NumericVariant(ArrayVariant(rows.getValue(0)).getValue("id")).toLong(), 3);
+   ArrayVariant byIdDesc(rows);
+   byIdDesc.stableSort([](const zval &lhs, const zval &rhs) -> bool {
+      return Z_LVAL_P(zend_hash_str_find(Z_ARRVAL(lhs), "id", 2)) > 
+            Z_LVAL_P(zend_hash_str_find(Z_ARRVAL(rhs), "id", 2));
+   });
+   ASSERT_EQ(NumericVariant(ArrayVariant(byIdDesc.getValue(0)).getValue("id")).toLong(), 4);
+   ASSERT_EQ(NumericVariant(ArrayVariant(byIdDesc.getValue(3)).getValue("id")).toLong(), 1);
+}
+
+TEST(ArrayVariantTest, testPartialSort)
+{
+   ArrayVariant array{9, 4, 7, 1, 8, 2};
+   array.partialSort(3);
+   ASSERT_EQ(array.getSize(), 6);
+   ASSERT_EQ(NumericVariant(array.getValue(0)).toLong(), 1);
+   ASSERT_EQ(NumericVariant(array.getValue(1)).toLong(), 2);
+   ASSERT_EQ(NumericVariant(array.getValue(2)).toLong(), 4);
+   array.partialSort(2, [](const zval &lhs, const zval &rhs) -> bool {
+      return Z_LVAL(lhs) > Z_LVAL(rhs);
+   });
+   ASSERT_EQ(NumericVariant(array.getValue(0)).toLong(), 9);
+   ASSERT_EQ(NumericVariant(array.getValue(1)).toLong(), 8);
+}
+
+TEST(ArrayVariantTest, testSortMatchesUsort)
+{
+   const int count = 1000;
+   std::mt19937 generator(2017);
+   std::uniform_int_distribution<zapi_long> distribution(0, count * 10);
+   ArrayVariant source;
+   for (int i = 0; i < count; ++i) {
+      source.append(distribution(generator));
+   }
+   zval data;
+   ZVAL_COPY(&data, source.getZvalPtr());
+   zend_hash_str_update(&EG(symbol_table), "zapiSortData", sizeof("zapiSortData") - 1, &data);
+   zend_eval_string(const_cast<char *>("usort($zapiSortData, function ($lhs, $rhs) { return $lhs <=> $rhs; });"),
+                    nullptr, const_cast<char *>("ArrayVariant sort test"));
+   ArrayVariant radixSorted(source);
+   radixSorted.sort();
+   ArrayVariant nativeSorted(source);
+   nativeSorted.sort([](const zval &lhs, const zval &rhs) -> bool {
+      return Z_LVAL(lhs) < Z_LVAL(rhs);
+   });
+   ArrayVariant phpSorted(zend_hash_str_find(&EG(symbol_table), "zapiSortData", sizeof("zapiSortData") - 1));
+   ASSERT_TRUE(radixSorted.strictEqual(phpSorted));
+   ASSERT_TRUE(nativeSorted.strictEqual(phpSorted));
+   zend_hash_str_del(&EG(symbol_table), "zapiSortData", sizeof("zapiSortData") - 1);
+}
+
+TEST(ArrayVariantTest, testArrayBuilder)
+{
+   ArrayBuilder builder(4);
+   zval value;
+   ZVAL_LONG(&value, 1);
+   builder.append(&value);
+   ZVAL_STRING(&value, "zapi");
+   builder.appendNew(&value);
+   ZVAL_LONG(&value, 2);
+   builder.add(ArrayKey("name"), &value);
+   ZVAL_LONG(&value, 3);
+   builder.update(ArrayKey("name"), &value);
+   ASSERT_EQ(builder.getSize(), 3);
+   ArrayVariant array = builder.build();
+   ASSERT_EQ(builder.getSize(), 0);
+   ASSERT_EQ(array.getSize(), 3);
+   ASSERT_EQ(NumericVariant(array.getValue(0)).toLong(), 1);
+   ASSERT_EQ(StringVariant(array.getValue(1)).toString(), "zapi");
+   ASSERT_EQ(NumericVariant(array.getValue("name")).toLong(), 3);
+   // nothing is allocated until the builder is written again
+   ASSERT_EQ(builder.getZendArrayPtr(), nullptr);
+   ASSERT_EQ(builder.build().getSize(), 0);
+   builder.append(&value);
+   ASSERT_EQ(builder.build().getSize(), 1);
+}
+
+TEST(ArrayVariantTest, testKeySetOperations)
+{
+   ArrayVariant array;
+   array.insert("name", "zapi");
+   array.insert("age", 12);
+   array.insert(1, "a");
+   array.insert(2, "b");
+   ArrayVariant other;
+   other.insert("name", "php");
+   other.insert(2, "x");
+   ArrayVariant third;
+   third.insert(2, "y");
+   ArrayVariant result = array.intersectKey(other);
+   ASSERT_EQ(result.getSize(), 2);
+   ASSERT_EQ(StringVariant(result.getValue("name")).toString(), "zapi");
+   ASSERT_EQ(StringVariant(result.getValue(2)).toString(), "b");
+   result = array.intersectKey({other, third});
+   ASSERT_EQ(result.getSize(), 1);
+   ASSERT_TRUE(result.contains(2));
+   result = array.diffKey(other);
+   ASSERT_EQ(result.getSize(), 2);
+   ASSERT_TRUE(result.contains("age"));
+   ASSERT_TRUE(result.contains(1));
+   result = array.diffKey({other, ArrayVariant{"a", "b"}});
+   ASSERT_EQ(result.getSize(), 1);
+   ASSERT_TRUE(result.contains("age"));
+}
+
+TEST(ArrayVariantTest, testValueSetOperations)
+{
+   ArrayVariant array{1, "2", 3.0, "zapi", true};
+   ArrayVariant other{"1", 2, "3"};
+   // loose comparison compares the string representations
+   ArrayVariant result = array.intersect(other);
+   ASSERT_EQ(result.getSize(), 4);
+   ASSERT_TRUE(result.contains(0));
+   ASSERT_TRUE(result.contains(2));
+   ASSERT_TRUE(result.contains(4));
+   ASSERT_FALSE(result.contains(3));
+   result = array.intersect(other, true);
+   ASSERT_TRUE(result.isEmpty());
+   result = array.diff(other);
+   ASSERT_EQ(result.getSize(), 1);
+   ASSERT_EQ(StringVariant(result.getValue(3)).toString(), "zapi");
+   result = array.diff({other, ArrayVariant{"zapi"}});
+   ASSERT_TRUE(result.isEmpty());
+   result = array.intersect({ArrayVariant{1, 3, "zapi"}, ArrayVariant{"zapi", 3}}, true);
+   ASSERT_EQ(result.getSize(), 1);
+   ASSERT_TRUE(result.contains(3));
+   ArrayVariant duplicated{1, "1", 2, 1.0, 2, "zapi", "zapi"};
+   result = duplicated.unique();
+   ASSERT_EQ(result.getSize(), 3);
+   ASSERT_TRUE(result.contains(0));
+   ASSERT_TRUE(result.contains(2));
+   ASSERT_TRUE(result.contains(5));
+   result = duplicated.unique(true);
+   ASSERT_EQ(result.getSize(), 5);
+   ASSERT_TRUE(result.contains(3));
+   ASSERT_FALSE(result.contains(4));
+}
+
+TEST(ArrayVariantTest, testMerge)
+{
+   ArrayVariant array;
+   array.insert(3, "a");
+   array.insert("name", "zapi");
+   ArrayVariant other;
+   other.insert("name", "php");
+   other.insert(7, "b");
+   ArrayVariant result = array.merge({other, ArrayVariant{"c", "d"}});
+   ASSERT_EQ(result.getSize(), 5);
+   std::list<KeyType> keys = result.getKeys();
+   auto iter = keys.begin();
+   ASSERT_EQ(iter->first, 0);
+   ++iter;
+   ASSERT_EQ(*iter->second, "name");
+   ASSERT_EQ(StringVariant(result.getValue("name")).toString(), "php");
+   ASSERT_EQ(StringVariant(result.getValue(1)).toString(), "b");
+   ASSERT_EQ(StringVariant(result.getValue(3)).toString(), "d");
+   ASSERT_EQ(array.getSize(), 2);
+   ArrayVariant packed = ArrayVariant{1, 2}.merge(ArrayVariant{3});
+   ASSERT_TRUE(packed.strictEqual(ArrayVariant{1, 2, 3}));
+}
+
+TEST(ArrayVariantTest, testMutationScope)
+{
+   ArrayVariant::MutationScope::resetSeparationCount();
+   ArrayVariant array{1, 2, 3};
+   {
+      ArrayVariant::MutationScope scope(array);
+      ASSERT_FALSE(scope.isSeparated());
+      scope.reserve(8);
+      for (zapi_long i = 4; i <= 8; ++i) {
+         scope.append(Variant(i));
+      }
+      scope.insert(ArrayKey("name"), Variant("zapi"));
+      ASSERT_TRUE(scope.remove(ArrayKey(0)));
+      ASSERT_FALSE(scope.remove(ArrayKey(100)));
+      ASSERT_EQ(Z_LVAL_P(scope.find(ArrayKey(7))), 8);
+      ASSERT_EQ(scope.getSize(), 8);
+   }
+   ASSERT_EQ(array.getSize(), 8);
+   ASSERT_EQ(StringVariant(array.getValue("name")).toString(), "zapi");
+   ASSERT_EQ(ArrayVariant::MutationScope::getSeparationCount(), 0);
+   // shared array is copied once by the scope
+   ArrayVariant shared(array);
+   {
+      ArrayVariant::MutationScope scope(shared);
+      ASSERT_TRUE(scope.isSeparated());
+      zval value;
+      ZVAL_LONG(&value, 100);
+      scope.insert(ArrayKey(1), &value);
+      scope.append(&value);
+   }
+   ASSERT_EQ(ArrayVariant::MutationScope::getSeparationCount(), 1);
+   ASSERT_EQ(NumericVariant(shared.getValue(1)).toLong(), 100);
+   ASSERT_EQ(NumericVariant(array.getValue(1)).toLong(), 2);
+   ASSERT_EQ(shared.getSize(), 9);
+   ASSERT_EQ(array.getSize(), 8);
+   // the value refused by the hash table is released
+   ArrayVariant full;
+   {
+      ArrayVariant::MutationScope scope(full);
+      scope.insert(ArrayKey(ZEND_LONG_MAX), Variant(1));
+      Variant text(std::string("not inserted"));
+      ASSERT_EQ(scope.append(text), nullptr);
+      ASSERT_EQ(text.getRefCount(), 1);
+   }
+   ASSERT_EQ(full.getSize(), 1);
+   ArrayVariant::MutationScope::resetSeparationCount();
+}
+
+TEST(ArrayVariantTest, testFunctional)
+{
+   ArrayVariant numbers{1, 2, 3, 4, 5, 6};
+   auto isEven = [](const zval &value) -> bool {
+      return Z_LVAL(value) % 2 == 0;
+   };
+   ArrayVariant even = numbers.filter(isEven);
+   ASSERT_EQ(even.getSize(), 3);
+   ASSERT_TRUE(even.contains(1));
+   ASSERT_FALSE(even.contains(0));
+   ASSERT_TRUE(numbers.filter(isEven, true).strictEqual(ArrayVariant{2, 4, 6}));
+   ArrayVariant squares = numbers.mapValues([](const zval &value, zval *result) {
+      ZVAL_LONG(result, Z_LVAL(value) * Z_LVAL(value));
+   });
+   ASSERT_TRUE(squares.strictEqual(ArrayVariant{1, 4, 9, 16, 25, 36}));
+   zapi_long sum = numbers.reduce(static_cast<zapi_long>(0), [](zapi_long total, const zval &value) {
+      return total + Z_LVAL(value);
+   });
+   ASSERT_EQ(sum, 21);
+   ArrayKey evenKey("even");
+   ArrayKey oddKey("odd");
+   ArrayVariant groups = numbers.groupBy([&](const zval &value) -> ArrayKey {
+      return isEven(value) ? evenKey : oddKey;
+   });
+   ASSERT_EQ(groups.getSize(), 2);
+   ASSERT_TRUE(ArrayVariant(groups.getValue("odd")).strictEqual(ArrayVariant{1, 3, 5}));
+   groups = numbers.groupBy([&](const zval &value) -> ArrayKey {
+      return isEven(value) ? evenKey : oddKey;
+   }, true);
+   ASSERT_TRUE(ArrayVariant(groups.getValue("even")).contains(5));
+   
+   auto makeRow = [](int id, const char *name) -> ArrayVariant {
+      ArrayVariant row;
+      row.insert("id", id);
+      row.insert("name", name);
+      return row;
+   };
+   ArrayVariant rows;
+   rows.append(makeRow(7, "php"));
+   rows.append(makeRow(9, "zapi"));
+   rows.append("not a row");
+   ArrayVariant names = rows.column(ArrayKey("name"));
+   ASSERT_TRUE(names.strictEqual(ArrayVariant{"php", "zapi"}));
+   ArrayVariant namesById = rows.column(ArrayKey("name"), ArrayKey("id"));
+   ASSERT_EQ(namesById.getSize(), 2);
+   ASSERT_EQ(StringVariant(namesById.getValue(9)).toString(), "zapi");
+   ArrayVariant indexed = rows.indexBy(ArrayKey("id"));
+   ASSERT_EQ(indexed.getSize(), 2);
+   ASSERT_EQ(StringVariant(ArrayVariant(indexed.getValue(7)).getValue("name")).toString(), "php");
+}
+
+TEST(ArrayVariantTest, testFingerprint)
+{
+   ArrayVariant array;
+   array.insert("name", "zapi");
+   array.insert(1, 3.14);
+   array.insert("list", ArrayVariant{1, 2, 3});
+   ArrayVariant same;
+   same.insert("name", "zapi");
+   same.insert(1, 3.14);
+   same.insert("list", ArrayVariant{1, 2, 3});
+   ASSERT_EQ(array.fingerprint(), same.fingerprint());
+   ArrayVariant reversed;
+   reversed.insert("list", ArrayVariant{1, 2, 3});
+   reversed.insert(1, 3.14);
+   reversed.insert("name", "zapi");
+   ASSERT_NE(array.fingerprint(), reversed.fingerprint());
+   ASSERT_EQ(array.fingerprint(false), reversed.fingerprint(false));
+   // the keys count in both modes
+   ASSERT_NE(ArrayVariant{1, 2}.fingerprint(false), ArrayVariant{2, 1}.fingerprint(false));
+   ASSERT_NE(Variant(1).fingerprint(), Variant("1").fingerprint());
+   ASSERT_NE(Variant("a\0b", 3).fingerprint(), Variant("a\0c", 3).fingerprint());
+   // $a = []; $a['self'] = &$a;
+   zval recursive;
+   array_init(&recursive);
+   ZVAL_MAKE_REF(&recursive);
+   Z_ADDREF(recursive);
+   zend_hash_str_update(Z_ARRVAL_P(Z_REFVAL(recursive)), "self", 4, &recursive);
+   Variant value(&recursive);
+   ASSERT_EQ(value.fingerprint(), value.fingerprint());
+   zend_hash_str_del(Z_ARRVAL_P(Z_REFVAL(recursive)), "self", 4);
+   zval_ptr_dtor(&recursive);
+}
+
 TEST(ArrayVariantTest, testMap)
 {
    ArrayVariant array;
@@ -0,0 +1,272 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/ds/BinaryCodec.h"
+#include "zapi/ds/ArrayVariant.h"
+#include "zapi/ds/StringVariant.h"
+#include "zapi/ds/NumericVariant.h"
+#include "zapi/ds/DoubleVariant.h"
+#include <string>
+#include <cstdio>
+#include <limits>
+
+using zapi::ds::BinaryWriter;
+using zapi::ds::BinaryReader;
+using zapi::ds::ArrayVariant;
+using zapi::ds::Variant;
+using zapi::ds::StringVariant;
+using zapi::ds::NumericVariant;
+using zapi::ds::DoubleVariant;
+
+TEST(BinaryCodecTest, testRoundTrip)
+{
+   ArrayVariant record;
+   record.insert("id", std::numeric_limits<zapi_long>::min());
+   record.insert("name", "caf\xc3\xa9");
+   record.insert("empty", "");
+   record.insert("ratio", -0.25);
+   record.insert("ok", true);
+   record.insert("none", nullptr);
+   record.insert(42, ArrayVariant{1, 2, 3, 4, 5, 6.5, 7.5, 8.5, 9.5, "x", ArrayVariant()});
+   BinaryWriter writer;
+   ASSERT_TRUE(writer.write(record));
+   ASSERT_TRUE(writer.write(Variant("second")));
+   BinaryReader reader(writer.getData(), writer.getSize());
+   Variant decoded;
+   ASSERT_TRUE(reader.read(decoded));
+   ASSERT_TRUE(ArrayVariant(decoded).strictEqual(record));
+   ASSERT_TRUE(reader.read(decoded));
+   ASSERT_EQ(StringVariant(decoded).toString(), "second");
+   ASSERT_TRUE(reader.atEnd());
+   ASSERT_FALSE(reader.read(decoded));
+   ASSERT_EQ(reader.getError(), BinaryReader::Error::None);
+}
+
+TEST(BinaryCodecTest, testCompactness)
+{
+   ArrayVariant rows;
+   for (int i = 0; i < 100; ++i) {
+      ArrayVariant row;
+      row.insert("identifier", i);
+      row.insert("category", "category name");
+      rows.append(row);
+   }
+   BinaryWriter writer;
+   ASSERT_TRUE(writer.write(rows));
+   // the keys and the repeated value are written once
+   ASSERT_LT(writer.getSize(), 100 * 12);
+   ArrayVariant numbers;
+   for (int i = 0; i < 1000; ++i) {
+      numbers.append(i);
+   }
+   writer.clear();
+   ASSERT_TRUE(writer.write(numbers));
+   // a run has no tag per element
+   ASSERT_LT(writer.getSize(), 2100);
+   Variant bytes = writer.detach();
+   ASSERT_EQ(writer.getSize(), 0);
+   Variant decoded;
+   ASSERT_TRUE(BinaryReader(StringVariant(bytes).toString()).read(decoded));
+   ASSERT_TRUE(ArrayVariant(decoded).strictEqual(numbers));
+}
+
+TEST(BinaryCodecTest, testErrors)
+{
+   BinaryWriter writer;
+   ASSERT_TRUE(writer.write(ArrayVariant{"abc", 12}));
+   std::string bytes(writer.getData(), writer.getSize());
+   Variant decoded;
+   BinaryReader truncated(bytes.data(), bytes.length() - 1);
+   ASSERT_FALSE(truncated.read(decoded));
+   ASSERT_EQ(truncated.getError(), BinaryReader::Error::Truncated);
+   BinaryReader header(std::string("ZB\x7f") + bytes.substr(3));
+   ASSERT_FALSE(header.read(decoded));
+   ASSERT_EQ(header.getError(), BinaryReader::Error::Header);
+   std::string corrupted(bytes);
+   corrupted[3] = '\x60';
+   BinaryReader reader(corrupted);
+   ASSERT_FALSE(reader.read(decoded));
+   ASSERT_EQ(reader.getError(), BinaryReader::Error::Corrupted);
+   writer.clear();
+   ArrayVariant inner{1};
+   ArrayVariant middle;
+   middle.append(inner);
+   ArrayVariant outer;
+   outer.append(middle);
+   ASSERT_TRUE(writer.write(middle));
+   ASSERT_TRUE(writer.write(outer));
+   BinaryReader shallow(writer.getData(), writer.getSize(), 2);
+   ASSERT_TRUE(shallow.read(decoded));
+   ASSERT_FALSE(shallow.read(decoded));
+   ASSERT_EQ(shallow.getError(), BinaryReader::Error::Depth);
+   // the writer fails early on what the reader would refuse
+   BinaryWriter limited(-1, 2);
+   ASSERT_TRUE(limited.write(middle));
+   size_t written = limited.getSize();
+   ASSERT_FALSE(limited.write(outer));
+   ASSERT_EQ(limited.getError(), BinaryWriter::Error::Depth);
+   ASSERT_EQ(limited.getSize(), written);
+
+   writer.clear();
+   ArrayVariant recursive;
+   recursive.append(1);
+   zval *self = recursive.getZvalPtr();
+   Z_ADDREF_P(self);
+   zend_hash_next_index_insert(Z_ARRVAL_P(self), self);
+   ASSERT_FALSE(writer.write(recursive));
+   ASSERT_EQ(writer.getError(), BinaryWriter::Error::Recursion);
+   ASSERT_EQ(writer.getSize(), 0);
+   zend_hash_index_del(Z_ARRVAL_P(self), 1);
+}
+
+TEST(BinaryCodecTest, testUnsupportedClasses)
+{
+   zend_eval_string(const_cast<char *>(
+                       "class ZapiBinarySerializable implements Serializable {"
+                       "   public function serialize() { return ''; }"
+                       "   public function unserialize($data) {}"
+                       "}"
+                       "class ZapiBinarySleep {"
+                       "   public $kept = 1; public $dropped = 2;"
+                       "   public function __sleep() { return ['kept']; }"
+                       "}"
+                       "class ZapiBinaryArrayObject extends ArrayObject {}"), nullptr,
+                    const_cast<char *>("binary unsupported classes"));
+   const char *sources[] = {
+      "new ZapiBinarySerializable",
+      "new ZapiBinarySleep",
+      "new ArrayObject([1, 2])",
+      "new ZapiBinaryArrayObject([1, 2])",
+      "new DateTime('2017-01-01')",
+      "new SplObjectStorage",
+      "function () {}"
+   };
+   BinaryWriter writer;
+   for (const char *source : sources) {
+      zval object;
+      zend_eval_string(const_cast<char *>(source), &object, const_cast<char *>("binary unsupported"));
+      ASSERT_FALSE(writer.write(Variant(&object))) << source;
+      ASSERT_EQ(writer.getError(), BinaryWriter::Error::UnsupportedType) << source;
+      ASSERT_EQ(writer.getSize(), 0) << source;
+      zval_ptr_dtor(&object);
+      writer.clear();
+   }
+   zval object;
+   zend_eval_string(const_cast<char *>("(object) ['plain' => 1]"), &object, const_cast<char *>("binary stdclass"));
+   ASSERT_TRUE(writer.write(Variant(&object)));
+   zval_ptr_dtor(&object);
+}
+
+TEST(BinaryCodecTest, testDescriptor)
+{
+   std::FILE *file = std::tmpfile();
+   ASSERT_TRUE(file != nullptr);
+   ArrayVariant big;
+   for (int i = 0; i < 20000; ++i) {
+      big.append("value " + std::to_string(i));
+   }
+   {
+      BinaryWriter writer(fileno(file));
+      ASSERT_TRUE(writer.write(big));
+      ASSERT_TRUE(writer.write(Variant(7)));
+      ASSERT_EQ(writer.getSize(), 0);
+   }
+   std::string bytes;
+   std::rewind(file);
+   char chunk[4096];
+   size_t length;
+   while ((length = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+      bytes.append(chunk, length);
+   }
+   std::fclose(file);
+   BinaryReader reader(bytes);
+   Variant decoded;
+   ASSERT_TRUE(reader.read(decoded));
+   ASSERT_TRUE(ArrayVariant(decoded).strictEqual(big));
+   ASSERT_TRUE(reader.read(decoded));
+   ASSERT_EQ(NumericVariant(decoded).toLong(), 7);
+}
+
+TEST(BinaryCodecTest, testRecords)
+{
+   const int count = 200;
+   ArrayVariant records;
+   for (int i = 0; i < count; ++i) {
+      ArrayVariant record;
+      record.insert("id", i);
+      record.insert("name", "item " + std::to_string(i));
+      record.insert("price", i * 1.5);
+      record.insert("active", i % 2 == 0);
+      record.insert("tags", ArrayVariant{"red", "green", "blue"});
+      records.append(record);
+   }
+   BinaryWriter writer;
+   ASSERT_TRUE(writer.write(records));
+   Variant decoded;
+   BinaryReader reader(writer.getData(), writer.getSize());
+   ASSERT_TRUE(reader.read(decoded));
+   ASSERT_TRUE(ArrayVariant(decoded).strictEqual(records));
+   // the repeated keys and tags are written once
+   zval data;
+   ZVAL_COPY(&data, records.getZvalPtr());
+   zend_hash_str_update(&EG(symbol_table), "zapiRecords", sizeof("zapiRecords") - 1, &data);
+   zval serialized;
+   zend_eval_string(const_cast<char *>("serialize($zapiRecords)"), &serialized,
+                    const_cast<char *>("serialize size"));
+   ASSERT_LT(writer.getSize(), Z_STRLEN(serialized) / 2);
+   zval_ptr_dtor(&serialized);
+   zend_hash_str_del(&EG(symbol_table), "zapiRecords", sizeof("zapiRecords") - 1);
+}
+
+TEST(BinaryCodecTest, testWakeup)
+{
+   zend_eval_string(const_cast<char *>(
+                       "class ZapiBinaryWakeup {"
+                       "   public $inner; public $woken = 0;"
+                       "   public function __wakeup() {"
+                       "      $this->woken = $this->inner ? $this->inner->woken + 1 : 1;"
+                       "   }"
+                       "}"
+                       "class ZapiBinaryWakeupThrow {"
+                       "   public function __wakeup() { throw new Exception('no'); }"
+                       "}"), nullptr, const_cast<char *>("binary wakeup classes"));
+   zval object;
+   zend_eval_string(const_cast<char *>("(function () {"
+                                       "   $outer = new ZapiBinaryWakeup;"
+                                       "   $outer->inner = new ZapiBinaryWakeup;"
+                                       "   return $outer;"
+                                       "})()"), &object, const_cast<char *>("binary wakeup"));
+   BinaryWriter writer;
+   ASSERT_TRUE(writer.write(Variant(&object)));
+   zval_ptr_dtor(&object);
+   Variant decoded;
+   ASSERT_TRUE(BinaryReader(writer.getData(), writer.getSize()).read(decoded));
+   // the inner object is woken up first
+   zval *woken = zend_hash_str_find(Z_OBJPROP_P(decoded.getZvalPtr()), "woken", sizeof("woken") - 1);
+   ASSERT_NE(woken, nullptr);
+   ASSERT_EQ(Z_LVAL_P(woken), 2);
+   zend_eval_string(const_cast<char *>("new ZapiBinaryWakeupThrow"), &object,
+                    const_cast<char *>("binary wakeup throw"));
+   writer.clear();
+   ASSERT_TRUE(writer.write(Variant(&object)));
+   zval_ptr_dtor(&object);
+   BinaryReader reader(writer.getData(), writer.getSize());
+   ASSERT_FALSE(reader.read(decoded));
+   ASSERT_EQ(reader.getError(), BinaryReader::Error::Rejected);
+   ASSERT_NE(EG(exception), nullptr);
+   zend_clear_exception();
+}
@@ -19,12 +19,16 @@
 #include "zapi/Global.h"
 #include <limits>
 #include "zapi/ds/HashTable.h"
+#include "zapi/ds/ArrayVariant.h"
 #include "zapi/ds/Variant.h"
 #include <iostream>
 #include <vector>
 #include <string>
 
-using ZapiHashTable = zapi::ds::HashTable;
+using ZapiHashTable = zapi::ds::HashTable<>;
+using zapi::ds::HashTable;
+using zapi::ds::ArrayKey;
+using zapi::ds::ArrayVariant;
 using zapi::ds::Variant;
 
 namespace
@@ -33,218 +37,263 @@ namespace
 class HashTableTest : public ::testing::Test
 {};
 
-} // end of namespace
+struct NativeItem
+{
+   int id;
+};
 
-//TEST_F(HashTableTest, testConstructors) 
-//{
-//   {
-//      // default constructor
-//      ZapiHashTable table;
-//      ASSERT_EQ(table.getSize(), 0);
-//   }
-//}
+void destroy_native_item(zval *value)
+{
+   delete static_cast<NativeItem *>(Z_PTR_P(value));
+}
 
-//TEST_F(HashTableTest, testInsertItem)
-//{
-//   {
-//      // default constructor
-//      ZapiHashTable table;
-//      ASSERT_EQ(table.getSize(), 0);
-//      table.insert("name", Variant("zapi"));
-//      ASSERT_EQ(table.getSize(), 1);
-//      table.insert("age", Variant(20));
-//      ASSERT_EQ(table.getSize(), 2);
-//   }
-//}
+zval make_string(const char *str)
+{
+   zval value;
+   ZVAL_STRING(&value, str);
+   return value;
+}
 
-////TEST_F(HashTableTest, testIterator)
-////{
-////   {
-////      // default constructor
-////      ZapiHashTable table;
-////      ASSERT_EQ(table.getSize(), 0);
-////      table.insert("name", Variant("zapi"));
-////      ASSERT_EQ(table.getSize(), 1);
-////      table.insert("age", Variant(20));
-////      ASSERT_EQ(table.getSize(), 2);
-////      table.insert("height", Variant(123));
-////      ASSERT_EQ(table.getSize(), 3);
-////      ZapiHashTable::iterator iter = table.begin();
-////      std::vector<std::string> expectedKeys{"name", "age", "height"};
-////      std::vector<std::string> actualKeys;
-////      std::vector<std::string> expectedValueStrs{"zapi"};
-////      std::vector<int64_t> expectedValueInts{20, 123};
-////      std::vector<std::string> actualValueStrs;
-////      std::vector<int64_t> actualValueInts;
-////      while (iter != table.end()) {
-////         ZapiHashTable::HashKeyType keyType = iter.getKeyType();
-////         if (keyType == ZapiHashTable::HashKeyType::String) {
-////            actualKeys.push_back(iter.getStrKey());
-////         }
-////         Variant value = *iter;
-////         if (value.getType() == zapi::lang::Type::String) {
-////            actualValueStrs.push_back(value.toString());
-////         } else if (value.getType() == zapi::lang::Type::Long) {
-////            actualValueInts.push_back(value.toLong());
-////         }
-////         iter++;
-////      }
-////      ASSERT_EQ(expectedKeys, actualKeys);
-////      ASSERT_EQ(expectedValueStrs, actualValueStrs);
-////      ASSERT_EQ(expectedValueInts, actualValueInts);
-////   }
-////}
+zval make_long(zapi_long number)
+{
+   zval value;
+   ZVAL_LONG(&value, number);
+   return value;
+}
 
-//TEST_F(HashTableTest, testGetValue)
-//{
-//   {
-//      ZapiHashTable table;
-//      table.insert("name", Variant("zapi"));
-//      table.insert("city", Variant("beijing"));
-//      table.insert("height", Variant(123));
-////      ASSERT_EQ(table.getSize(), 3);
-////      ASSERT_EQ(table.getValue("name").toString(), "zapi");
-////      ASSERT_EQ(table.getValue("city").toString(), "beijing");
-////      ASSERT_EQ(table.getValue("height").toLong(), 123);
-////      ASSERT_EQ(table["name"].toString(), "zapi");
-////      ASSERT_EQ(table["city"].toString(), "beijing");
-////      ASSERT_EQ(table["height"].toLong(), 123);
-////      // test default value
-////      ASSERT_EQ(table.getValue("notExistKey", 123).toLong(), 123);
-////      ASSERT_EQ(table.getValue("notExistKey", "zapi").toString(), "zapi");
-//   }
-//}
+} // end of namespace
 
-//TEST_F(HashTableTest, testGetKey)
-//{
-//   ZapiHashTable table;
-//   // this trigger a warning
-//   // table.getKey();
-//   table.insert("name", Variant("zapi"));
-//   ASSERT_EQ(table.getKey().toString(), "name");
-//   table.insert("key1", Variant("item1"));
-//   table.insert("key2", Variant("item2"));
-//   table.insert("key3", Variant("item3"));
-//   table.insert("anotherKey1", Variant("item1"));
-//   table.insert(12, Variant(122));
-//   // find the first match key
-//   ASSERT_EQ(table.getKey(Variant("item1")).toString(), "key1");
-//   ASSERT_EQ(table.getKey(Variant("item2")).toString(), "key2");
-////   ASSERT_EQ(table.getKey(Variant(122)).toLong(), 12);
-////   // test default key
-////   ASSERT_EQ(table.getKey(Variant("notExist"), "defaultKey").toString(), "defaultKey");
-////   ASSERT_EQ(table.getKey(Variant(1234), 11).toLong(), 11);
-//}
+TEST_F(HashTableTest, testConstructors) 
+{
+   {
+      // default constructor
+      ZapiHashTable table;
+      ASSERT_EQ(table.getSize(), 0);
+      ASSERT_TRUE(table.isEmpty());
+      ASSERT_FALSE(table.isPersistent());
+   }
+   {
+      ZapiHashTable table(32, true);
+      ASSERT_TRUE(table.isPersistent());
+      zval value = make_long(1);
+      table.insert("name", 4, &value);
+      ASSERT_EQ(table.getSize(), 1);
+   }
+   {
+      // wrap the array of a zval, the wrapper doesn't own it
+      ArrayVariant array{1, 2, 3};
+      ZapiHashTable table(Z_ARRVAL_P(array.getZvalPtr()));
+      ASSERT_EQ(table.getSize(), 3);
+      ASSERT_TRUE(table.isPacked());
+      ASSERT_EQ(Z_LVAL_P(table.find(2)), 3);
+   }
+   {
+      ZapiHashTable table;
+      zval value = make_long(12);
+      table.append(&value);
+      ZapiHashTable moved(std::move(table));
+      ASSERT_EQ(moved.getSize(), 1);
+      zval array;
+      ZVAL_ARR(&array, moved.detach());
+      ArrayVariant variant(&array);
+      zval_ptr_dtor(&array);
+      ASSERT_EQ(variant.getSize(), 1);
+   }
+}
 
+TEST_F(HashTableTest, testInsertItem)
+{
+   ZapiHashTable table;
+   ASSERT_EQ(table.getSize(), 0);
+   zval value = make_string("zapi");
+   table.insert("name", 4, &value);
+   ASSERT_EQ(table.getSize(), 1);
+   value = make_long(20);
+   table.insert(ArrayKey("age"), &value);
+   ASSERT_EQ(table.getSize(), 2);
+   value = make_long(21);
+   ASSERT_TRUE(table.add(ArrayKey("age"), &value) == nullptr);
+   value = make_long(22);
+   ASSERT_EQ(Z_LVAL_P(table.insert(ArrayKey("age"), &value)), 22);
+   value = make_long(1);
+   table.insert(10, &value);
+   value = make_long(2);
+   ASSERT_EQ(Z_LVAL_P(table.append(&value)), 2);
+   ASSERT_EQ(Z_LVAL_P(table.find(11)), 2);
+   ASSERT_EQ(table.getSize(), 4);
+}
 
-//TEST_F(HashTableTest, testAssignValue)
-//{
-////   ZapiHashTable table;
-////   table.insert("num", Variant(123));
-////   table["num"] = Variant(213);
-////   ASSERT_EQ(table["num"].toLong(), 213);
-////   table["num"] = Variant("zapi");
-////   ASSERT_EQ(table["num"].toString(), "zapi");
-////   table["name"] = Variant("zzu_softboy");
-////   ASSERT_EQ(table["name"].toString(), "zzu_softboy");
-////   table["age"] = Variant(123);
-////   ASSERT_EQ(table["age"].toLong(), 123);
-////   table.append(Variant(1234));
-////   ASSERT_EQ(table[0].toLong(), 1234);
-////   table.append(Variant(4321));
-////   ASSERT_EQ(table[1].toLong(), 4321);
-////   table.append(Variant("zapi"));
-////   ASSERT_EQ(table[2].toString(), "zapi");
-//}
+TEST_F(HashTableTest, testPackedMode)
+{
+   ZapiHashTable table;
+   table.initPacked();
+   for (zapi_long i = 0; i < 100; ++i) {
+      zval value = make_long(i);
+      table.append(&value);
+   }
+   ASSERT_TRUE(table.isPacked());
+   ASSERT_EQ(Z_LVAL_P(table.find(99)), 99);
+   zval value = make_long(100);
+   table.insert("key", 3, &value);
+   ASSERT_FALSE(table.isPacked());
+   ASSERT_EQ(Z_LVAL_P(table.find(50)), 50);
+   ZapiHashTable hashTable;
+   hashTable.initHash();
+   value = make_long(0);
+   hashTable.append(&value);
+   ASSERT_FALSE(hashTable.isPacked());
+   ZapiHashTable converted;
+   converted.append(&value);
+   ASSERT_TRUE(converted.isPacked());
+   converted.convertToHash();
+   ASSERT_FALSE(converted.isPacked());
+   converted.reserve(64);
+   ASSERT_EQ(Z_LVAL_P(converted.find(0)), 0);
+}
 
-//TEST_F(HashTableTest, testDeleteItem)
-//{
-//   ZapiHashTable table;
-//   table.insert("item1", Variant(123));
-//   table.insert("item2", Variant("softboy"));
-//   table.insert("item3", Variant(true));
-//   ASSERT_EQ(table.getSize(), 3);
-//   ASSERT_FALSE(table.remove("notExist"));
-//   ASSERT_TRUE(table.remove("item1"));
-//   ASSERT_EQ(table.getSize(), 2);
-//   ASSERT_TRUE(table.remove("item2"));
-//   ASSERT_TRUE(table.remove("item3"));
-//   ASSERT_EQ(table.getSize(), 0);
-//   table.insert(0, Variant(true));
-//   table.insert(1, Variant(false));
-//   ASSERT_EQ(table.getSize(), 2);
-//   ASSERT_FALSE(table.remove(3));
-//   ASSERT_TRUE(table.remove(1));
-//   ASSERT_TRUE(table.remove(0));
-//   ASSERT_EQ(table.getSize(), 0);
-//}
+TEST_F(HashTableTest, testGetValue)
+{
+   ZapiHashTable table;
+   zval value = make_string("zapi");
+   table.insert("name", 4, &value);
+   value = make_string("beijing");
+   table.insert("city", 4, &value);
+   value = make_long(123);
+   table.insert("height", 6, &value);
+   ASSERT_EQ(table.getSize(), 3);
+   ASSERT_STREQ(Z_STRVAL_P(table.find("name", 4)), "zapi");
+   ASSERT_STREQ(Z_STRVAL_P(table.find(ArrayKey("city"))), "beijing");
+   ASSERT_EQ(Z_LVAL_P(table.find("height", 6, zend_inline_hash_func("height", 6))), 123);
+   zend_string *key = zend_string_init("name", 4, 0);
+   ASSERT_STREQ(Z_STRVAL_P(table.find(key)), "zapi");
+   zend_string_release(key);
+   ASSERT_TRUE(table.find("notExistKey", 11) == nullptr);
+   ASSERT_TRUE(table.find(ArrayKey("notExistKey")) == nullptr);
+   ASSERT_TRUE(table.find("heigh", 5, zend_inline_hash_func("heigh", 5)) == nullptr);
+   ASSERT_TRUE(table.find(1) == nullptr);
+}
+
+TEST_F(HashTableTest, testPointerTable)
+{
+   HashTable<NativeItem *> table(8, false, destroy_native_item);
+   table.insert(ArrayKey("first"), new NativeItem{1});
+   table.insert(ArrayKey("second"), new NativeItem{2});
+   table.append(new NativeItem{3});
+   ASSERT_EQ(table.find(ArrayKey("first"))->id, 1);
+   ASSERT_EQ(table.find(0)->id, 3);
+   ASSERT_TRUE(table.find(ArrayKey("third")) == nullptr);
+   ASSERT_TRUE(table.erase(ArrayKey("second")));
+   int sum = 0;
+   table.forEach([&sum](zend_ulong, zend_string *, NativeItem *item) {
+      sum += item->id;
+   });
+   ASSERT_EQ(sum, 4);
+}
+
+TEST_F(HashTableTest, testDeleteItem)
+{
+   ZapiHashTable table;
+   zval value = make_long(123);
+   table.insert("item1", 5, &value);
+   value = make_string("softboy");
+   table.insert("item2", 5, &value);
+   ZVAL_TRUE(&value);
+   table.insert("item3", 5, &value);
+   ASSERT_EQ(table.getSize(), 3);
+   ASSERT_FALSE(table.erase("notExist", 8));
+   ASSERT_TRUE(table.erase("item1", 5));
+   ASSERT_EQ(table.getSize(), 2);
+   ASSERT_TRUE(table.erase(ArrayKey("item2")));
+   ASSERT_TRUE(table.erase(ArrayKey("item3")));
+   ASSERT_EQ(table.getSize(), 0);
+   ZVAL_TRUE(&value);
+   table.insert(0, &value);
+   ZVAL_FALSE(&value);
+   table.insert(1, &value);
+   ASSERT_EQ(table.getSize(), 2);
+   ASSERT_FALSE(table.erase(3));
+   ASSERT_TRUE(table.erase(1));
+   ASSERT_TRUE(table.erase(ArrayKey(0)));
+   ASSERT_EQ(table.getSize(), 0);
+   table.append(&value);
+   table.clear();
+   ASSERT_TRUE(table.isEmpty());
+}
 
-//TEST_F(HashTableTest, testContains) 
-//{
-//   ZapiHashTable table;
-//   ASSERT_FALSE(table.contains(1));
-//   table.insert(0, Variant("zapi"));
-//   ASSERT_FALSE(table.contains(1));
-//   table.insert(1, Variant("zapi"));
-//   ASSERT_TRUE(table.contains(1));
-//   ASSERT_FALSE(table.contains("name"));
-//   table.insert("name", Variant("zapi"));
-//   ASSERT_TRUE(table.contains("name"));
-//}
+TEST_F(HashTableTest, testContains) 
+{
+   ZapiHashTable table;
+   ASSERT_FALSE(table.contains(1));
+   zval value = make_string("zapi");
+   table.insert(0, &value);
+   ASSERT_FALSE(table.contains(1));
+   value = make_string("zapi");
+   table.insert(1, &value);
+   ASSERT_TRUE(table.contains(1));
+   ASSERT_FALSE(table.contains("name", 4));
+   ASSERT_FALSE(table.contains(ArrayKey("name")));
+   value = make_string("zapi");
+   table.insert("name", 4, &value);
+   ASSERT_TRUE(table.contains("name", 4));
+   ASSERT_TRUE(table.contains(ArrayKey("name")));
+}
 
-////TEST_F(HashTableTest, testEach)
-////{
-////   ZapiHashTable table;
-////   table.insert("item1", Variant(123));
-////   table.insert("item2", Variant("softboy"));
-////   table.insert("item3", Variant(true));
-////   {
-////      std::vector<std::string> expectedKeys{"item1", "item2", "item3"};
-////      std::vector<std::string> keys;
-////      std::vector<Variant> values;
-////      table.each([&keys, &values](const Variant &key, const Variant &value) mutable{
-////         if (key.getType() == zapi::lang::Type::String) {
-////            keys.push_back(key.toString());
-////         }
-////         values.push_back(value);
-////      });
-////      ASSERT_EQ(keys.size(), 3);
-////      ASSERT_EQ(keys, expectedKeys);
-////      ASSERT_EQ(values.size(), 3);
-////      ASSERT_EQ(values[0].toLong(), 123);
-////      ASSERT_EQ(values[1].toString(), "softboy");
-////      ASSERT_EQ(values[2].toBool(), true);
-////   }
-////   {
-////      std::vector<std::string> expectedKeys{"item3", "item2", "item1"};
-////      std::vector<std::string> keys;
-////      std::vector<Variant> values;
-////      table.reverseEach([&keys, &values](const Variant &key, const Variant &value) mutable{
-////         if (key.getType() == zapi::lang::Type::String) {
-////            keys.push_back(key.toString());
-////         }
-////         values.push_back(value);
-////      });
-////      ASSERT_EQ(keys.size(), 3);
-////      ASSERT_EQ(keys, expectedKeys);
-////      ASSERT_EQ(values.size(), 3);
-////      ASSERT_EQ(values[0].toBool(), true);
-////      ASSERT_EQ(values[1].toString(), "softboy");
-////      ASSERT_EQ(values[2].toLong(), 123);
-////   }
-////}
+TEST_F(HashTableTest, testEach)
+{
+   ZapiHashTable table;
+   zval value = make_long(123);
+   table.insert("item1", 5, &value);
+   value = make_string("softboy");
+   table.insert("item2", 5, &value);
+   ZVAL_TRUE(&value);
+   table.insert("item3", 5, &value);
+   {
+      std::vector<std::string> expectedKeys{"item1", "item2", "item3"};
+      std::vector<std::string> keys;
+      std::vector<int> types;
+      table.forEach([&keys, &types](zend_ulong, zend_string *key, zval *value) {
+         keys.push_back(std::string(ZSTR_VAL(key), ZSTR_LEN(key)));
+         types.push_back(Z_TYPE_P(value));
+      });
+      ASSERT_EQ(keys, expectedKeys);
+      ASSERT_EQ(types, std::vector<int>({IS_LONG, IS_STRING, IS_TRUE}));
+   }
+   {
+      std::vector<std::string> expectedKeys{"item3", "item2", "item1"};
+      std::vector<std::string> keys;
+      table.reverseForEach([&keys](zend_ulong, zend_string *key, zval *) {
+         keys.push_back(std::string(ZSTR_VAL(key), ZSTR_LEN(key)));
+      });
+      ASSERT_EQ(keys, expectedKeys);
+   }
+}
 
-//TEST_F(HashTableTest, testGetKeysAndValues)
-//{
-////   ZapiHashTable table;
-////   table.insert("item1", Variant(123));
-////   table.insert("item2", Variant("softboy"));
-////   table.insert("item3", Variant(true));
-////   std::vector<Variant> expectedValues{123, "softboy", true};
-////   std::vector<Variant> expectedKeys{"item1", "item2", "item3"};
-////   ASSERT_EQ(table.getKeys(), expectedKeys);
-////   ASSERT_EQ(table.getValues(), expectedValues);
-//}
+TEST_F(HashTableTest, testPreHashedLookup)
+{
+   const int count = 1000;
+   std::vector<std::string> names;
+   std::vector<ArrayKey> keys;
+   names.reserve(count);
+   keys.reserve(count);
+   for (int i = 0; i < count; ++i) {
+      names.push_back("key" + std::to_string(i));
+      keys.push_back(ArrayKey(names.back(), false));
+   }
+   ZapiHashTable table(count);
+   ArrayVariant array;
+   for (int i = 0; i < count; ++i) {
+      zval value = make_long(i);
+      table.insert(keys[i], &value);
+      array.insert(keys[i], Variant(i));
+   }
+   // pre-hashed keys find the same buckets as the plain string lookup
+   zend_array *raw = table.getZendArrayPtr();
+   for (int i = 0; i < count; ++i) {
+      zval *expected = zend_hash_str_find(raw, names[i].c_str(), names[i].length());
+      ASSERT_EQ(table.find(keys[i]), expected);
+      ASSERT_EQ(Z_LVAL_P(array.getValue(keys[i]).getZvalPtr()), i);
+   }
+}
 
 int main(int argc, char **argv)
 {
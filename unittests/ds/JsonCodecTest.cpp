@@ -0,0 +1,210 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/ds/JsonCodec.h"
+#include "zapi/ds/ArrayVariant.h"
+#include "zapi/ds/StringVariant.h"
+#include "zapi/ds/NumericVariant.h"
+#include "zapi/ds/DoubleVariant.h"
+#include <string>
+
+using zapi::ds::JsonDecoder;
+using zapi::ds::JsonEncoder;
+using zapi::ds::ArrayVariant;
+using zapi::ds::Variant;
+using zapi::ds::StringVariant;
+using zapi::ds::NumericVariant;
+using zapi::ds::DoubleVariant;
+
+TEST(JsonCodecTest, testDecode)
+{
+   JsonDecoder decoder;
+   Variant result;
+   ASSERT_TRUE(decoder.decode(" {\"id\": 12, \"name\": \"caf\\u00e9 \\ud83d\\ude00\", \"7\": [1, 2.5, -3e2],"
+                              " \"ok\": true, \"none\": null, \"big\": 92233720368547758070} ", result));
+   ArrayVariant object(result);
+   ASSERT_EQ(object.getSize(), 6);
+   ASSERT_EQ(NumericVariant(object.getValue("id")).toLong(), 12);
+   ASSERT_EQ(StringVariant(object.getValue("name")).toString(), "caf\xc3\xa9 \xf0\x9f\x98\x80");
+   // numeric keys become integer keys
+   ArrayVariant list(object.getValue(7));
+   ASSERT_EQ(list.getSize(), 3);
+   ASSERT_EQ(DoubleVariant(list.getValue(1)).toDouble(), 2.5);
+   ASSERT_EQ(DoubleVariant(list.getValue(2)).toDouble(), -300.0);
+   ASSERT_TRUE(object.getValue("big").isDouble());
+   ASSERT_TRUE(object.getValue("none").isNull());
+
+   ASSERT_FALSE(decoder.decode("[1, 2,]", result));
+   ASSERT_EQ(decoder.getError(), JsonDecoder::Error::Syntax);
+   ASSERT_EQ(decoder.getErrorOffset(), 6);
+   ASSERT_FALSE(decoder.decode("\"a\x01\"", result));
+   ASSERT_EQ(decoder.getError(), JsonDecoder::Error::ControlCharacter);
+   ASSERT_FALSE(decoder.decode("\"\xc3\x28\"", result));
+   ASSERT_EQ(decoder.getError(), JsonDecoder::Error::Utf8);
+   ASSERT_FALSE(decoder.decode("\"\\udc00\"", result));
+   ASSERT_EQ(decoder.getError(), JsonDecoder::Error::Utf16);
+   JsonDecoder shallow(2);
+   ASSERT_TRUE(shallow.decode("[[1]]", result));
+   ASSERT_FALSE(shallow.decode("[[[1]]]", result));
+   ASSERT_EQ(shallow.getError(), JsonDecoder::Error::Depth);
+}
+
+TEST(JsonCodecTest, testStream)
+{
+   JsonDecoder decoder;
+   Variant result;
+   decoder.feed("{\"a\": \"x\\");
+   ASSERT_FALSE(decoder.next(result));
+   ASSERT_EQ(decoder.getError(), JsonDecoder::Error::None);
+   decoder.feed("\"\"}\n[1, {\"b\": []}]\n42");
+   ASSERT_TRUE(decoder.next(result));
+   ASSERT_EQ(StringVariant(ArrayVariant(result).getValue("a")).toString(), "x\"");
+   ASSERT_TRUE(decoder.next(result));
+   ASSERT_EQ(ArrayVariant(result).getSize(), 2);
+   // a trailing scalar needs the end of the stream
+   ASSERT_FALSE(decoder.next(result));
+   decoder.feed("7 \"s\"");
+   ASSERT_TRUE(decoder.next(result));
+   ASSERT_EQ(NumericVariant(result).toLong(), 427);
+   ASSERT_TRUE(decoder.next(result));
+   ASSERT_EQ(StringVariant(result).toString(), "s");
+   decoder.feed("[1, ");
+   decoder.finish();
+   ASSERT_FALSE(decoder.next(result));
+   ASSERT_EQ(decoder.getError(), JsonDecoder::Error::Incomplete);
+   decoder.reset();
+   decoder.feed(" 1.5 ");
+   decoder.finish();
+   ASSERT_TRUE(decoder.next(result));
+   ASSERT_EQ(DoubleVariant(result).toDouble(), 1.5);
+   ASSERT_FALSE(decoder.next(result));
+   ASSERT_EQ(decoder.getError(), JsonDecoder::Error::None);
+}
+
+TEST(JsonCodecTest, testEncode)
+{
+   ArrayVariant object;
+   object.insert("id", 12);
+   object.insert("path", "a/b\n\"c\"");
+   object.insert("name", "caf\xc3\xa9");
+   object.insert("list", ArrayVariant{1, 2.5, true, nullptr});
+   object.insert("empty", ArrayVariant());
+   std::string json;
+   JsonEncoder encoder;
+   ASSERT_TRUE(encoder.encode(object, json));
+   ASSERT_EQ(json, "{\"id\":12,\"path\":\"a\\/b\\n\\\"c\\\"\",\"name\":\"caf\\u00e9\","
+                   "\"list\":[1,2.5,true,null],\"empty\":[]}");
+   JsonEncoder raw(JsonEncoder::UnescapedSlashes | JsonEncoder::UnescapedUnicode | JsonEncoder::PrettyPrint);
+   ArrayVariant small;
+   small.insert(3, "a/\xc3\xa9");
+   ASSERT_TRUE(raw.encode(small, json));
+   ASSERT_EQ(json, "{\n    \"3\": \"a/\xc3\xa9\"\n}");
+   ASSERT_FALSE(encoder.encode(Variant("\xc3\x28"), json));
+   ASSERT_EQ(encoder.getError(), JsonEncoder::Error::Utf8);
+   ArrayVariant recursive;
+   recursive.append(1);
+   zval *self = recursive.getZvalPtr();
+   Z_ADDREF_P(self);
+   zend_hash_next_index_insert(Z_ARRVAL_P(self), self);
+   ASSERT_FALSE(encoder.encode(recursive, json));
+   ASSERT_EQ(encoder.getError(), JsonEncoder::Error::Recursion);
+   zend_hash_index_del(Z_ARRVAL_P(self), 1);
+   // round trip through the decoder
+   ASSERT_TRUE(encoder.encode(object, json));
+   Variant decoded;
+   ASSERT_TRUE(JsonDecoder().decode(json, decoded));
+   ASSERT_TRUE(ArrayVariant(decoded).strictEqual(object));
+}
+
+TEST(JsonCodecTest, testExtJsonParity)
+{
+   const int count = 200;
+   ArrayVariant records;
+   for (int i = 0; i < count; ++i) {
+      ArrayVariant record;
+      record.insert("id", i);
+      record.insert("name", "item " + std::to_string(i));
+      record.insert("price", i * 1.5);
+      record.insert("active", i % 2 == 0);
+      record.insert("tags", ArrayVariant{"red", "green", "blue"});
+      records.append(record);
+   }
+   JsonEncoder encoder;
+   std::string json;
+   ASSERT_TRUE(encoder.encode(records, json));
+   Variant decoded;
+   ASSERT_TRUE(JsonDecoder().decode(json, decoded));
+   ASSERT_TRUE(ArrayVariant(decoded).strictEqual(records));
+   if (!zend_hash_str_exists(&module_registry, "json", sizeof("json") - 1)) {
+      return;
+   }
+   zval data;
+   ZVAL_COPY(&data, records.getZvalPtr());
+   zend_hash_str_update(&EG(symbol_table), "zapiJsonData", sizeof("zapiJsonData") - 1, &data);
+   ZVAL_STRINGL(&data, json.data(), json.length());
+   zend_hash_str_update(&EG(symbol_table), "zapiJsonText", sizeof("zapiJsonText") - 1, &data);
+   zval phpJson;
+   zend_eval_string(const_cast<char *>("json_encode($zapiJsonData)"), &phpJson,
+                    const_cast<char *>("json_encode parity"));
+   zval phpDecoded;
+   zend_eval_string(const_cast<char *>("json_decode($zapiJsonText, true)"), &phpDecoded,
+                    const_cast<char *>("json_decode parity"));
+   ASSERT_EQ(StringVariant(&phpJson).toString(), json);
+   ASSERT_TRUE(ArrayVariant(&phpDecoded).strictEqual(records));
+   zval_ptr_dtor(&phpJson);
+   zval_ptr_dtor(&phpDecoded);
+   zend_hash_str_del(&EG(symbol_table), "zapiJsonData", sizeof("zapiJsonData") - 1);
+   zend_hash_str_del(&EG(symbol_table), "zapiJsonText", sizeof("zapiJsonText") - 1);
+}
+
+TEST(JsonCodecTest, testJsonSerializable)
+{
+   if (!zend_hash_str_exists(&module_registry, "json", sizeof("json") - 1)) {
+      return;
+   }
+   zend_eval_string(const_cast<char *>(
+                       "class ZapiJsonPoint implements JsonSerializable {"
+                       "   public $x = 1; private $y = 2;"
+                       "   public function jsonSerialize() { return ['x' => $this->x, 'y' => $this->y]; }"
+                       "}"
+                       "class ZapiJsonSelf implements JsonSerializable {"
+                       "   public $name = 'self';"
+                       "   public function jsonSerialize() { return $this; }"
+                       "}"
+                       "class ZapiJsonThrow implements JsonSerializable {"
+                       "   public function jsonSerialize() { throw new Exception('no'); }"
+                       "}"), nullptr, const_cast<char *>("json serializable classes"));
+   zval point;
+   zend_eval_string(const_cast<char *>("new ZapiJsonPoint"), &point, const_cast<char *>("json point"));
+   zval self;
+   zend_eval_string(const_cast<char *>("new ZapiJsonSelf"), &self, const_cast<char *>("json self"));
+   ArrayVariant object;
+   object.insert("point", Variant(&point));
+   object.insert("self", Variant(&self));
+   zval_ptr_dtor(&point);
+   zval_ptr_dtor(&self);
+   JsonEncoder encoder;
+   std::string json;
+   ASSERT_TRUE(encoder.encode(object, json));
+   ASSERT_EQ(json, "{\"point\":{\"x\":1,\"y\":2},\"self\":{\"name\":\"self\"}}");
+   zval thrower;
+   zend_eval_string(const_cast<char *>("new ZapiJsonThrow"), &thrower, const_cast<char *>("json throw"));
+   ASSERT_FALSE(encoder.encode(Variant(&thrower), json));
+   ASSERT_EQ(encoder.getError(), JsonEncoder::Error::SerializeFailed);
+   zend_clear_exception();
+   zval_ptr_dtor(&thrower);
+}
@@ -14,10 +14,12 @@
 // Created by softboy on 2017/09/06.
 
 #include "php/sapi/embed/php_embed.h"
+#include "php/Zend/zend_exceptions.h"
 #include "gtest/gtest.h"
 #include "zapi/ds/ObjectVariant.h"
 #include "zapi/ds/StringVariant.h"
 #include "zapi/ds/NumericVariant.h"
+#include "zapi/lang/ClassRef.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -27,6 +29,7 @@ using zapi::ds::StringVariant;
 using zapi::ds::NumericVariant;
 using zapi::ds::Variant;
 using zapi::lang::Type;
+using zapi::lang::ClassRef;
 
 TEST(ObjectVariantTest, testStdObject)
 {
@@ -125,6 +128,33 @@ TEST(ObjectVariantTest, testConstructFromZval)
    }
 }
 
+TEST(ObjectVariantTest, testClassRef)
+{
+   ClassRef stdRef("stdClass");
+   ClassRef exceptionRef("\\Exception");
+   ClassRef missingRef("ZapiMissingClass");
+   ClassRef pinnedRef(zend_ce_error_exception);
+   ASSERT_EQ(stdRef.getEntry(), zend_standard_class_def);
+   ASSERT_EQ(exceptionRef.getEntry(), zend_ce_exception);
+   ASSERT_FALSE(missingRef.isValid());
+   ASSERT_EQ(pinnedRef.getName(), "ErrorException");
+   ASSERT_EQ(ClassRef::lookup("STDCLASS", 8), zend_standard_class_def);
+   ObjectVariant stdObj;
+   ASSERT_TRUE(stdObj.instanceOf(stdRef));
+   ASSERT_FALSE(stdObj.derivedFrom(stdRef));
+   ASSERT_FALSE(stdObj.instanceOf(exceptionRef));
+   ASSERT_FALSE(stdObj.instanceOf(missingRef));
+   ASSERT_TRUE(stdObj.instanceOf("\\stdclass"));
+   zval errorZval;
+   object_init_ex(&errorZval, zend_ce_error_exception);
+   ObjectVariant error(errorZval);
+   zval_ptr_dtor(&errorZval);
+   ASSERT_TRUE(error.instanceOf(pinnedRef));
+   ASSERT_FALSE(error.derivedFrom(pinnedRef));
+   ASSERT_TRUE(error.derivedFrom(exceptionRef));
+   ASSERT_TRUE(error.derivedFrom("Exception"));
+}
+
 TEST(ObjectVariantTest, testIsCallable)
 {
    ObjectVariant stdObj;
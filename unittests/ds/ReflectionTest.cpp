@@ -0,0 +1,84 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/ds/Reflection.h"
+#include "zapi/ds/ArrayVariant.h"
+#include "zapi/ds/StringVariant.h"
+#include "zapi/ds/NumericVariant.h"
+#include <string>
+#include <vector>
+
+using zapi::ds::ArrayVariant;
+using zapi::ds::StructInfo;
+using zapi::ds::StringVariant;
+using zapi::ds::NumericVariant;
+
+struct OrderLine
+{
+   std::string sku;
+   int qty;
+};
+
+struct Order
+{
+   zapi_long id;
+   double price;
+   bool paid;
+   std::vector<std::string> tags;
+   std::vector<OrderLine> lines;
+};
+
+ZAPI_REFLECT(OrderLine, sku, qty)
+ZAPI_REFLECT(Order, id, price, paid, tags, lines)
+
+TEST(ReflectionTest, testToArray)
+{
+   Order order{12, 9.5, true, {"new", "gift"}, {{"a-1", 2}, {"b-2", 1}}};
+   ArrayVariant array = StructInfo<Order>::toArray(order);
+   ASSERT_EQ(array.getSize(), 5);
+   ASSERT_EQ(NumericVariant(array.getValue("id")).toLong(), 12);
+   ArrayVariant tags(array.getValue("tags"));
+   ASSERT_TRUE(tags.strictEqual(ArrayVariant{"new", "gift"}));
+   ArrayVariant lines(array.getValue("lines"));
+   ASSERT_EQ(lines.getSize(), 2);
+   ArrayVariant line(lines.getValue(1));
+   ASSERT_EQ(StringVariant(line.getValue("sku")).toString(), "b-2");
+   ASSERT_EQ(NumericVariant(line.getValue("qty")).toLong(), 1);
+}
+
+TEST(ReflectionTest, testFromArray)
+{
+   Order source{7, 1.25, false, {"x"}, {{"c-3", 4}}};
+   Order order = StructInfo<Order>::fromArray(StructInfo<Order>::toArray(source));
+   ASSERT_EQ(order.id, 7);
+   ASSERT_EQ(order.price, 1.25);
+   ASSERT_FALSE(order.paid);
+   ASSERT_EQ(order.tags.size(), 1);
+   ASSERT_EQ(order.lines.size(), 1);
+   ASSERT_EQ(order.lines[0].sku, "c-3");
+   ASSERT_EQ(order.lines[0].qty, 4);
+   // missing keys keep the fields, wrong types are reported
+   ArrayVariant partial;
+   partial.insert("id", "15");
+   OrderLine line{"keep", 3};
+   ASSERT_TRUE(StructInfo<OrderLine>::fromArray(partial, line));
+   ASSERT_EQ(line.sku, "keep");
+   partial.insert("sku", ArrayVariant{1});
+   ASSERT_FALSE(StructInfo<OrderLine>::fromArray(partial, line));
+   ASSERT_TRUE(StructInfo<Order>::fromArray(partial, order));
+   ASSERT_EQ(order.id, 15);
+}
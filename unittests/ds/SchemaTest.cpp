@@ -0,0 +1,102 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/ds/Schema.h"
+#include "zapi/ds/ArrayVariant.h"
+#include <vector>
+
+using zapi::ds::Schema;
+using zapi::ds::ArrayVariant;
+using zapi::ds::Variant;
+using ValueType = Schema::ValueType;
+using ViolationType = Schema::ViolationType;
+
+namespace
+{
+
+ArrayVariant make_order(zapi_long id, const char *name)
+{
+   ArrayVariant order;
+   order.insert("id", id);
+   order.insert("name", name);
+   order.insert("tags", ArrayVariant{"new", "paid"});
+   return order;
+}
+
+} // anonymous namespace
+
+TEST(SchemaTest, testNodeBuilder)
+{
+   Schema schema(Schema::Node(ValueType::Array)
+                 .setStrict()
+                 .addField("id", Schema::Node(ValueType::Long).setMin(1), true)
+                 .addField("name", Schema::Node(ValueType::String).setMaxLength(8).setNullable(), true)
+                 .addField("tags", Schema::Node(ValueType::List).setItems(Schema::Node(ValueType::String))));
+   ASSERT_TRUE(schema.isValid(make_order(12, "zapi")));
+   std::vector<Schema::Violation> violations;
+   ASSERT_TRUE(schema.validate(make_order(12, "zapi"), violations));
+   ASSERT_TRUE(violations.empty());
+   ArrayVariant order = make_order(0, "zapi");
+   order.insert("name", nullptr);
+   ASSERT_FALSE(schema.isValid(order));
+
+   ArrayVariant invalid;
+   invalid.insert("name", "very long name");
+   invalid.insert("tags", ArrayVariant{"new", 1});
+   invalid.insert("extra", true);
+   ASSERT_FALSE(schema.validate(invalid, violations));
+   ASSERT_EQ(violations.size(), 4);
+   ASSERT_EQ(violations[0].type, ViolationType::MissingField);
+   ASSERT_EQ(violations[0].path, "id");
+   ASSERT_EQ(violations[1].type, ViolationType::LengthOutOfRange);
+   ASSERT_EQ(violations[1].path, "name");
+   ASSERT_EQ(violations[2].type, ViolationType::TypeMismatch);
+   ASSERT_EQ(violations[2].path, "tags.1");
+   ASSERT_EQ(violations[3].type, ViolationType::UnknownField);
+   ASSERT_EQ(violations[3].path, "extra");
+}
+
+TEST(SchemaTest, testArrayDescription)
+{
+   ArrayVariant idField;
+   idField.insert("type", "int");
+   idField.insert("required", true);
+   idField.insert("min", 1);
+   ArrayVariant tagsField;
+   tagsField.insert("type", "list");
+   tagsField.insert("maxLength", 1);
+   ArrayVariant fields;
+   fields.insert("id", idField);
+   fields.insert("tags", tagsField);
+   ArrayVariant description;
+   description.insert("type", "array");
+   description.insert("fields", fields);
+   Schema schema(description);
+   std::vector<Schema::Violation> violations;
+   ASSERT_FALSE(schema.validate(make_order(-1, "zapi"), violations));
+   ASSERT_EQ(violations.size(), 2);
+   ASSERT_EQ(violations[0].type, ViolationType::OutOfRange);
+   ASSERT_EQ(violations[0].path, "id");
+   ASSERT_EQ(violations[1].type, ViolationType::LengthOutOfRange);
+   ASSERT_EQ(violations[1].path, "tags");
+   ArrayVariant notList;
+   notList.insert("id", 3);
+   ArrayVariant tags;
+   tags.insert("a", 1);
+   notList.insert("tags", tags);
+   ASSERT_FALSE(schema.isValid(notList));
+}
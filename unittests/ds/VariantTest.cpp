@@ -16,6 +16,8 @@
 #include "php/sapi/embed/php_embed.h"
 #include "gtest/gtest.h"
 #include "zapi/ds/Variant.h"
+#include <unordered_map>
+#include <map>
 
 using zapi::ds::Variant;
 using zapi::lang::Type;
@@ -327,3 +329,52 @@ TEST(VariantTest, testGetType)
    ASSERT_TRUE(var.isScalar());
    ASSERT_TRUE(var.isBool());
 }
+
+TEST(VariantTest, testKeyHash)
+{
+   std::unordered_map<Variant, int, zapi::utils::VariantKeyHash, zapi::utils::VariantKeyEqual> map;
+   map[Variant(1)] = 1;
+   map[Variant("1")] = 2;
+   map[Variant(true)] = 3;
+   map[Variant(1.7)] = 4;
+   ASSERT_EQ(map.size(), 1);
+   ASSERT_EQ(map[Variant(1)], 4);
+   map[Variant("01")] = 5;
+   map[Variant(nullptr)] = 6;
+   map[Variant("")] = 7;
+   ASSERT_EQ(map.size(), 3);
+   ASSERT_EQ(map[Variant("01")], 5);
+   ASSERT_EQ(map[Variant(nullptr)], 7);
+   // binary safe
+   map[Variant("a\0b", 3)] = 8;
+   map[Variant("a\0c", 3)] = 9;
+   map[Variant("a")] = 10;
+   ASSERT_EQ(map.size(), 6);
+   ASSERT_EQ(map[Variant("a\0b", 3)], 8);
+   ASSERT_EQ(zapi::utils::VariantKeyHash()(Variant("zapi")), zend_inline_hash_func("zapi", 4));
+   ASSERT_EQ(zapi::utils::VariantKeyHash()(Variant(2017)), 2017);
+   ASSERT_TRUE(zapi::utils::VariantKeyEqual()(Variant(-12), Variant("-12")));
+   ASSERT_FALSE(zapi::utils::VariantKeyEqual()(Variant(12), Variant("12.0")));
+}
+
+TEST(VariantTest, testKeyLess)
+{
+   std::map<Variant, int, zapi::utils::VariantKeyLess> map;
+   map[Variant("b")] = 1;
+   map[Variant("a\0b", 3)] = 2;
+   map[Variant("a\0a", 3)] = 3;
+   map[Variant(10)] = 4;
+   map[Variant(9)] = 5;
+   map[Variant("9")] = 6;
+   ASSERT_EQ(map.size(), 5);
+   auto iter = map.begin();
+   ASSERT_EQ(iter->second, 6);
+   ++iter;
+   ASSERT_EQ(iter->second, 4);
+   ++iter;
+   ASSERT_EQ(iter->second, 3);
+   ++iter;
+   ASSERT_EQ(iter->second, 2);
+   ++iter;
+   ASSERT_EQ(iter->second, 1);
+}
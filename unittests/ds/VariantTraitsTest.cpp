@@ -0,0 +1,88 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/ds/VariantTraits.h"
+#include "zapi/ds/ArrayVariant.h"
+#include "zapi/ds/StringVariant.h"
+#include "zapi/ds/NumericVariant.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <tuple>
+
+using zapi::ds::ArrayVariant;
+using zapi::ds::ArrayKey;
+using zapi::ds::Variant;
+using zapi::ds::StringVariant;
+using zapi::ds::NumericVariant;
+using zapi::ds::to_variant;
+using zapi::ds::variant_cast;
+
+TEST(VariantTraitsTest, testMap)
+{
+   std::map<std::string, int> source{{"a", 1}, {"12", 2}};
+   ArrayVariant array(to_variant(source));
+   ASSERT_EQ(array.getSize(), 2);
+   // numeric string keys follow the array offset rules
+   ASSERT_TRUE(array.contains(12));
+   ASSERT_EQ(NumericVariant(array.getValue("a")).toLong(), 1);
+   ASSERT_EQ((variant_cast<std::map<std::string, int>>(array)), source);
+   std::unordered_map<int, std::string> names{{1, "one"}, {3, "three"}};
+   ArrayVariant named(to_variant(names));
+   ASSERT_EQ(StringVariant(named.getValue(3)).toString(), "three");
+   ASSERT_EQ((variant_cast<std::unordered_map<int, std::string>>(named)), names);
+   ASSERT_TRUE((variant_cast<std::map<std::string, int>>(Variant(1))).empty());
+   // string keys don't become integer keys
+   ArrayVariant mixed;
+   mixed.insert(3, 1);
+   mixed.insert("abc", 2);
+   std::map<int, int> numbers{{9, 9}};
+   ASSERT_FALSE((zapi::ds::VariantTraits<std::map<int, int>>::fromZval(mixed.getZvalPtr(), numbers)));
+   ASSERT_EQ(numbers.count(0), 0);
+}
+
+TEST(VariantTraitsTest, testSequence)
+{
+   std::vector<std::pair<std::string, double>> pairs{{"x", 1.5}, {"y", 2.5}};
+   ArrayVariant array(to_variant(pairs));
+   ASSERT_EQ(array.getValueAs<double>(ArrayKey("y")), 2.5);
+   ASSERT_EQ((variant_cast<std::vector<std::pair<std::string, double>>>(array)), pairs);
+   std::tuple<int, std::string, bool> tuple(7, "zapi", true);
+   ArrayVariant packed(to_variant(tuple));
+   ASSERT_TRUE(packed.strictEqual(ArrayVariant{7, "zapi", true}));
+   ASSERT_EQ((variant_cast<std::tuple<int, std::string, bool>>(packed)), tuple);
+   std::vector<std::vector<int>> nested{{1, 2}, {}, {3}};
+   ASSERT_EQ(variant_cast<std::vector<std::vector<int>>>(to_variant(nested)), nested);
+}
+
+TEST(VariantTraitsTest, testArrayEmplace)
+{
+   ArrayVariant array;
+   array.emplace(ArrayKey("tags"), std::vector<std::string>{"a", "b"});
+   array.emplace(ArrayKey(1), 3.5);
+   array.emplaceBack(std::string("tail"));
+   ASSERT_EQ(array.getSize(), 3);
+   ASSERT_EQ(array.getValueAs<std::vector<std::string>>(ArrayKey("tags")).size(), 2);
+   ASSERT_EQ(array.getValueAs<double>(ArrayKey(1)), 3.5);
+   ASSERT_EQ(array.getValueAs<std::string>(ArrayKey(2)), "tail");
+   ASSERT_EQ(array.getValueAs<int>(ArrayKey("missing")), 0);
+   ArrayVariant copy(array);
+   copy.emplaceBack(1);
+   ASSERT_EQ(array.getSize(), 3);
+   ASSERT_EQ(copy.getSize(), 4);
+}
@@ -0,0 +1,130 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/18.
+
+#include "php/sapi/embed/php_embed.h"
+#include "gtest/gtest.h"
+#include "zapi/vm/ObjectPool.h"
+#include "zapi/lang/StdClass.h"
+#include <new>
+
+using zapi::vm::ObjectPool;
+using zapi::lang::StdClass;
+
+namespace
+{
+class ChurnObject : public StdClass
+{
+public:
+   int64_t x = 0;
+   int64_t y = 0;
+};
+} // anonymous namespace
+
+#ifdef ZTS
+
+TEST(ObjectPoolTest, testDisabledUnderZts)
+{
+   ObjectPool pool(sizeof(ChurnObject));
+   pool.setCapacity(8);
+   ASSERT_FALSE(pool.isEnabled());
+   ASSERT_FALSE(pool.routesObjects());
+}
+
+#else
+
+TEST(ObjectPoolTest, testRecycle)
+{
+   ObjectPool pool(sizeof(ChurnObject));
+   ASSERT_FALSE(pool.isEnabled());
+   pool.setCapacity(2);
+   void *first = pool.allocate();
+   void *second = pool.allocate();
+   void *third = pool.allocate();
+   ASSERT_EQ(pool.getStats().misses, 3);
+   ASSERT_EQ(pool.getStats().highWater, 3);
+   pool.release(first);
+   pool.release(second);
+   // over the capacity, goes back to the engine
+   pool.release(third);
+   ASSERT_EQ(pool.getStats().pooled, 2);
+   ASSERT_EQ(pool.getStats().live, 0);
+   ASSERT_EQ(pool.allocate(), second);
+   ASSERT_EQ(pool.getStats().hits, 1);
+   pool.release(second);
+   // nothing is kept between the requests
+   ObjectPool::drainAll();
+   ASSERT_EQ(pool.getStats().pooled, 0);
+   void *late = pool.allocate();
+   pool.release(late);
+   ASSERT_EQ(pool.getStats().pooled, 0);
+   ObjectPool::activateAll();
+   pool.resetStats();
+   ASSERT_EQ(pool.getStats().hits, 0);
+   ASSERT_EQ(pool.getStats().misses, 0);
+   ASSERT_EQ(pool.getStats().highWater, 0);
+   pool.drain();
+}
+
+TEST(ObjectPoolTest, testChurn)
+{
+   // a window of live objects churned the way short lived iterators and
+   // closures are, every round frees the oldest and creates a new one
+   const int rounds = 1000;
+   const int window = 16;
+   ChurnObject *live[window] = {};
+   ObjectPool pool(sizeof(ChurnObject));
+   pool.setCapacity(window);
+   for (int i = 0; i < rounds; ++i) {
+      ChurnObject *&slot = live[i % window];
+      if (slot) {
+         ASSERT_EQ(slot->x, i - window);
+         slot->~ChurnObject();
+         pool.release(slot);
+      }
+      slot = new (pool.allocate()) ChurnObject();
+      slot->x = i;
+   }
+   for (ChurnObject *&object : live) {
+      object->~ChurnObject();
+      pool.release(object);
+   }
+   const ObjectPool::Stats &stats = pool.getStats();
+   ASSERT_EQ(stats.misses, window);
+   ASSERT_EQ(stats.hits, rounds - window);
+   ASSERT_EQ(stats.highWater, window);
+   ASSERT_EQ(stats.live, 0);
+   pool.drain();
+}
+
+TEST(ObjectPoolTest, testRouting)
+{
+   ObjectPool heap(sizeof(ChurnObject));
+   ASSERT_FALSE(heap.routesObjects());
+   // the objects already allocated with new must keep being deleted
+   heap.setCapacity(4);
+   ASSERT_FALSE(heap.routesObjects());
+   ObjectPool pooled(sizeof(ChurnObject));
+   pooled.setCapacity(4);
+   ASSERT_TRUE(pooled.routesObjects());
+   void *storage = pooled.allocate();
+   // disabled with a live object, the block still goes back through the pool
+   pooled.setCapacity(0);
+   ASSERT_TRUE(pooled.routesObjects());
+   pooled.release(storage);
+   ASSERT_EQ(pooled.getStats().live, 0);
+   ASSERT_EQ(pooled.getStats().pooled, 0);
+}
+
+#endif // ZTS